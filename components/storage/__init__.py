@@ -9,12 +9,18 @@ import esphome.codegen as cg
 import esphome.config_validation as cv
 from esphome.components import display, image
 from esphome import automation
+import esphome.final_validate as fv
 from esphome.const import (
     CONF_FILE,
+    CONF_HEIGHT,
     CONF_ID,
     CONF_PLATFORM,
     CONF_RESIZE,
+    CONF_TRIGGER_ID,
     CONF_TYPE,
+    CONF_WIDTH,
+    CONF_X,
+    CONF_Y,
 )
 from esphome.core import CORE
 
@@ -41,34 +47,260 @@ CONF_SD_COMPONENT = "sd_component"
 CONF_SD_IMAGES = "sd_images"
 CONF_FILE_PATH = "file_path"
 CONF_AUTO_LOAD = "auto_load"  # Maintenant au niveau global
+CONF_ASSET_PACK = "asset_pack"
+CONF_MEMORY_BUDGET = "memory_budget"
+CONF_STORAGE_ID = "storage_id"
+CONF_PLACEMENT = "placement"
+CONF_PSRAM_ARENA_SIZE = "psram_arena_size"
+CONF_INTERNAL_ARENA_SIZE = "internal_arena_size"
+CONF_ARENA_COMPACT_THRESHOLD = "arena_compact_threshold"
+CONF_BACKGROUND_LOADING = "background_loading"
+CONF_LOADER_CORE = "loader_core"
+CONF_LOADER_WORKERS = "loader_workers"
+CONF_ANIMATED = "animated"
+CONF_LOOP = "loop"
+CONF_FRAME = "frame"
+CONF_VIEWPORT = "viewport"
+CONF_DX = "dx"
+CONF_DY = "dy"
+CONF_ON_LOADED = "on_loaded"
+CONF_ON_LOAD_FAILED = "on_load_failed"
+CONF_ON_PREVIEW = "on_preview"
+CONF_THUMBNAILS = "thumbnails"
+CONF_PROGRESSIVE_PREVIEW = "progressive_preview"
+CONF_FOLDER = "folder"
+CONF_SIZE = "size"
+CONF_SLIDESHOW = "slideshow"
+CONF_FILES = "files"
+CONF_INTERVAL = "interval"
+CONF_SHUFFLE = "shuffle"
+CONF_LVGL_FS = "lvgl_fs"
+CONF_LETTER = "letter"
+CONF_CACHE_SIZE = "cache_size"
+CONF_DITHER = "dither"
+CONF_PALETTE = "palette"
+CONF_RAM_COMPRESSION = "ram_compression"
+CONF_PNG_DECODER = "png_decoder"
+CONF_DECODE_BUDGET = "decode_budget"
 
 # Image format mappings
 CONF_OUTPUT_IMAGE_FORMATS = {
     "RGB565": "RGB565",
     "RGB888": "RGB888",
     "RGBA": "RGBA",
+    # Formats compacts, quantifiés pendant le décodage
+    "GRAYSCALE": "GRAYSCALE",
+    "BINARY": "BINARY",
+    "INDEXED8": "INDEXED8",
 }
+COMPACT_FORMATS = ("GRAYSCALE", "BINARY", "INDEXED8")
 
 CONF_BYTE_ORDERS = {
     "LITTLE_ENDIAN": "LITTLE_ENDIAN",
     "BIG_ENDIAN": "BIG_ENDIAN",
+    "AUTO": "AUTO",
 }
 
+# Écrans RGB parallèles: framebuffer en mémoire, uint16 little endian du CPU.
+# Les autres (SPI/QSPI/i80) reçoivent l'octet de poids fort en premier.
+LITTLE_ENDIAN_DISPLAYS = {"rpi_dpi_rgb", "st7701s", "mipi_rgb"}
+
+
+def resolve_byte_order(byte_order):
+    """AUTO: ordre natif de la cible, négocié une fois à la génération du code."""
+    if byte_order != "AUTO":
+        return byte_order
+    # LVGL lit les images dans son propre ordre (LV_COLOR_16_SWAP)
+    lvgl_config = CORE.config.get("lvgl")
+    if lvgl_config:
+        if isinstance(lvgl_config, list):
+            lvgl_config = lvgl_config[0]
+        return str(lvgl_config.get(CONF_BYTE_ORDER, "big_endian")).upper()
+    displays = CORE.config.get("display", [])
+    if displays and all(conf.get(CONF_PLATFORM) in LITTLE_ENDIAN_DISPLAYS for conf in displays):
+        return "LITTLE_ENDIAN"
+    return "BIG_ENDIAN"
+
+MemoryPlacement = storage_ns.enum("MemoryPlacement", is_class=True)
+MEMORY_PLACEMENTS = {
+    "AUTO": MemoryPlacement.AUTO,
+    "PSRAM": MemoryPlacement.PSRAM,
+    "INTERNAL": MemoryPlacement.INTERNAL,
+}
+
+RamCompression = storage_ns.enum("RamCompression", is_class=True)
+RAM_COMPRESSIONS = {
+    "NONE": RamCompression.NONE,
+    "RLE": RamCompression.RLE,
+    "QOI": RamCompression.QOI,
+}
+
+# pngle: un callback par pixel; pngdec: une ligne par callback (Adam7 laissé à pngle)
+PNG_DECODERS = ["PNGLE", "PNGDEC"]
+
+_BYTE_SUFFIXES = {"B": 1, "KB": 1024, "MB": 1024 * 1024}
+
+
+def validate_bytes(value):
+    """Accepte 524288, "512KB" ou "2MB"."""
+    if isinstance(value, int):
+        return cv.positive_int(value)
+    value = cv.string(value).strip().upper().replace(" ", "")
+    for suffix in ("KB", "MB", "B"):
+        if value.endswith(suffix):
+            number = value[: -len(suffix)]
+            try:
+                return int(float(number) * _BYTE_SUFFIXES[suffix])
+            except ValueError as err:
+                raise cv.Invalid(f"Invalid size: {value}") from err
+    return cv.positive_int(value)
+
+
 # Actions
 SdImageLoadAction = storage_ns.class_("SdImageLoadAction", automation.Action)
 SdImageUnloadAction = storage_ns.class_("SdImageUnloadAction", automation.Action)
+SdImagePlayAction = storage_ns.class_("SdImagePlayAction", automation.Action)
+SdImagePauseAction = storage_ns.class_("SdImagePauseAction", automation.Action)
+SdImageSeekAction = storage_ns.class_("SdImageSeekAction", automation.Action)
+SdImageSetViewportAction = storage_ns.class_("SdImageSetViewportAction", automation.Action)
+SdImagePanAction = storage_ns.class_("SdImagePanAction", automation.Action)
+SdImageNextAction = storage_ns.class_("SdImageNextAction", automation.Action)
+SdImagePreviousAction = storage_ns.class_("SdImagePreviousAction", automation.Action)
+StorageOpenThumbnailsAction = storage_ns.class_("StorageOpenThumbnailsAction", automation.Action)
+StorageStatsAction = storage_ns.class_("StorageStatsAction", automation.Action)
+
+# Triggers
+SdImageLoadedTrigger = storage_ns.class_("SdImageLoadedTrigger", automation.Trigger.template())
+SdImageLoadFailedTrigger = storage_ns.class_("SdImageLoadFailedTrigger", automation.Trigger.template())
+SdImagePreviewTrigger = storage_ns.class_("SdImagePreviewTrigger", automation.Trigger.template())
 
 # Schema pour SdImageComponent - SUPPRESSION de auto_load individuel
-SD_IMAGE_SCHEMA = cv.Schema(
+VIEWPORT_SCHEMA = cv.Schema(
+    {
+        cv.Optional(CONF_X, default=0): cv.positive_int,
+        cv.Optional(CONF_Y, default=0): cv.positive_int,
+        cv.Required(CONF_WIDTH): cv.positive_not_null_int,
+        cv.Required(CONF_HEIGHT): cv.positive_not_null_int,
+    }
+)
+
+# Diaporama: l'image suivante est décodée pendant que la courante est affichée
+SLIDESHOW_SCHEMA = cv.All(
+    cv.Schema(
+        {
+            cv.Optional(CONF_FOLDER): cv.string,
+            cv.Optional(CONF_FILES): cv.ensure_list(cv.string),
+            cv.Optional(CONF_INTERVAL, default="10s"): cv.positive_time_period_milliseconds,
+            cv.Optional(CONF_SHUFFLE, default=False): cv.boolean,
+        }
+    ),
+    cv.has_at_least_one_key(CONF_FOLDER, CONF_FILES),
+)
+
+
+def validate_image_source(config):
+    if CONF_FILE_PATH not in config and CONF_SLIDESHOW not in config:
+        raise cv.Invalid(f"'{CONF_FILE_PATH}' is required unless '{CONF_SLIDESHOW}' is set")
+    return config
+
+
+def validate_palette_color(value):
+    if isinstance(value, str):
+        text = value.strip().lstrip("#")
+        if text.lower().startswith("0x"):
+            text = text[2:]
+        try:
+            value = int(text, 16)
+        except ValueError as err:
+            raise cv.Invalid(f"Invalid palette color '{value}', expected #RRGGBB") from err
+    return cv.int_range(min=0, max=0xFFFFFF)(value)
+
+
+def validate_output_format(config):
+    fmt = config[CONF_OUTPUT_FORMAT]
+    if fmt in COMPACT_FORMATS:
+        # Viewport, canvas GIF et aperçu écrivent du RGB565 ligne par ligne
+        for key in (CONF_VIEWPORT, CONF_ANIMATED, CONF_PROGRESSIVE_PREVIEW):
+            if config.get(key):
+                raise cv.Invalid(f"'{key}' is not supported with format {fmt}, use RGB565")
+    if config.get(CONF_DITHER) and fmt != "BINARY":
+        raise cv.Invalid(f"'{CONF_DITHER}' only applies to format BINARY")
+    if CONF_PALETTE in config and fmt != "INDEXED8":
+        raise cv.Invalid(f"'{CONF_PALETTE}' only applies to format INDEXED8")
+    if config[CONF_RAM_COMPRESSION] != "NONE":
+        if fmt != "RGB565":
+            raise cv.Invalid(f"'{CONF_RAM_COMPRESSION}' only applies to format RGB565")
+        # Ces modes écrivent directement dans le buffer publié
+        for key in (CONF_VIEWPORT, CONF_ANIMATED):
+            if config.get(key):
+                raise cv.Invalid(f"'{CONF_RAM_COMPRESSION}' is not supported with '{key}'")
+    return config
+
+
+SD_IMAGE_SCHEMA = cv.All(cv.Schema(
     {
         cv.GenerateID(): cv.declare_id(SdImageComponent),
-        cv.Required(CONF_FILE_PATH): cv.string,
+        cv.Optional(CONF_FILE_PATH): cv.string,
         cv.Optional(CONF_OUTPUT_FORMAT, default="RGB565"): cv.enum(CONF_OUTPUT_IMAGE_FORMATS, upper=True),
         cv.Optional(CONF_BYTE_ORDER, default="LITTLE_ENDIAN"): cv.enum(CONF_BYTE_ORDERS, upper=True),
+        # BINARY: tramage ordonné au lieu d'un seuil à 50 %
+        cv.Optional(CONF_DITHER, default=False): cv.boolean,
+        # INDEXED8: couleurs #RRGGBB (RGB332 fixe si absente)
+        cv.Optional(CONF_PALETTE): cv.All(cv.ensure_list(validate_palette_color), cv.Length(min=2, max=256)),
         cv.Optional(CONF_RESIZE): cv.dimensions,
+        # Fichiers raw sans en-tête: taille des pixels stockés (RGB565 LE, RGB888 ou RGBA selon la taille)
+        cv.Optional(CONF_WIDTH): cv.int_range(min=1, max=8192),
+        cv.Optional(CONF_HEIGHT): cv.int_range(min=1, max=8192),
         cv.Optional(CONF_TYPE, default="SD_IMAGE"): cv.string,
+        cv.Optional(CONF_PLACEMENT, default="AUTO"): cv.enum(MEMORY_PLACEMENTS, upper=True),
+        # Image décodée gardée compressée (aplats des UI), développée ligne à ligne au draw
+        cv.Optional(CONF_RAM_COMPRESSION, default="NONE"): cv.enum(RAM_COMPRESSIONS, upper=True),
+        # GIF animé lu en streaming depuis la SD (canvas unique en RAM)
+        cv.Optional(CONF_ANIMATED, default=False): cv.boolean,
+        cv.Optional(CONF_LOOP, default=True): cv.boolean,
+        # Fenêtre sur une image plus grande que la RAM (seule la fenêtre est décodée)
+        cv.Optional(CONF_VIEWPORT): VIEWPORT_SCHEMA,
+        # JPEG: aperçu 1/8 (ou vignette EXIF) affiché pendant le décodage complet
+        cv.Optional(CONF_PROGRESSIVE_PREVIEW, default=False): cv.boolean,
+        cv.Optional(CONF_SLIDESHOW): SLIDESHOW_SCHEMA,
+        cv.Optional(CONF_ON_LOADED): automation.validate_automation(
+            {cv.GenerateID(CONF_TRIGGER_ID): cv.declare_id(SdImageLoadedTrigger)}
+        ),
+        cv.Optional(CONF_ON_LOAD_FAILED): automation.validate_automation(
+            {cv.GenerateID(CONF_TRIGGER_ID): cv.declare_id(SdImageLoadFailedTrigger)}
+        ),
+        # Aperçu affiché (progressive_preview); on_loaded suit avec l'image complète
+        cv.Optional(CONF_ON_PREVIEW): automation.validate_automation(
+            {cv.GenerateID(CONF_TRIGGER_ID): cv.declare_id(SdImagePreviewTrigger)}
+        ),
         # SUPPRIMÉ: auto_load individuel - maintenant géré au niveau global
     }
+), cv.has_at_most_one_key(CONF_RESIZE, CONF_VIEWPORT), cv.has_at_most_one_key(CONF_VIEWPORT, CONF_SLIDESHOW),
+   cv.has_none_or_all_keys(CONF_WIDTH, CONF_HEIGHT), validate_image_source, validate_output_format)
+
+# Vignettes d'un dossier, cache <dossier>/.thumbs_<W>x<H>.bin
+THUMBNAILS_SCHEMA = cv.Schema(
+    {
+        cv.Optional(CONF_SIZE, default="64x64"): cv.dimensions,
+        cv.Optional(CONF_BYTE_ORDER, default="AUTO"): cv.enum(CONF_BYTE_ORDERS, upper=True),
+        cv.Optional(CONF_FOLDER): cv.string,
+    }
+)
+
+def validate_drive_letter(value):
+    value = cv.string_strict(value).upper()
+    if len(value) != 1 or not "A" <= value <= "Z":
+        raise cv.Invalid("LVGL drive letter must be a single letter A-Z")
+    return value
+
+
+# Lecteur LVGL sur la SD: lv_img_set_src(img, "S:/images/logo.png")
+LVGL_FS_SCHEMA = cv.Schema(
+    {
+        cv.Optional(CONF_LETTER, default="S"): validate_drive_letter,
+        # Cache de lecture LVGL par fichier ouvert (0 = lectures directes)
+        cv.Optional(CONF_CACHE_SIZE, default="4KB"): cv.All(validate_bytes, cv.int_range(max=65535)),
+    }
 )
 
 # Schema principal pour StorageComponent AVEC auto_load global
@@ -79,10 +311,39 @@ CONFIG_SCHEMA = cv.Schema(
         cv.Optional(CONF_SD_COMPONENT): cv.use_id(SdMmc),
         cv.Optional(CONF_ROOT_PATH, default="/"): cv.string,
         cv.Optional(CONF_AUTO_LOAD, default=True): cv.boolean,  # AUTO_LOAD GLOBAL
+        # Pack construit par tools/asset_packer.py, images référencées par "pack:<nom>"
+        cv.Optional(CONF_ASSET_PACK): cv.string,
+        # Budget RAM/PSRAM partagé par toutes les images (éviction LRU)
+        cv.Optional(CONF_MEMORY_BUDGET): validate_bytes,
+        # Arènes réservées au boot pour les buffers d'images
+        cv.Optional(CONF_PSRAM_ARENA_SIZE, default=0): validate_bytes,
+        cv.Optional(CONF_INTERNAL_ARENA_SIZE, default=0): validate_bytes,
+        cv.Optional(CONF_ARENA_COMPACT_THRESHOLD, default="50%"): cv.percentage,
+        # Lecture + décodage sur une tâche FreeRTOS dédiée, publication dans la loop
+        cv.Optional(CONF_BACKGROUND_LOADING, default=True): cv.boolean,
+        cv.Optional(CONF_LOADER_CORE): cv.int_range(min=0, max=1),
+        # Deux workers = décodage d'images indépendantes sur les deux cœurs
+        cv.Optional(CONF_LOADER_WORKERS, default=2): cv.int_range(min=1, max=2),
+        # Sans worker: décodage découpé en tranches de cette durée par passage de loop()
+        cv.Optional(CONF_DECODE_BUDGET): cv.All(
+            cv.positive_time_period_microseconds,
+            cv.Range(min=cv.TimePeriod(milliseconds=1), max=cv.TimePeriod(milliseconds=100)),
+        ),
+        cv.Optional(CONF_PNG_DECODER, default="PNGLE"): cv.one_of(*PNG_DECODERS, upper=True),
         cv.Optional(CONF_SD_IMAGES, default=[]): cv.ensure_list(SD_IMAGE_SCHEMA),
+        cv.Optional(CONF_THUMBNAILS): THUMBNAILS_SCHEMA,
+        cv.Optional(CONF_LVGL_FS): LVGL_FS_SCHEMA,
     }
 ).extend(cv.COMPONENT_SCHEMA)
 
+def _final_validate(config):
+    if CONF_LVGL_FS in config and "lvgl" not in fv.full_config.get():
+        raise cv.Invalid(f"'{CONF_LVGL_FS}' requires the lvgl component")
+    return config
+
+
+FINAL_VALIDATE_SCHEMA = _final_validate
+
 # Action schemas (inchangés)
 LOAD_ACTION_SCHEMA = cv.Schema({
     cv.GenerateID(): cv.use_id(SdImageComponent),
@@ -93,6 +354,34 @@ UNLOAD_ACTION_SCHEMA = cv.Schema({
     cv.GenerateID(): cv.use_id(SdImageComponent),
 })
 
+SEEK_ACTION_SCHEMA = cv.Schema({
+    cv.GenerateID(): cv.use_id(SdImageComponent),
+    cv.Required(CONF_FRAME): cv.templatable(cv.positive_int),
+})
+
+SET_VIEWPORT_ACTION_SCHEMA = cv.Schema({
+    cv.GenerateID(): cv.use_id(SdImageComponent),
+    cv.Optional(CONF_X, default=0): cv.templatable(cv.positive_int),
+    cv.Optional(CONF_Y, default=0): cv.templatable(cv.positive_int),
+    cv.Required(CONF_WIDTH): cv.templatable(cv.positive_not_null_int),
+    cv.Required(CONF_HEIGHT): cv.templatable(cv.positive_not_null_int),
+})
+
+PAN_ACTION_SCHEMA = cv.Schema({
+    cv.GenerateID(): cv.use_id(SdImageComponent),
+    cv.Optional(CONF_DX): cv.templatable(cv.int_),
+    cv.Optional(CONF_DY): cv.templatable(cv.int_),
+})
+
+OPEN_THUMBNAILS_ACTION_SCHEMA = cv.Schema({
+    cv.GenerateID(): cv.use_id(StorageComponent),
+    cv.Required(CONF_FOLDER): cv.templatable(cv.string),
+})
+
+STATS_ACTION_SCHEMA = cv.Schema({
+    cv.GenerateID(): cv.use_id(StorageComponent),
+})
+
 async def sd_image_load_action_to_code(config, action_id, template_arg, args):
     """Action to load an image from SD"""
     parent = await cg.get_variable(config[CONF_ID])
@@ -108,6 +397,50 @@ async def sd_image_unload_action_to_code(config, action_id, template_arg, args):
     var = cg.new_Pvariable(action_id, template_arg, parent)
     return var
 
+async def sd_image_seek_action_to_code(config, action_id, template_arg, args):
+    """Action to jump to a frame of an animated GIF"""
+    parent = await cg.get_variable(config[CONF_ID])
+    var = cg.new_Pvariable(action_id, template_arg, parent)
+    template_ = await cg.templatable(config[CONF_FRAME], args, cg.int_)
+    cg.add(var.set_frame(template_))
+    return var
+
+async def sd_image_set_viewport_action_to_code(config, action_id, template_arg, args):
+    """Action to move/resize the decoded window of a large image"""
+    parent = await cg.get_variable(config[CONF_ID])
+    var = cg.new_Pvariable(action_id, template_arg, parent)
+    for key, setter in ((CONF_X, var.set_x), (CONF_Y, var.set_y),
+                        (CONF_WIDTH, var.set_width), (CONF_HEIGHT, var.set_height)):
+        template_ = await cg.templatable(config[key], args, cg.int_)
+        cg.add(setter(template_))
+    return var
+
+async def sd_image_pan_action_to_code(config, action_id, template_arg, args):
+    """Action to pan the viewport by (dx, dy) pixels"""
+    parent = await cg.get_variable(config[CONF_ID])
+    var = cg.new_Pvariable(action_id, template_arg, parent)
+    if CONF_DX in config:
+        template_ = await cg.templatable(config[CONF_DX], args, cg.int_)
+        cg.add(var.set_dx(template_))
+    if CONF_DY in config:
+        template_ = await cg.templatable(config[CONF_DY], args, cg.int_)
+        cg.add(var.set_dy(template_))
+    return var
+
+async def storage_open_thumbnails_action_to_code(config, action_id, template_arg, args):
+    """Action to switch the thumbnail cache to another folder"""
+    parent = await cg.get_variable(config[CONF_ID])
+    var = cg.new_Pvariable(action_id, template_arg, parent)
+    template_ = await cg.templatable(config[CONF_FOLDER], args, cg.std_string)
+    cg.add(var.set_folder(template_))
+    return var
+
+async def storage_stats_action_to_code(config, action_id, template_arg, args):
+    """Action to log the last load of every image"""
+    parent = await cg.get_variable(config[CONF_ID])
+    var = cg.new_Pvariable(action_id, template_arg, parent)
+    return var
+
 # Register actions
 automation.register_action(
     "sd_image.load",
@@ -121,6 +454,60 @@ automation.register_action(
     UNLOAD_ACTION_SCHEMA
 )(sd_image_unload_action_to_code)
 
+automation.register_action(
+    "sd_image.play",
+    SdImagePlayAction,
+    UNLOAD_ACTION_SCHEMA
+)(sd_image_unload_action_to_code)
+
+automation.register_action(
+    "sd_image.pause",
+    SdImagePauseAction,
+    UNLOAD_ACTION_SCHEMA
+)(sd_image_unload_action_to_code)
+
+automation.register_action(
+    "sd_image.seek",
+    SdImageSeekAction,
+    SEEK_ACTION_SCHEMA
+)(sd_image_seek_action_to_code)
+
+automation.register_action(
+    "sd_image.set_viewport",
+    SdImageSetViewportAction,
+    SET_VIEWPORT_ACTION_SCHEMA
+)(sd_image_set_viewport_action_to_code)
+
+automation.register_action(
+    "sd_image.pan",
+    SdImagePanAction,
+    PAN_ACTION_SCHEMA
+)(sd_image_pan_action_to_code)
+
+automation.register_action(
+    "sd_image.next",
+    SdImageNextAction,
+    UNLOAD_ACTION_SCHEMA
+)(sd_image_unload_action_to_code)
+
+automation.register_action(
+    "sd_image.previous",
+    SdImagePreviousAction,
+    UNLOAD_ACTION_SCHEMA
+)(sd_image_unload_action_to_code)
+
+automation.register_action(
+    "storage.open_thumbnails",
+    StorageOpenThumbnailsAction,
+    OPEN_THUMBNAILS_ACTION_SCHEMA
+)(storage_open_thumbnails_action_to_code)
+
+automation.register_action(
+    "storage.stats",
+    StorageStatsAction,
+    STATS_ACTION_SCHEMA
+)(storage_stats_action_to_code)
+
 async def to_code(config):
     """Generate C++ code for storage component avec auto_load global"""
 
@@ -135,6 +522,33 @@ async def to_code(config):
     # NOUVEAU: Configuration auto_load global
     cg.add(var.set_auto_load(config[CONF_AUTO_LOAD]))
 
+    if CONF_ASSET_PACK in config:
+        cg.add(var.set_asset_pack_path(config[CONF_ASSET_PACK]))
+
+    if CONF_MEMORY_BUDGET in config:
+        cg.add(var.set_memory_budget(config[CONF_MEMORY_BUDGET]))
+
+    cg.add(var.set_psram_arena_size(config[CONF_PSRAM_ARENA_SIZE]))
+    cg.add(var.set_internal_arena_size(config[CONF_INTERNAL_ARENA_SIZE]))
+    cg.add(var.set_arena_compact_threshold(config[CONF_ARENA_COMPACT_THRESHOLD]))
+    cg.add(var.set_background_loading(config[CONF_BACKGROUND_LOADING]))
+    if CONF_LOADER_CORE in config:
+        cg.add(var.set_loader_core(config[CONF_LOADER_CORE]))
+    cg.add(var.set_loader_workers(config[CONF_LOADER_WORKERS]))
+    if CONF_DECODE_BUDGET in config:
+        cg.add(var.set_decode_budget(config[CONF_DECODE_BUDGET]))
+
+    if CONF_THUMBNAILS in config:
+        thumbs = config[CONF_THUMBNAILS]
+        cg.add(var.set_thumbnail_size(thumbs[CONF_SIZE][0], thumbs[CONF_SIZE][1]))
+        cg.add(var.set_thumbnail_byte_order_string(resolve_byte_order(thumbs[CONF_BYTE_ORDER])))
+        if CONF_FOLDER in thumbs:
+            cg.add(var.set_thumbnail_folder(thumbs[CONF_FOLDER]))
+
+    if CONF_LVGL_FS in config:
+        lvgl_fs = config[CONF_LVGL_FS]
+        cg.add(var.set_lvgl_fs(cg.RawExpression(f"'{lvgl_fs[CONF_LETTER]}'"), lvgl_fs[CONF_CACHE_SIZE]))
+
     if CONF_SD_COMPONENT in config:
         sd_comp = await cg.get_variable(config[CONF_SD_COMPONENT])
         cg.add(var.set_sd_component(sd_comp))
@@ -143,6 +557,9 @@ async def to_code(config):
     cg.add_library("pngle", "1.1.0")
     cg.add_define("USE_PNGLE")
     cg.add_define("CONFIG_ESPHOME_ENABLE_PNGLE")
+    if config[CONF_PNG_DECODER] == "PNGDEC":
+        cg.add_library("bitbank2/PNGdec", None)
+        cg.add_define("USE_STORAGE_PNGDEC")
     
     # Defines pour le système hybride
     if config[CONF_AUTO_LOAD]:
@@ -167,17 +584,65 @@ async def setup_sd_image_component(config, parent_storage):
 
     # Link to parent storage component (s'enregistre automatiquement)
     cg.add(var.set_storage_component(parent_storage))
-    cg.add(var.set_file_path(config[CONF_FILE_PATH]))
+    if CONF_FILE_PATH in config:
+        cg.add(var.set_file_path(config[CONF_FILE_PATH]))
 
     # Set format and byte order
     output_format_str = config[CONF_OUTPUT_FORMAT]
-    byte_order_str = config[CONF_BYTE_ORDER]
+    byte_order_str = resolve_byte_order(config[CONF_BYTE_ORDER])
 
     cg.add(var.set_output_format_string(output_format_str))
     cg.add(var.set_byte_order_string(byte_order_str))
+    if config[CONF_DITHER]:
+        cg.add(var.set_dither(True))
+    if CONF_PALETTE in config:
+        cg.add(var.set_palette(config[CONF_PALETTE]))
 
     if CONF_RESIZE in config:
         cg.add(var.set_resize(config[CONF_RESIZE][0], config[CONF_RESIZE][1]))
 
+    if CONF_WIDTH in config:
+        cg.add(var.set_raw_size(config[CONF_WIDTH], config[CONF_HEIGHT]))
+
+    if CONF_VIEWPORT in config:
+        viewport = config[CONF_VIEWPORT]
+        cg.add(var.set_viewport(viewport[CONF_X], viewport[CONF_Y],
+                                viewport[CONF_WIDTH], viewport[CONF_HEIGHT]))
+
+    cg.add(var.set_placement(config[CONF_PLACEMENT]))
+    if config[CONF_RAM_COMPRESSION] != "NONE":
+        cg.add(var.set_ram_compression(config[CONF_RAM_COMPRESSION]))
+
+    if config[CONF_PROGRESSIVE_PREVIEW]:
+        cg.add(var.set_progressive_preview(True))
+
+    if CONF_SLIDESHOW in config:
+        slideshow = config[CONF_SLIDESHOW]
+        show = var.enable_slideshow()
+        if CONF_FOLDER in slideshow:
+            cg.add(show.set_folder(slideshow[CONF_FOLDER]))
+        for path in slideshow.get(CONF_FILES, []):
+            cg.add(show.add_file(path))
+        cg.add(show.set_interval(slideshow[CONF_INTERVAL]))
+        cg.add(show.set_shuffle(slideshow[CONF_SHUFFLE]))
+
+    if config[CONF_ANIMATED]:
+        cg.add(var.set_animated(True))
+        cg.add(var.set_animation_loop(config[CONF_LOOP]))
+        cg.add_library("bitbank2/AnimatedGIF", None)
+        cg.add_define("USE_STORAGE_GIF_SUPPORT")
+
+    for conf in config.get(CONF_ON_LOADED, []):
+        trigger = cg.new_Pvariable(conf[CONF_TRIGGER_ID], var)
+        await automation.build_automation(trigger, [], conf)
+
+    for conf in config.get(CONF_ON_LOAD_FAILED, []):
+        trigger = cg.new_Pvariable(conf[CONF_TRIGGER_ID], var)
+        await automation.build_automation(trigger, [], conf)
+
+    for conf in config.get(CONF_ON_PREVIEW, []):
+        trigger = cg.new_Pvariable(conf[CONF_TRIGGER_ID], var)
+        await automation.build_automation(trigger, [], conf)
+
     return var
 
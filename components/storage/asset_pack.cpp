@@ -0,0 +1,123 @@
+#include "asset_pack.h"
+#include "esphome/core/log.h"
+#include <algorithm>
+#include <errno.h>
+
+namespace esphome {
+namespace storage {
+
+static const char *const TAG = "storage.pack";
+
+uint32_t asset_name_hash(const std::string &name) {
+  uint32_t hash = 2166136261u;
+  for (char c : name) {
+    hash ^= static_cast<uint8_t>(c);
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+bool AssetPack::open(const std::string &full_path) {
+  this->close();
+
+  FILE *file = fopen(full_path.c_str(), "rb");
+  if (!file) {
+    ESP_LOGE(TAG, "Failed to open asset pack: %s (errno: %d)", full_path.c_str(), errno);
+    return false;
+  }
+
+  AssetPackHeader header;
+  if (fread(&header, 1, sizeof(header), file) != sizeof(header)) {
+    ESP_LOGE(TAG, "Asset pack too short: %s", full_path.c_str());
+    fclose(file);
+    return false;
+  }
+
+  if (header.magic != ASSET_PACK_MAGIC || header.version != ASSET_PACK_VERSION) {
+    ESP_LOGE(TAG, "Not a valid asset pack (magic 0x%08X, version %u): %s",
+             header.magic, header.version, full_path.c_str());
+    fclose(file);
+    return false;
+  }
+
+  if (fseek(file, header.index_offset, SEEK_SET) != 0) {
+    ESP_LOGE(TAG, "Failed to seek to asset pack index");
+    fclose(file);
+    return false;
+  }
+
+  this->entries_.resize(header.entry_count);
+  size_t index_bytes = header.entry_count * sizeof(AssetPackEntry);
+  if (fread(this->entries_.data(), 1, index_bytes, file) != index_bytes) {
+    ESP_LOGE(TAG, "Failed to read asset pack index (%u entries)", header.entry_count);
+    this->entries_.clear();
+    fclose(file);
+    return false;
+  }
+
+  // The packer writes the index sorted, but never trust the card
+  if (!std::is_sorted(this->entries_.begin(), this->entries_.end(),
+                      [](const AssetPackEntry &a, const AssetPackEntry &b) { return a.name_hash < b.name_hash; })) {
+    std::sort(this->entries_.begin(), this->entries_.end(),
+              [](const AssetPackEntry &a, const AssetPackEntry &b) { return a.name_hash < b.name_hash; });
+  }
+
+  this->file_ = file;
+  this->path_ = full_path;
+
+  ESP_LOGI(TAG, "Opened asset pack %s: %zu entries, %u byte alignment",
+           full_path.c_str(), this->entries_.size(), header.alignment);
+  return true;
+}
+
+void AssetPack::close() {
+  if (this->file_) {
+    fclose(this->file_);
+    this->file_ = nullptr;
+  }
+  this->entries_.clear();
+}
+
+const AssetPackEntry *AssetPack::find(uint32_t name_hash) const {
+  auto it = std::lower_bound(this->entries_.begin(), this->entries_.end(), name_hash,
+                             [](const AssetPackEntry &e, uint32_t h) { return e.name_hash < h; });
+  if (it == this->entries_.end() || it->name_hash != name_hash) {
+    return nullptr;
+  }
+  return &(*it);
+}
+
+bool AssetPack::read(const AssetPackEntry &entry, uint8_t *dst) {
+  if (!this->file_ || !dst) {
+    return false;
+  }
+
+  LockGuard guard(this->lock_);
+  if (fseek(this->file_, entry.offset, SEEK_SET) != 0) {
+    ESP_LOGE(TAG, "Failed to seek to entry 0x%08X at offset %u", entry.name_hash, entry.offset);
+    return false;
+  }
+
+  size_t read_size = fread(dst, 1, entry.size, this->file_);
+  if (read_size != entry.size) {
+    ESP_LOGE(TAG, "Short read for entry 0x%08X: expected %u, got %zu", entry.name_hash, entry.size, read_size);
+    return false;
+  }
+
+  return true;
+}
+
+size_t AssetPack::read_prefix(const AssetPackEntry &entry, uint8_t *dst, size_t len) {
+  if (!this->file_ || !dst) {
+    return 0;
+  }
+
+  LockGuard guard(this->lock_);
+  if (fseek(this->file_, entry.offset, SEEK_SET) != 0) {
+    return 0;
+  }
+  return fread(dst, 1, len < entry.size ? len : entry.size, this->file_);
+}
+
+}  // namespace storage
+}  // namespace esphome
@@ -0,0 +1,91 @@
+#pragma once
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "esphome/core/helpers.h"
+
+namespace esphome {
+namespace storage {
+
+// =====================================================
+// Asset pack - single file holding many images
+// =====================================================
+//
+// Layout (all integers little endian):
+//
+//   [AssetPackHeader]                      32 bytes
+//   [AssetPackEntry x entry_count]         sorted by name_hash
+//   [padding up to `alignment`]
+//   [blob 0][padding][blob 1][padding]...  every blob starts on `alignment`
+//
+// The index is read once when the pack is opened; loading an entry is then a
+// binary search in RAM followed by one fseek + one fread on the open FILE.
+// Packs are produced by tools/asset_packer.py.
+
+static const uint32_t ASSET_PACK_MAGIC = 0x4B504453;  // "SDPK"
+static const uint16_t ASSET_PACK_VERSION = 1;
+static const char *const ASSET_PACK_PREFIX = "pack:";
+
+enum class AssetEncoding : uint8_t {
+  ENCODED = 0,    // Original JPEG/PNG/GIF bytes, decoded on the device
+  RGB565_LE = 1,  // Pre-converted, ready to copy into the image buffer
+  RGB565_BE = 2,
+  RGB888 = 3,
+  RGBA8888 = 4,
+};
+
+struct __attribute__((packed)) AssetPackHeader {
+  uint32_t magic;
+  uint16_t version;
+  uint16_t entry_count;
+  uint32_t index_offset;
+  uint32_t alignment;
+  uint32_t reserved[4];
+};
+
+struct __attribute__((packed)) AssetPackEntry {
+  uint32_t name_hash;
+  uint32_t offset;
+  uint32_t size;
+  uint16_t width;   // 0 for ENCODED entries (taken from the decoder)
+  uint16_t height;
+  uint8_t encoding;
+  uint8_t flags;
+  uint16_t reserved;
+};
+
+static_assert(sizeof(AssetPackHeader) == 32, "AssetPackHeader layout must match tools/asset_packer.py");
+static_assert(sizeof(AssetPackEntry) == 20, "AssetPackEntry layout must match tools/asset_packer.py");
+
+// 32-bit FNV-1a, identical to asset_name_hash() in tools/asset_packer.py
+uint32_t asset_name_hash(const std::string &name);
+
+class AssetPack {
+ public:
+  ~AssetPack() { this->close(); }
+
+  bool open(const std::string &full_path);
+  void close();
+  bool is_open() const { return this->file_ != nullptr; }
+
+  const AssetPackEntry *find(uint32_t name_hash) const;
+  const AssetPackEntry *find(const std::string &name) const { return this->find(asset_name_hash(name)); }
+
+  // One seek + one read of entry.size bytes into dst (safe from the loader task)
+  bool read(const AssetPackEntry &entry, uint8_t *dst);
+  // First min(len, entry.size) bytes of the entry, for header probes; returns the count read
+  size_t read_prefix(const AssetPackEntry &entry, uint8_t *dst, size_t len);
+
+  size_t get_entry_count() const { return this->entries_.size(); }
+  const std::string &get_path() const { return this->path_; }
+
+ protected:
+  FILE *file_{nullptr};
+  std::string path_;
+  std::vector<AssetPackEntry> entries_;
+  Mutex lock_;  // the FILE position is shared between callers
+};
+
+}  // namespace storage
+}  // namespace esphome
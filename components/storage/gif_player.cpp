@@ -0,0 +1,262 @@
+#include "gif_player.h"
+
+#ifdef USE_ANIMATEDGIF
+
+#include "stream_io.h"
+#include "esphome/core/log.h"
+#include <algorithm>
+#include <cstring>
+
+namespace esphome {
+namespace storage {
+
+static const char *const TAG = "storage.gif";
+
+// =====================================================
+// Decoder callback
+// =====================================================
+
+void GifPlayer::draw_cb_(GIFDRAW *draw) {
+  if (draw && draw->pUser) {
+    static_cast<GifPlayer *>(draw->pUser)->draw_line_(draw);
+  }
+}
+
+// =====================================================
+// Player
+// =====================================================
+
+bool GifPlayer::open(const std::string &full_path, bool big_endian) {
+  this->close();
+
+  this->gif_ = new ANIMATEDGIF();
+  if (!this->gif_) {
+    ESP_LOGE(TAG, "Failed to allocate GIF decoder");
+    return false;
+  }
+  // Palette déjà dans l'ordre de l'écran: les pixels sont recopiés sans swap
+  this->gif_->begin(big_endian ? GIF_PALETTE_RGB565_BE : GIF_PALETTE_RGB565_LE);
+
+  // AnimatedGIF garde le pointeur du nom: path_ doit vivre aussi longtemps que le décodeur
+  this->path_ = full_path;
+  if (!this->gif_->open(this->path_.c_str(), stream_open, stream_close, stream_read<GIFFILE>, stream_seek<GIFFILE>,
+                        GifPlayer::draw_cb_)) {
+    ESP_LOGE(TAG, "Not a readable GIF: %s (error %d)", full_path.c_str(), this->gif_->getLastError());
+    delete this->gif_;
+    this->gif_ = nullptr;
+    return false;
+  }
+
+  this->width_ = this->gif_->getCanvasWidth();
+  this->height_ = this->gif_->getCanvasHeight();
+  if (this->width_ <= 0 || this->height_ <= 0 || this->width_ > 2048 || this->height_ > 2048) {
+    ESP_LOGE(TAG, "Invalid GIF canvas: %dx%d", this->width_, this->height_);
+    this->close();
+    return false;
+  }
+
+  this->out_width_ = this->width_;
+  this->out_height_ = this->height_;
+  this->frame_index_ = -1;
+  this->frame_count_ = 0;
+  this->frame_drawn_ = false;
+  ESP_LOGI(TAG, "Streaming GIF %s: %dx%d", full_path.c_str(), this->width_, this->height_);
+  return true;
+}
+
+void GifPlayer::close() {
+  if (this->gif_) {
+    this->gif_->close();
+    delete this->gif_;
+    this->gif_ = nullptr;
+  }
+  this->canvas_ = nullptr;
+}
+
+void GifPlayer::set_output(int width, int height) {
+  this->out_width_ = width > 0 ? width : this->width_;
+  this->out_height_ = height > 0 ? height : this->height_;
+}
+
+int GifPlayer::next_frame(uint8_t *canvas, bool loop) {
+  if (!this->gif_ || !canvas) {
+    return -1;
+  }
+  this->canvas_ = canvas;
+
+  if (this->at_end_) {
+    // Relecture après la dernière frame
+    this->gif_->reset();
+    this->frame_index_ = -1;
+    this->at_end_ = false;
+  }
+
+  this->dirty_x0_ = this->width_;
+  this->dirty_y0_ = this->height_;
+  this->dirty_x1_ = 0;
+  this->dirty_y1_ = 0;
+
+  if (this->frame_index_ < 0) {
+    // Première image: canvas au fond
+    this->fill_rect_(0, 0, this->width_, this->height_, 0);
+  } else if (this->frame_drawn_ && this->disposal_ == 2) {
+    // Disposal "restore to background" de l'image précédente
+    this->fill_rect_(this->frame_x_, this->frame_y_, this->frame_w_, this->frame_h_, this->background_);
+  }
+
+  this->frame_drawn_ = false;
+  int delay_ms = 0;
+  int result = this->gif_->playFrame(false, &delay_ms, this);
+  this->canvas_ = nullptr;
+
+  if (result < 0) {
+    ESP_LOGE(TAG, "GIF frame decode failed: error %d", this->gif_->getLastError());
+    return -1;
+  }
+  this->frame_index_++;
+
+  if (result == 0) {
+    // Dernière image: on connaît maintenant le nombre de frames
+    this->frame_count_ = this->frame_index_ + 1;
+    this->at_end_ = true;
+    if (!loop) {
+      return 0;
+    }
+  }
+
+  // Délais à 0 ou 10 ms: les navigateurs affichent à ~100 ms
+  return delay_ms <= 10 ? 100 : delay_ms;
+}
+
+bool GifPlayer::seek(uint8_t *canvas, int frame) {
+  if (!this->gif_ || !canvas || frame < 0) {
+    return false;
+  }
+  if (this->frame_count_ > 0) {
+    frame %= this->frame_count_;
+  }
+
+  // Pas d'index de frames dans un GIF: rembobiner et décoder jusqu'à la cible
+  if (frame <= this->frame_index_) {
+    this->gif_->reset();
+    this->frame_index_ = -1;
+    this->at_end_ = false;
+  }
+  while (this->frame_index_ < frame) {
+    int delay = this->next_frame(canvas, false);
+    if (delay < 0) {
+      return false;
+    }
+    if (delay == 0 && this->frame_index_ < frame) {
+      ESP_LOGW(TAG, "Seek to frame %d: GIF only has %d frames", frame, this->frame_count_);
+      return false;
+    }
+  }
+  return true;
+}
+
+bool GifPlayer::get_dirty_rect(int &x, int &y, int &w, int &h) const {
+  if (this->dirty_x1_ <= this->dirty_x0_ || this->dirty_y1_ <= this->dirty_y0_) {
+    return false;
+  }
+  int x_end, y_end, unused;
+  this->map_cols_(this->dirty_x0_, x, unused);
+  this->map_cols_(this->dirty_x1_ - 1, unused, x_end);
+  this->map_rows_(this->dirty_y0_, y, unused);
+  this->map_rows_(this->dirty_y1_ - 1, unused, y_end);
+  w = x_end - x;
+  h = y_end - y;
+  return w > 0 && h > 0;
+}
+
+void GifPlayer::extend_dirty_(int x, int y, int w, int h) {
+  this->dirty_x0_ = std::max(0, std::min(this->dirty_x0_, x));
+  this->dirty_y0_ = std::max(0, std::min(this->dirty_y0_, y));
+  this->dirty_x1_ = std::min(this->width_, std::max(this->dirty_x1_, x + w));
+  this->dirty_y1_ = std::min(this->height_, std::max(this->dirty_y1_, y + h));
+}
+
+// Nearest neighbour inverse: dst rows whose source row is src_y
+void GifPlayer::map_rows_(int src_y, int &dst_start, int &dst_end) const {
+  dst_start = (src_y * this->out_height_ + this->height_ - 1) / this->height_;
+  dst_end = ((src_y + 1) * this->out_height_ + this->height_ - 1) / this->height_;
+}
+
+void GifPlayer::map_cols_(int src_x, int &dst_start, int &dst_end) const {
+  dst_start = (src_x * this->out_width_ + this->width_ - 1) / this->width_;
+  dst_end = ((src_x + 1) * this->out_width_ + this->width_ - 1) / this->width_;
+}
+
+void GifPlayer::write_pixel_(int dst_x, int dst_y, uint16_t native) {
+  memcpy(this->canvas_ + (dst_y * this->out_width_ + dst_x) * 2, &native, 2);
+}
+
+void GifPlayer::fill_rect_(int x, int y, int w, int h, uint16_t color) {
+  this->extend_dirty_(x, y, w, h);
+  for (int sy = y; sy < y + h && sy < this->height_; sy++) {
+    int dy0, dy1;
+    this->map_rows_(sy, dy0, dy1);
+    for (int dy = dy0; dy < dy1; dy++) {
+      int dx0, dx1, unused;
+      this->map_cols_(x, dx0, unused);
+      this->map_cols_(std::min(x + w, this->width_) - 1, unused, dx1);
+      for (int dx = dx0; dx < dx1; dx++) {
+        this->write_pixel_(dx, dy, color);
+      }
+    }
+  }
+}
+
+void GifPlayer::draw_line_(GIFDRAW *draw) {
+  if (!this->canvas_ || !draw->pPixels || !draw->pPalette) {
+    return;
+  }
+
+  if (!this->frame_drawn_) {
+    // Première ligne de la frame: mémoriser son rectangle et sa disposal
+    this->frame_drawn_ = true;
+    this->frame_x_ = draw->iX;
+    this->frame_y_ = draw->iY;
+    this->frame_w_ = draw->iWidth;
+    this->frame_h_ = draw->iHeight;
+    this->disposal_ = draw->ucDisposalMethod;
+    this->background_ = draw->ucHasTransparency ? 0 : draw->pPalette[draw->ucBackground];
+    this->extend_dirty_(draw->iX, draw->iY, draw->iWidth, draw->iHeight);
+  }
+
+  int src_y = draw->iY + draw->y;
+  if (src_y < 0 || src_y >= this->height_) {
+    return;
+  }
+
+  int dy0, dy1;
+  this->map_rows_(src_y, dy0, dy1);
+  if (dy0 >= dy1) {
+    return;  // ligne sautée par la réduction
+  }
+
+  const uint8_t *indices = draw->pPixels;
+  const uint16_t *palette = draw->pPalette;
+  bool has_transparency = draw->ucHasTransparency;
+  uint8_t transparent = draw->ucTransparent;
+  int x_end = std::min(draw->iX + draw->iWidth, this->width_);
+
+  for (int dy = dy0; dy < dy1; dy++) {
+    for (int src_x = std::max(0, draw->iX); src_x < x_end; src_x++) {
+      uint8_t index = indices[src_x - draw->iX];
+      if (has_transparency && index == transparent) {
+        continue;  // garde le pixel de la frame précédente
+      }
+      int dx0, dx1;
+      this->map_cols_(src_x, dx0, dx1);
+      for (int dx = dx0; dx < dx1; dx++) {
+        this->write_pixel_(dx, dy, palette[index]);
+      }
+    }
+  }
+}
+
+}  // namespace storage
+}  // namespace esphome
+
+#endif  // USE_ANIMATEDGIF
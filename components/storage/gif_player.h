@@ -0,0 +1,94 @@
+#pragma once
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include "storage.h"
+
+#ifdef USE_ANIMATEDGIF
+
+namespace esphome {
+namespace storage {
+
+// =====================================================
+// GifPlayer - lecture d'un GIF animé en streaming depuis la SD
+// =====================================================
+//
+// The file stays open and AnimatedGIF pulls bytes through the read/seek
+// callbacks, so only the decoder state (LZW tables + one line) and the
+// image's canvas live in RAM. Each frame is written line by line into the
+// canvas, touching only its own rectangle; transparent pixels keep the
+// previous content and disposal method 2 clears the previous rectangle to the
+// background colour before the next frame. Disposal 3 (restore previous)
+// would need a second canvas and is handled as 1 (keep).
+//
+// The canvas pointer is passed to every call: it lives in an arena slot that
+// may move when the arena is compacted between two frames.
+class GifPlayer {
+ public:
+  ~GifPlayer() { this->close(); }
+
+  // big_endian: palette (and so the canvas) in the display's byte order
+  bool open(const std::string &full_path, bool big_endian);
+  void close();
+  bool is_open() const { return this->gif_ != nullptr; }
+
+  int get_width() const { return this->width_; }
+  int get_height() const { return this->height_; }
+
+  // Canvas geometry: RGB565, dst size (nearest neighbour when it differs from the GIF)
+  void set_output(int width, int height);
+
+  // Decodes the next frame into canvas; returns the frame delay in ms,
+  // 0 when the last frame was just shown and loop is off, -1 on error
+  int next_frame(uint8_t *canvas, bool loop);
+  // Rewinds and decodes up to `frame` (GIFs have no frame index)
+  bool seek(uint8_t *canvas, int frame);
+
+  int get_frame_index() const { return this->frame_index_; }
+  int get_frame_count() const { return this->frame_count_; }  // 0 until the first loop completes
+
+  // Region of the canvas changed by the last frame, disposal included (output coordinates)
+  bool get_dirty_rect(int &x, int &y, int &w, int &h) const;
+
+ protected:
+  static void draw_cb_(GIFDRAW *draw);
+
+  void draw_line_(GIFDRAW *draw);
+  void fill_rect_(int x, int y, int w, int h, uint16_t color);
+  void extend_dirty_(int x, int y, int w, int h);
+  void write_pixel_(int dst_x, int dst_y, uint16_t native);
+  void map_rows_(int src_y, int &dst_start, int &dst_end) const;
+  void map_cols_(int src_x, int &dst_start, int &dst_end) const;
+
+  ANIMATEDGIF *gif_{nullptr};
+  std::string path_;
+  int width_{0};
+  int height_{0};
+  int out_width_{0};
+  int out_height_{0};
+
+  uint8_t *canvas_{nullptr};  // only valid during next_frame()
+  int frame_index_{-1};
+  int frame_count_{0};
+  bool at_end_{false};  // last frame shown, the next one restarts from 0
+
+  // Rectangle + disposal of the frame currently on the canvas (GIF coordinates)
+  int frame_x_{0};
+  int frame_y_{0};
+  int frame_w_{0};
+  int frame_h_{0};
+  uint8_t disposal_{0};
+  uint16_t background_{0};
+  bool frame_drawn_{false};
+
+  // Union of everything written by the last next_frame() (GIF coordinates)
+  int dirty_x0_{0};
+  int dirty_y0_{0};
+  int dirty_x1_{0};
+  int dirty_y1_{0};
+};
+
+}  // namespace storage
+}  // namespace esphome
+
+#endif  // USE_ANIMATEDGIF
@@ -0,0 +1,363 @@
+#include "image_arena.h"
+#include "esphome/core/log.h"
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace esphome {
+namespace storage {
+
+static const char *const TAG = "storage.arena";
+
+static std::vector<std::function<void()>> &compaction_listeners() {
+  static std::vector<std::function<void()>> listeners;
+  return listeners;
+}
+
+static void notify_compaction() {
+  for (auto &listener : compaction_listeners()) {
+    listener();
+  }
+}
+
+static uint8_t ram_allocator_flags(MemoryPlacement placement) {
+  switch (placement) {
+    case MemoryPlacement::PSRAM:
+      return RAMAllocator<uint8_t>::ALLOC_EXTERNAL;
+    case MemoryPlacement::INTERNAL:
+      return RAMAllocator<uint8_t>::ALLOC_INTERNAL;
+    default:
+      return RAMAllocator<uint8_t>::ALLOC_EXTERNAL | RAMAllocator<uint8_t>::ALLOC_INTERNAL;
+  }
+}
+
+const char *placement_to_string(MemoryPlacement placement) {
+  switch (placement) {
+    case MemoryPlacement::PSRAM: return "PSRAM";
+    case MemoryPlacement::INTERNAL: return "INTERNAL";
+    default: return "AUTO";
+  }
+}
+
+// =====================================================
+// ImageArena
+// =====================================================
+
+std::atomic<int> ImageArena::pin_count_{0};
+
+ImageArena *ImageArena::get(MemoryPlacement placement) {
+  static ImageArena psram_arena(MemoryPlacement::PSRAM);
+  static ImageArena internal_arena(MemoryPlacement::INTERNAL);
+  return placement == MemoryPlacement::INTERNAL ? &internal_arena : &psram_arena;
+}
+
+void ImageArena::add_compaction_listener(std::function<void()> &&listener) {
+  compaction_listeners().push_back(std::move(listener));
+}
+
+bool ImageArena::init(size_t capacity) {
+  if (this->base_ != nullptr || capacity == 0) {
+    return this->base_ != nullptr;
+  }
+
+  capacity = align_(capacity);
+  RAMAllocator<uint8_t> allocator(ram_allocator_flags(this->placement_));
+  this->base_ = allocator.allocate(capacity);
+  if (this->base_ == nullptr) {
+    ESP_LOGE(TAG, "Failed to reserve %zu bytes for the %s image arena", capacity,
+             placement_to_string(this->placement_));
+    return false;
+  }
+
+  this->capacity_ = capacity;
+  this->blocks_.clear();
+  this->blocks_.push_back({0, static_cast<uint32_t>(capacity), nullptr});
+  ESP_LOGI(TAG, "%s image arena: %zu bytes at %p", placement_to_string(this->placement_), capacity, this->base_);
+  return true;
+}
+
+int ImageArena::find_block_(const uint8_t *ptr) const {
+  if (this->base_ == nullptr || ptr < this->base_ || ptr >= this->base_ + this->capacity_) {
+    return -1;
+  }
+  uint32_t offset = ptr - this->base_;
+  int lo = 0;
+  int hi = static_cast<int>(this->blocks_.size()) - 1;
+  while (lo <= hi) {
+    int mid = (lo + hi) / 2;
+    if (this->blocks_[mid].offset == offset) {
+      return mid;
+    }
+    if (this->blocks_[mid].offset < offset) {
+      lo = mid + 1;
+    } else {
+      hi = mid - 1;
+    }
+  }
+  return -1;
+}
+
+void ImageArena::coalesce_() {
+  std::vector<Block> merged;
+  merged.reserve(this->blocks_.size());
+  for (const Block &block : this->blocks_) {
+    if (block.owner == nullptr && !merged.empty() && merged.back().owner == nullptr) {
+      merged.back().size += block.size;
+    } else {
+      merged.push_back(block);
+    }
+  }
+  this->blocks_ = std::move(merged);
+}
+
+uint8_t *ImageArena::carve_(size_t index, size_t size, ImageBuffer *owner) {
+  Block &block = this->blocks_[index];
+  if (block.size > size) {
+    Block rest{static_cast<uint32_t>(block.offset + size), static_cast<uint32_t>(block.size - size), nullptr};
+    block.size = size;
+    block.owner = owner;
+    uint32_t offset = block.offset;
+    this->blocks_.insert(this->blocks_.begin() + index + 1, rest);
+    return this->base_ + offset;
+  }
+  block.owner = owner;
+  return this->base_ + block.offset;
+}
+
+uint8_t *ImageArena::allocate(size_t size, ImageBuffer *owner) {
+  if (this->base_ == nullptr || size == 0 || size > this->capacity_) {
+    return nullptr;
+  }
+
+  size_t need = align_(size);
+  uint8_t *ptr = nullptr;
+  bool compacted = false;
+  {
+    LockGuard guard(this->lock_);
+
+    // 1. Same-sized slot left by a previous unload/reload
+    for (size_t i = 0; i < this->blocks_.size(); i++) {
+      if (this->blocks_[i].owner == nullptr && this->blocks_[i].size == need) {
+        this->blocks_[i].owner = owner;
+        this->reuse_hits_++;
+        return this->base_ + this->blocks_[i].offset;
+      }
+    }
+
+    // 2. Merge neighbours, then best fit
+    this->coalesce_();
+    int best = -1;
+    size_t total_free = 0;
+    for (size_t i = 0; i < this->blocks_.size(); i++) {
+      const Block &block = this->blocks_[i];
+      if (block.owner != nullptr) {
+        continue;
+      }
+      total_free += block.size;
+      if (block.size >= need && (best < 0 || block.size < this->blocks_[best].size)) {
+        best = i;
+      }
+    }
+
+    // 3. Enough space but scattered: compact, leaving one free block at the end
+    if (best < 0 && total_free >= need && !is_pinned()) {
+      ESP_LOGD(TAG, "%s arena: no %zu byte hole in %zu free bytes, compacting",
+               placement_to_string(this->placement_), need, total_free);
+      this->compact_locked_();
+      compacted = true;
+      best = static_cast<int>(this->blocks_.size()) - 1;
+    }
+
+    if (best >= 0) {
+      ptr = this->carve_(best, need, owner);
+    }
+  }
+
+  if (compacted) {
+    notify_compaction();
+  }
+  return ptr;
+}
+
+void ImageArena::release(const uint8_t *ptr) {
+  LockGuard guard(this->lock_);
+  int index = this->find_block_(ptr);
+  if (index < 0) {
+    ESP_LOGE(TAG, "Release of unknown pointer %p", ptr);
+    return;
+  }
+  this->blocks_[index].owner = nullptr;
+}
+
+void ImageArena::set_owner(const uint8_t *ptr, ImageBuffer *owner) {
+  LockGuard guard(this->lock_);
+  int index = this->find_block_(ptr);
+  if (index >= 0) {
+    this->blocks_[index].owner = owner;
+  }
+}
+
+size_t ImageArena::compact_locked_() {
+  std::vector<Block> live;
+  live.reserve(this->blocks_.size() + 1);
+  uint32_t write = 0;
+  size_t moved = 0;
+
+  for (const Block &block : this->blocks_) {
+    if (block.owner == nullptr) {
+      continue;
+    }
+    if (block.offset != write) {
+      memmove(this->base_ + write, this->base_ + block.offset, block.size);
+      block.owner->data_ = this->base_ + write;
+      moved += block.size;
+    }
+    live.push_back({write, block.size, block.owner});
+    write += block.size;
+  }
+
+  if (write < this->capacity_) {
+    live.push_back({write, static_cast<uint32_t>(this->capacity_ - write), nullptr});
+  }
+
+  this->blocks_ = std::move(live);
+  this->compactions_++;
+  ESP_LOGI(TAG, "%s arena compacted: %zu bytes moved", placement_to_string(this->placement_), moved);
+  return moved;
+}
+
+size_t ImageArena::compact() {
+  size_t moved;
+  {
+    LockGuard guard(this->lock_);
+    if (this->base_ == nullptr || is_pinned()) {
+      return 0;
+    }
+    moved = this->compact_locked_();
+  }
+  if (moved > 0) {
+    notify_compaction();
+  }
+  return moved;
+}
+
+bool ImageArena::compact_if_fragmented(float threshold) {
+  ArenaStats stats = this->get_stats();
+  if (stats.free_blocks < 2 || stats.fragmentation() < threshold || is_pinned()) {
+    return false;
+  }
+  ESP_LOGD(TAG, "%s arena fragmentation %.0f%% over %zu free blocks",
+           placement_to_string(this->placement_), stats.fragmentation() * 100.0f, stats.free_blocks);
+  this->compact();
+  return true;
+}
+
+ArenaStats ImageArena::get_stats() const {
+  LockGuard guard(this->lock_);
+  ArenaStats stats;
+  stats.capacity = this->capacity_;
+  stats.reuse_hits = this->reuse_hits_;
+  stats.compactions = this->compactions_;
+  stats.heap_fallbacks = this->heap_fallbacks_;
+
+  // Adjacent free slots count as one hole
+  size_t run = 0;
+  for (const Block &block : this->blocks_) {
+    if (block.owner == nullptr) {
+      if (run == 0) {
+        stats.free_blocks++;
+      }
+      run += block.size;
+      stats.free += block.size;
+      stats.largest_free = std::max(stats.largest_free, run);
+    } else {
+      run = 0;
+      stats.used += block.size;
+    }
+  }
+  return stats;
+}
+
+// =====================================================
+// ImageBuffer
+// =====================================================
+
+bool ImageBuffer::allocate(size_t size, MemoryPlacement placement) {
+  this->release();
+  if (size == 0) {
+    return false;
+  }
+
+  this->placement_ = placement;
+
+  // Arena first: the requested one, or PSRAM then internal for AUTO
+  ImageArena *candidates[2] = {ImageArena::get(placement), nullptr};
+  if (placement == MemoryPlacement::AUTO) {
+    candidates[1] = ImageArena::get(MemoryPlacement::INTERNAL);
+  }
+  for (ImageArena *arena : candidates) {
+    if (arena == nullptr || !arena->is_initialized()) {
+      continue;
+    }
+    uint8_t *ptr = arena->allocate(size, this);
+    if (ptr != nullptr) {
+      this->data_ = ptr;
+      this->size_ = size;
+      this->arena_ = arena;
+      memset(this->data_, 0, size);
+      return true;
+    }
+  }
+
+  // Arena full or not configured: plain heap with the same placement
+  if (candidates[0]->is_initialized()) {
+    candidates[0]->count_heap_fallback();
+  }
+  RAMAllocator<uint8_t> allocator(ram_allocator_flags(placement));
+  uint8_t *ptr = allocator.allocate(size);
+  if (ptr == nullptr) {
+    return false;
+  }
+  this->data_ = ptr;
+  this->size_ = size;
+  this->arena_ = nullptr;
+  memset(this->data_, 0, size);
+  return true;
+}
+
+void ImageBuffer::release() {
+  if (this->data_ == nullptr) {
+    return;
+  }
+  if (this->arena_ != nullptr) {
+    this->arena_->release(this->data_);
+  } else {
+    RAMAllocator<uint8_t> allocator(ram_allocator_flags(this->placement_));
+    allocator.deallocate(this->data_, this->size_);
+  }
+  this->data_ = nullptr;
+  this->size_ = 0;
+  this->arena_ = nullptr;
+}
+
+void ImageBuffer::take_(ImageBuffer &other) {
+  this->data_ = other.data_;
+  this->size_ = other.size_;
+  this->arena_ = other.arena_;
+  this->placement_ = other.placement_;
+  if (this->arena_ != nullptr) {
+    this->arena_->set_owner(this->data_, this);
+  }
+  other.data_ = nullptr;
+  other.size_ = 0;
+  other.arena_ = nullptr;
+}
+
+void ImageBuffer::swap(ImageBuffer &other) {
+  ImageBuffer tmp(std::move(other));
+  other = std::move(*this);
+  *this = std::move(tmp);
+}
+
+}  // namespace storage
+}  // namespace esphome
@@ -0,0 +1,151 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "esphome/core/helpers.h"
+
+namespace esphome {
+namespace storage {
+
+class ImageBuffer;
+
+enum class MemoryPlacement : uint8_t {
+  AUTO,      // PSRAM when available, internal RAM otherwise
+  PSRAM,
+  INTERNAL,
+};
+
+struct ArenaStats {
+  size_t capacity{0};
+  size_t used{0};
+  size_t free{0};
+  size_t free_blocks{0};
+  size_t largest_free{0};
+  uint32_t reuse_hits{0};        // allocations served by a same-sized free slot
+  uint32_t compactions{0};
+  uint32_t heap_fallbacks{0};    // allocations that did not fit in the arena
+  float fragmentation() const { return this->free == 0 ? 0.0f : 1.0f - (float) this->largest_free / this->free; }
+};
+
+// =====================================================
+// ImageArena - one contiguous region per placement
+// =====================================================
+//
+// Image buffers are carved out of a region allocated once at setup, so
+// reloading images never goes back to the system heap. Released slots are
+// kept as-is (no immediate coalescing) so a reload of the same size lands in
+// the same slot. Adjacent free slots are merged only when an allocation finds
+// no exact fit, and live blocks are slid down (compaction) when the free
+// space is too fragmented to satisfy a request.
+//
+// Compaction moves memory: owners are updated in place and the compaction
+// listeners are called so users of data() (image::Image::data_start_) refresh.
+class ImageArena {
+ public:
+  static ImageArena *get(MemoryPlacement placement);
+  static void add_compaction_listener(std::function<void()> &&listener);
+
+  // While pinned (a decode is writing into a buffer from another task),
+  // no arena moves memory; allocations that need compaction fall back to heap.
+  static void pin() { pin_count_++; }
+  static void unpin() { pin_count_--; }
+  static bool is_pinned() { return pin_count_.load() > 0; }
+
+  bool init(size_t capacity);
+  bool is_initialized() const { return this->base_ != nullptr; }
+
+  uint8_t *allocate(size_t size, ImageBuffer *owner);
+  void release(const uint8_t *ptr);
+  void set_owner(const uint8_t *ptr, ImageBuffer *owner);
+
+  // Slides every live block to the start of the region; returns bytes moved
+  size_t compact();
+  bool compact_if_fragmented(float threshold);
+
+  ArenaStats get_stats() const;
+  void count_heap_fallback() { this->heap_fallbacks_++; }
+
+ protected:
+  explicit ImageArena(MemoryPlacement placement) : placement_(placement) {}
+
+  struct Block {
+    uint32_t offset;
+    uint32_t size;
+    ImageBuffer *owner;  // nullptr = free
+  };
+
+  static constexpr size_t ALIGNMENT = 16;
+  static size_t align_(size_t size) { return (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1); }
+
+  int find_block_(const uint8_t *ptr) const;
+  void coalesce_();
+  uint8_t *carve_(size_t index, size_t size, ImageBuffer *owner);
+  size_t compact_locked_();
+
+  MemoryPlacement placement_;
+  uint8_t *base_{nullptr};
+  size_t capacity_{0};
+  std::vector<Block> blocks_;  // sorted by offset, covers the whole region
+  uint32_t reuse_hits_{0};
+  uint32_t compactions_{0};
+  uint32_t heap_fallbacks_{0};
+  mutable Mutex lock_;
+  static std::atomic<int> pin_count_;
+};
+
+// =====================================================
+// ImageBuffer - owning handle on an arena slot
+// =====================================================
+//
+// Drop-in for the std::vector<uint8_t> previously used by SdImageComponent
+// (data/size/empty/operator[]), but backed by an ImageArena slot or, when the
+// arena is full or not configured, a heap block with the requested placement.
+class ImageBuffer {
+ public:
+  ImageBuffer() = default;
+  ~ImageBuffer() { this->release(); }
+
+  ImageBuffer(const ImageBuffer &) = delete;
+  ImageBuffer &operator=(const ImageBuffer &) = delete;
+  ImageBuffer(ImageBuffer &&other) noexcept { this->take_(other); }
+  ImageBuffer &operator=(ImageBuffer &&other) noexcept {
+    if (this != &other) {
+      this->release();
+      this->take_(other);
+    }
+    return *this;
+  }
+
+  // Zero-filled allocation, any previous content is released first
+  bool allocate(size_t size, MemoryPlacement placement);
+  void release();
+  void clear() { this->release(); }
+  void swap(ImageBuffer &other);
+
+  uint8_t *data() { return this->data_; }
+  const uint8_t *data() const { return this->data_; }
+  size_t size() const { return this->size_; }
+  bool empty() const { return this->size_ == 0; }
+  uint8_t &operator[](size_t index) { return this->data_[index]; }
+  const uint8_t &operator[](size_t index) const { return this->data_[index]; }
+
+  bool is_in_arena() const { return this->arena_ != nullptr; }
+  MemoryPlacement get_placement() const { return this->placement_; }
+
+ protected:
+  friend class ImageArena;
+
+  void take_(ImageBuffer &other);
+
+  uint8_t *data_{nullptr};
+  size_t size_{0};
+  ImageArena *arena_{nullptr};  // nullptr with data_ set = heap fallback
+  MemoryPlacement placement_{MemoryPlacement::AUTO};
+};
+
+const char *placement_to_string(MemoryPlacement placement);
+
+}  // namespace storage
+}  // namespace esphome
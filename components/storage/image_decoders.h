@@ -0,0 +1,43 @@
+#pragma once
+#include "esphome/core/defines.h"
+
+// Image decoder configuration for ESP-IDF
+// PNGdec (png_decoder: pngdec): décodeur par lignes, pngle garde l'Adam7
+#ifdef USE_STORAGE_PNGDEC
+  #define USE_PNGDEC
+#endif
+
+#ifdef ESP_IDF_VERSION
+  #define USE_JPEGDEC
+  #if defined(CONFIG_ESPHOME_ENABLE_PNGLE) || defined(USE_STORAGE_PNG_SUPPORT)
+    #define USE_PNGLE
+  #endif
+  #if defined(CONFIG_ESPHOME_ENABLE_ANIMATEDGIF) || defined(USE_STORAGE_GIF_SUPPORT)
+    #define USE_ANIMATEDGIF
+  #endif
+#else
+  #define USE_JPEGDEC
+  #if defined(ENABLE_PNGLE) || defined(USE_STORAGE_PNG_SUPPORT)
+    #define USE_PNGLE
+  #endif
+  #if defined(ENABLE_ANIMATEDGIF) || defined(USE_STORAGE_GIF_SUPPORT)
+    #define USE_ANIMATEDGIF
+  #endif
+#endif
+
+// Image decoders
+#ifdef USE_JPEGDEC
+#include <JPEGDEC.h>
+#endif
+
+#ifdef USE_PNGLE
+#include <pngle.h>
+#endif
+
+#ifdef USE_PNGDEC
+#include <PNGdec.h>
+#endif
+
+#ifdef USE_ANIMATEDGIF
+#include <AnimatedGIF.h>
+#endif
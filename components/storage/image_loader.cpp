@@ -0,0 +1,216 @@
+#include "image_loader.h"
+#include "storage.h"
+#include "esphome/core/log.h"
+#include "esphome/core/application.h"
+#include "esphome/core/hal.h"
+#include <algorithm>
+
+namespace esphome {
+namespace storage {
+
+static const char *const TAG = "storage.loader";
+
+#ifdef ESP32
+// Tous les workers de tous les StorageComponent (enregistrés pendant setup())
+static const int MAX_REGISTERED_WORKERS = 8;
+static TaskHandle_t worker_handles[MAX_REGISTERED_WORKERS] = {};
+static int worker_handle_count = 0;
+#endif
+
+bool ImageLoader::start(uint32_t stack_size, uint8_t workers, int core) {
+#ifdef ESP32
+  if (this->worker_count_ > 0) {
+    return true;
+  }
+  workers = std::max<uint8_t>(1, std::min<uint8_t>(workers, MAX_WORKERS));
+  if (portNUM_PROCESSORS < 2) {
+    workers = 1;  // ESP32-S2/C3/C6: un seul cœur, un second worker n'apporte rien
+  }
+
+  for (uint8_t i = 0; i < workers && worker_handle_count < MAX_REGISTERED_WORKERS; i++) {
+    int worker_core = workers > 1 ? i : core;
+    TaskHandle_t handle = nullptr;
+    BaseType_t result;
+    if (worker_core < 0 || worker_core >= portNUM_PROCESSORS) {
+      result = xTaskCreate(ImageLoader::task_entry_, "sd_image_loader", stack_size, this, 1, &handle);
+    } else {
+      result = xTaskCreatePinnedToCore(ImageLoader::task_entry_, "sd_image_loader", stack_size, this, 1, &handle,
+                                       worker_core);
+    }
+    if (result != pdPASS) {
+      ESP_LOGE(TAG, "Failed to start image loader worker %u (stack %u bytes)", i, stack_size);
+      break;
+    }
+    this->tasks_[this->worker_count_++] = handle;
+    worker_handles[worker_handle_count++] = handle;
+    ESP_LOGI(TAG, "Image loader worker %u started (core %s)", i,
+             worker_core < 0 ? "any" : (worker_core == 0 ? "0" : "1"));
+  }
+  return this->worker_count_ > 0;
+#else
+  ESP_LOGW(TAG, "Background loading needs FreeRTOS, images will load synchronously");
+  return false;
+#endif
+}
+
+uint32_t load_deadline(LoadPriority priority) {
+  static const uint32_t SLACK_MS[] = {0, 500, 2000};
+  return millis() + SLACK_MS[priority];
+}
+
+bool ImageLoader::submit(LoadJob &&job) {
+  if (!this->is_running()) {
+    return false;
+  }
+  {
+    LockGuard guard(this->lock_);
+    this->queue_.push_back(std::move(job));
+  }
+#ifdef ESP32
+  // Tous les workers se réveillent, le premier qui prend le verrou prend le job
+  for (uint8_t i = 0; i < this->worker_count_; i++) {
+    xTaskNotifyGive(this->tasks_[i]);
+  }
+#endif
+  return true;
+}
+
+void ImageLoader::promote(SdImageComponent *image, uint32_t deadline) {
+  LockGuard guard(this->lock_);
+  for (LoadJob &job : this->queue_) {
+    if (job.image == image && (int32_t) (deadline - job.deadline) < 0) {
+      job.deadline = deadline;
+    }
+  }
+}
+
+bool ImageLoader::pop_completed(LoadJob &job) {
+  LockGuard guard(this->lock_);
+  if (this->completed_.empty()) {
+    return false;
+  }
+  job = std::move(this->completed_.front());
+  this->completed_.erase(this->completed_.begin());
+  return true;
+}
+
+size_t ImageLoader::get_queued() const {
+  LockGuard guard(this->lock_);
+  return this->queue_.size() + (this->has_active_ ? 1 : 0);
+}
+
+bool ImageLoader::take_next_(LoadJob &job) {
+  LockGuard guard(this->lock_);
+  if (this->queue_.empty()) {
+    return false;
+  }
+  // Échéance la plus proche (comparaison sûre au débordement de millis()), FIFO à égalité
+  auto next = std::min_element(this->queue_.begin(), this->queue_.end(), [](const LoadJob &a, const LoadJob &b) {
+    return (int32_t) (a.deadline - b.deadline) < 0;
+  });
+  job = std::move(*next);
+  this->queue_.erase(next);
+  return true;
+}
+
+void ImageLoader::complete_(LoadJob &job, uint32_t start) {
+  ESP_LOGD(TAG, "%s decoded in %u ms (%s)", job.path.c_str(), millis() - start, job.success ? "ok" : "failed");
+  LockGuard guard(this->lock_);
+  this->completed_.push_back(std::move(job));
+}
+
+void ImageLoader::run_slice() {
+  if (!this->is_sliced()) {
+    return;
+  }
+  // Au moins un pas par passage, même si le budget est déjà consommé
+  uint32_t deadline = micros() + this->slice_budget_us_;
+  do {
+    if (!this->has_active_) {
+      if (!this->take_next_(this->active_)) {
+        return;
+      }
+      this->has_active_ = true;
+      this->active_start_ = millis();
+      if (this->active_.thumbnails != nullptr) {
+        this->active_.success = this->active_.thumbnails->render(this->active_.path);
+        this->has_active_ = false;
+        this->complete_(this->active_, this->active_start_);
+        continue;
+      }
+      if (!this->active_.image->begin_sliced_decode(this->active_.path)) {
+        this->active_.success = false;
+        this->has_active_ = false;
+        this->complete_(this->active_, this->active_start_);
+        continue;
+      }
+    }
+    if (this->active_.image->step_sliced_decode(deadline, this->active_.success)) {
+      this->has_active_ = false;
+      this->complete_(this->active_, this->active_start_);
+    }
+  } while ((int32_t) (micros() - deadline) < 0);
+}
+
+void ImageLoader::task_entry_(void *arg) { static_cast<ImageLoader *>(arg)->run_(); }
+
+void ImageLoader::run_() {
+#ifdef ESP32
+  while (true) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+    LoadJob job;
+    while (this->take_next_(job)) {
+      uint32_t start = millis();
+      // Pas de compactage d'arène pendant que le décodeur écrit dans le buffer
+      ImageArena::pin();
+      if (job.thumbnails != nullptr) {
+        job.success = job.thumbnails->render(job.path);
+      } else if (job.preview) {
+        job.success = job.image->decode_preview(job.path);
+      } else {
+        job.success = job.image->decode_in_background(job.path);
+      }
+      ImageArena::unpin();
+      this->complete_(job, start);
+    }
+  }
+#endif
+}
+
+int ImageLoader::current_worker() {
+#ifdef ESP32
+  TaskHandle_t current = xTaskGetCurrentTaskHandle();
+  for (int i = 0; i < worker_handle_count; i++) {
+    if (worker_handles[i] == current) {
+      return i;
+    }
+  }
+#endif
+  return -1;
+}
+
+void decode_yield() {
+#ifdef ESP32
+  int worker = ImageLoader::current_worker();
+  if (worker >= 0) {
+    // Worker: ne jamais toucher au watchdog de la loop, juste céder le
+    // CPU (IDLE compris) au plus toutes les 20 ms
+    static uint32_t last_delay[MAX_REGISTERED_WORKERS] = {};
+    uint32_t now = millis();
+    if (now - last_delay[worker] >= 20) {
+      vTaskDelay(1);
+      last_delay[worker] = millis();
+    }
+    return;
+  }
+  App.feed_wdt();
+  taskYIELD();
+#else
+  App.feed_wdt();
+  yield();
+#endif
+}
+
+}  // namespace storage
+}  // namespace esphome
@@ -0,0 +1,108 @@
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <vector>
+#include "esphome/core/helpers.h"
+
+#ifdef ESP32
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#endif
+
+namespace esphome {
+namespace storage {
+
+class SdImageComponent;
+class ThumbnailCache;
+
+// La priorité fixe l'échéance du job à la soumission; la file sert l'échéance
+// la plus proche d'abord, un préchargement qui attend finit donc par passer
+enum LoadPriority : uint8_t {
+  LOAD_PRIORITY_VISIBLE,   // draw()/diaporama attend l'image: échéance immédiate
+  LOAD_PRIORITY_NORMAL,    // auto-load, actions
+  LOAD_PRIORITY_PREFETCH,  // buffer arrière, vignettes
+};
+
+// millis() + marge de la priorité
+uint32_t load_deadline(LoadPriority priority);
+
+struct LoadJob {
+  SdImageComponent *image{nullptr};
+  ThumbnailCache *thumbnails{nullptr};  // thumbnail job (image is null): path is the source file
+  size_t thumbnail{0};
+  std::string path;
+  uint32_t generation{0};  // unload_image() (ThumbnailCache::close()) bumps it, stale results are dropped
+  uint32_t deadline{0};    // millis(), earliest first
+  bool prefetch{false};    // kept in the back buffer instead of being published
+  bool preview{false};     // first pass: low-resolution preview, the full decode is resubmitted after it
+  bool success{false};
+};
+
+// =====================================================
+// ImageLoader - lecture + décodage hors de la loop principale
+// =====================================================
+//
+// A small pool of FreeRTOS tasks pops jobs, reads and decodes into the
+// image's private DecodeTarget, then parks the job in a completed list. The
+// main loop drains that list and publishes the buffer (budget, swap, base
+// Image properties), so nothing the display reads is ever written from a
+// worker. Decoders carry their component in their user pointer, so two
+// workers decode two different images at the same time; one image never has
+// more than one job in flight (SdImageComponent::load_pending_).
+//
+// Without workers (background loading off, or no FreeRTOS) a slice budget
+// lets the main loop run the same queue itself: run_slice() steps the active
+// job (SdImageComponent::step_sliced_decode) until the budget is spent and
+// picks it up again on the next loop() pass. A thumbnail job is a single step,
+// like a JPEG or GIF load, whose decoder runs its own loop.
+class ImageLoader {
+ public:
+  static const uint8_t MAX_WORKERS = 2;
+
+  // One worker: pinned on `core` (< 0: no affinity). Several: worker i on core i.
+  bool start(uint32_t stack_size, uint8_t workers, int core);
+  bool is_running() const { return this->worker_count_ > 0 || this->is_sliced(); }
+  uint8_t get_worker_count() const { return this->worker_count_; }
+
+  // Temps de décodage par passage de loop() quand il n'y a pas de worker (0 = synchrone)
+  void set_slice_budget(uint32_t budget_us) { this->slice_budget_us_ = budget_us; }
+  uint32_t get_slice_budget() const { return this->slice_budget_us_; }
+  bool is_sliced() const { return this->worker_count_ == 0 && this->slice_budget_us_ > 0; }
+  void run_slice();
+
+  bool submit(LoadJob &&job);
+  // Image dessinée alors que son job attend encore: échéance avancée
+  void promote(SdImageComponent *image, uint32_t deadline);
+  bool pop_completed(LoadJob &job);
+  size_t get_queued() const;
+
+  // Index of the calling worker, -1 on any other task
+  static int current_worker();
+  static bool in_loader_task() { return current_worker() >= 0; }
+
+ protected:
+  static void task_entry_(void *arg);
+  void run_();
+  bool take_next_(LoadJob &job);
+  void complete_(LoadJob &job, uint32_t start);
+
+  std::deque<LoadJob> queue_;
+  std::vector<LoadJob> completed_;
+  mutable Mutex lock_;
+  uint8_t worker_count_{0};
+  uint32_t slice_budget_us_{0};
+  LoadJob active_;  // job découpé en cours (loop principale)
+  bool has_active_{false};
+  uint32_t active_start_{0};
+#ifdef ESP32
+  TaskHandle_t tasks_[MAX_WORKERS]{};
+#endif
+};
+
+// Pause in long decode/resize loops: feeds the watchdog on the main loop,
+// gives the CPU away for a tick (IDLE task included) on the loader task.
+void decode_yield();
+
+}  // namespace storage
+}  // namespace esphome
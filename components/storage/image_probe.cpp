@@ -0,0 +1,187 @@
+#include "image_probe.h"
+#include "qoi_codec.h"
+#include "raw_image.h"
+#include <cstring>
+#include <strings.h>
+
+namespace esphome {
+namespace storage {
+
+const char *image_file_type_to_string(ImageFileType type) {
+  switch (type) {
+    case ImageFileType::JPEG:
+      return "JPEG";
+    case ImageFileType::PNG:
+      return "PNG";
+    case ImageFileType::GIF:
+      return "GIF";
+    case ImageFileType::QOI:
+      return "QOI";
+    case ImageFileType::BMP:
+      return "BMP";
+    case ImageFileType::RAW:
+      return "RAW";
+    default:
+      return "UNKNOWN";
+  }
+}
+
+bool is_image_file_name(const char *name) {
+  const char *ext = strrchr(name, '.');
+  if (!ext || name[0] == '.') {
+    return false;
+  }
+  return strcasecmp(ext, ".jpg") == 0 || strcasecmp(ext, ".jpeg") == 0 || strcasecmp(ext, ".png") == 0 ||
+         strcasecmp(ext, ".gif") == 0 || strcasecmp(ext, ".qoi") == 0 || strcasecmp(ext, ".bmp") == 0;
+}
+
+static bool is_jpeg_sof(uint8_t marker) {
+  // C4 (DHT), C8 (JPG) et CC (DAC) partagent la plage sans être des SOF
+  return marker >= 0xC0 && marker <= 0xCF && marker != 0xC4 && marker != 0xC8 && marker != 0xCC;
+}
+
+// read(offset, dst, len) -> bytes read; size = total source size
+template<typename Read> static bool probe_source(Read &&read, uint32_t size, ImageInfo &info) {
+  info = ImageInfo();
+  info.file_size = size;
+
+  uint8_t head[32];
+  size_t got = read(0, head, sizeof(head));
+  if (got < 8) {
+    return false;
+  }
+
+  // JPEG: marche sur les segments jusqu'au premier SOFn
+  if (head[0] == 0xFF && head[1] == 0xD8) {
+    info.type = ImageFileType::JPEG;
+    uint32_t pos = 2;
+    uint8_t seg[9];
+    for (int guard = 0; guard < 256 && pos + 4 <= size; guard++) {
+      if (read(pos, seg, 4) != 4 || seg[0] != 0xFF) {
+        return false;
+      }
+      uint8_t marker = seg[1];
+      if (marker == 0xFF) {
+        pos++;  // octet de remplissage
+        continue;
+      }
+      if (marker == 0x01 || (marker >= 0xD0 && marker <= 0xD8)) {
+        pos += 2;  // marqueurs sans longueur
+        continue;
+      }
+      if (marker == 0xD9 || marker == 0xDA) {
+        return false;  // fin d'image ou données avant tout SOF
+      }
+      uint16_t length = (seg[2] << 8) | seg[3];
+      if (length < 2) {
+        return false;
+      }
+      if (is_jpeg_sof(marker)) {
+        // précision, hauteur, largeur
+        if (read(pos + 4, seg, 5) != 5) {
+          return false;
+        }
+        info.height = (seg[1] << 8) | seg[2];
+        info.width = (seg[3] << 8) | seg[4];
+        info.progressive = marker == 0xC2 || marker == 0xC6 || marker == 0xCA || marker == 0xCE;
+        return info.width > 0 && info.height > 0;
+      }
+      pos += 2 + length;
+    }
+    return false;
+  }
+
+  // PNG: signature, puis IHDR obligatoirement en premier chunk
+  static const uint8_t PNG_SIGNATURE[8] = {0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A};
+  if (memcmp(head, PNG_SIGNATURE, 8) == 0) {
+    info.type = ImageFileType::PNG;
+    if (got < 29 || memcmp(head + 12, "IHDR", 4) != 0) {
+      return false;
+    }
+    info.width = (head[16] << 24) | (head[17] << 16) | (head[18] << 8) | head[19];
+    info.height = (head[20] << 24) | (head[21] << 16) | (head[22] << 8) | head[23];
+    info.interlaced = head[28] != 0;
+    return info.width > 0 && info.height > 0;
+  }
+
+  // GIF: logical screen descriptor juste après la signature
+  if (memcmp(head, "GIF87a", 6) == 0 || memcmp(head, "GIF89a", 6) == 0) {
+    info.type = ImageFileType::GIF;
+    if (got < 10) {
+      return false;
+    }
+    info.width = head[6] | (head[7] << 8);
+    info.height = head[8] | (head[9] << 8);
+    return info.width > 0 && info.height > 0;
+  }
+
+  // QOI: en-tête fixe de 14 octets
+  QoiHeader qoi;
+  if (is_qoi_data(head, got)) {
+    info.type = ImageFileType::QOI;
+    if (!qoi_read_header(head, got, qoi)) {
+      return false;
+    }
+    info.width = qoi.width;
+    info.height = qoi.height;
+    return true;
+  }
+
+  // BMP: largeur/hauteur signées du BITMAPINFOHEADER (hauteur < 0: lignes de haut en bas)
+  if (is_bmp_data(head, got)) {
+    info.type = ImageFileType::BMP;
+    if (got < 26) {
+      return false;
+    }
+    int32_t height = (int32_t) (head[22] | (head[23] << 8) | (head[24] << 16) | ((uint32_t) head[25] << 24));
+    info.width = (int32_t) (head[18] | (head[19] << 8) | (head[20] << 16) | ((uint32_t) head[21] << 24));
+    info.height = height < 0 ? -height : height;
+    return info.width > 0 && info.height > 0;
+  }
+
+  // .bin LVGL: en-tête de 4 octets sans signature, accepté seulement si la taille concorde
+  RawLayout raw;
+  if (lvgl_bin_read_layout(head, got, size, raw)) {
+    info.type = ImageFileType::RAW;
+    info.width = raw.width;
+    info.height = raw.height;
+    return true;
+  }
+
+  return false;
+}
+
+bool probe_image_file(FILE *file, ImageInfo &info) {
+  if (!file || fseek(file, 0, SEEK_END) != 0) {
+    return false;
+  }
+  long size = ftell(file);
+  if (size <= 0) {
+    return false;
+  }
+  auto read = [file](uint32_t offset, uint8_t *dst, size_t len) -> size_t {
+    if (fseek(file, offset, SEEK_SET) != 0) {
+      return 0;
+    }
+    return fread(dst, 1, len, file);
+  };
+  return probe_source(read, size, info);
+}
+
+bool probe_image_data(const uint8_t *data, size_t size, ImageInfo &info) {
+  if (!data) {
+    return false;
+  }
+  auto read = [data, size](uint32_t offset, uint8_t *dst, size_t len) -> size_t {
+    if (offset >= size) {
+      return 0;
+    }
+    len = len < size - offset ? len : size - offset;
+    memcpy(dst, data + offset, len);
+    return len;
+  };
+  return probe_source(read, size, info);
+}
+
+}  // namespace storage
+}  // namespace esphome
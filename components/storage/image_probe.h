@@ -0,0 +1,49 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+namespace esphome {
+namespace storage {
+
+// =====================================================
+// Image probe - dimensions/type sans décodage
+// =====================================================
+//
+// Reads just the headers: the JPEG marker chain up to the first SOFn
+// (segments are skipped by seeking over them, so a large EXIF block costs no
+// reads), the PNG IHDR chunk, the GIF logical screen descriptor, the QOI or
+// BMP header, or an LVGL .bin header matching the file size. A probe
+// typically touches a few hundred bytes of the file.
+
+enum class ImageFileType : uint8_t {
+  UNKNOWN,
+  JPEG,
+  PNG,
+  GIF,
+  QOI,
+  BMP,
+  RAW,  // .bin LVGL, ou raw aux dimensions configurées (pas de signature)
+};
+
+struct ImageInfo {
+  ImageFileType type{ImageFileType::UNKNOWN};
+  int width{0};
+  int height{0};
+  uint32_t file_size{0};
+  bool progressive{false};  // JPEG SOF2/6/10/14
+  bool interlaced{false};   // PNG Adam7
+};
+
+const char *image_file_type_to_string(ImageFileType type);
+
+// Extension reconnue par les décodeurs (fichiers cachés exclus), pour les listes de dossier
+bool is_image_file_name(const char *name);
+
+// Probes an open file (its position is changed)
+bool probe_image_file(FILE *file, ImageInfo &info);
+// Probes bytes already in memory; false when the headers do not fit in `size`
+bool probe_image_data(const uint8_t *data, size_t size, ImageInfo &info);
+
+}  // namespace storage
+}  // namespace esphome
@@ -0,0 +1,78 @@
+#include "load_stats.h"
+#include "esphome/core/hal.h"
+#include <cstdio>
+
+#ifdef ESP32
+#include <esp_heap_caps.h>
+#endif
+
+namespace esphome {
+namespace storage {
+
+static size_t free_heap() {
+#ifdef ESP32
+  return heap_caps_get_free_size(MALLOC_CAP_8BIT);
+#else
+  return 0;
+#endif
+}
+
+void LoadStats::begin() {
+  *this = LoadStats();
+  this->heap_start_ = this->heap_min_ = free_heap();
+}
+
+void LoadStats::sample_heap() {
+  if (this->heap_start_ == 0) {
+    return;
+  }
+  size_t free = free_heap();
+  if (free < this->heap_min_) {
+    this->heap_min_ = free;
+  }
+  this->peak_heap = this->heap_start_ - this->heap_min_;
+}
+
+void LoadStats::finish(bool success) {
+  this->sample_heap();
+  this->success = success;
+  uint32_t measured = 0;
+  for (int phase = 0; phase < LOAD_PHASE_COUNT; phase++) {
+    if (phase != LOAD_PHASE_DECODE) {
+      measured += this->phase_us[phase];
+    }
+  }
+  this->phase_us[LOAD_PHASE_DECODE] = this->total_us > measured ? this->total_us - measured : 0;
+}
+
+std::string LoadStats::to_string() const {
+  char buffer[160];
+  snprintf(buffer, sizeof(buffer), "%u ms (read %u, decode %u, resize %u, convert %u), %zu B read, heap peak %zu B, %s",
+           (unsigned) this->total_ms(), (unsigned) this->phase_ms(LOAD_PHASE_READ),
+           (unsigned) this->phase_ms(LOAD_PHASE_DECODE), (unsigned) this->phase_ms(LOAD_PHASE_RESIZE),
+           (unsigned) this->phase_ms(LOAD_PHASE_CONVERT), this->bytes_read, this->peak_heap, this->decoder);
+  return std::string(buffer);
+}
+
+LoadPhaseTimer::LoadPhaseTimer(LoadStats &stats, LoadPhase phase) : stats_(stats), phase_(phase), start_(micros()) {}
+
+LoadPhaseTimer::~LoadPhaseTimer() { this->stats_.add(this->phase_, micros() - this->start_); }
+
+// Une portée par tâche: deux workers chargent deux images en même temps
+static thread_local LoadStats *current_stats = nullptr;
+
+LoadStatsScope::LoadStatsScope(LoadStats *stats) : previous_(current_stats) { current_stats = stats; }
+
+LoadStatsScope::~LoadStatsScope() { current_stats = this->previous_; }
+
+LoadStats *LoadStatsScope::current() { return current_stats; }
+
+void note_load_read(size_t bytes, uint32_t elapsed_us) {
+  if (current_stats != nullptr) {
+    current_stats->bytes_read += bytes;
+    current_stats->add(LOAD_PHASE_READ, elapsed_us);
+  }
+}
+
+}  // namespace storage
+}  // namespace esphome
@@ -0,0 +1,79 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace esphome {
+namespace storage {
+
+// =====================================================
+// LoadStats - où passe le temps d'un chargement
+// =====================================================
+//
+// Filled while one image is read and decoded (loader task or main loop) and
+// handed to the component when the result comes back. Read time is measured
+// around every file read made for the load (LoadStatsScope below), resize and
+// conversion around their passes; decode is what is left, so the four phases
+// add up to the total. Peak heap is the largest drop of free heap seen at the
+// allocations of the load: approximate when two workers load at the same time.
+
+enum LoadPhase : uint8_t {
+  LOAD_PHASE_READ,
+  LOAD_PHASE_DECODE,
+  LOAD_PHASE_RESIZE,
+  LOAD_PHASE_CONVERT,
+  LOAD_PHASE_COUNT,
+};
+
+struct LoadStats {
+  uint32_t phase_us[LOAD_PHASE_COUNT]{};
+  uint32_t total_us{0};
+  size_t bytes_read{0};
+  size_t peak_heap{0};
+  const char *decoder{"none"};
+  bool success{false};
+
+  void begin();
+  // total_us renseigné: le décodage reçoit le temps non attribué
+  void finish(bool success);
+  void add(LoadPhase phase, uint32_t elapsed_us) { this->phase_us[phase] += elapsed_us; }
+  void sample_heap();
+  uint32_t phase_ms(LoadPhase phase) const { return this->phase_us[phase] / 1000; }
+  uint32_t total_ms() const { return this->total_us / 1000; }
+  // "123 ms (read 10, decode 100, resize 8, convert 5), 45678 B read, heap peak 20480 B, JPEGDEC"
+  std::string to_string() const;
+
+ protected:
+  size_t heap_start_{0};
+  size_t heap_min_{0};
+};
+
+// Durée de la portée ajoutée à une phase
+class LoadPhaseTimer {
+ public:
+  LoadPhaseTimer(LoadStats &stats, LoadPhase phase);
+  ~LoadPhaseTimer();
+
+ protected:
+  LoadStats &stats_;
+  LoadPhase phase_;
+  uint32_t start_;
+};
+
+// Chargement en cours sur la tâche appelante: les lectures de fichier faites
+// pendant la portée (stream_read des décodeurs compris) y sont comptées
+class LoadStatsScope {
+ public:
+  explicit LoadStatsScope(LoadStats *stats);
+  ~LoadStatsScope();
+  static LoadStats *current();
+
+ protected:
+  LoadStats *previous_;
+};
+
+// Octets lus et durée de la lecture, comptés dans le chargement courant s'il y en a un
+void note_load_read(size_t bytes, uint32_t elapsed_us);
+
+}  // namespace storage
+}  // namespace esphome
@@ -0,0 +1,152 @@
+#include "lvgl_fs.h"
+
+#ifdef USE_LVGL
+#include <cstdio>
+#include <cstring>
+#include <dirent.h>
+#include "esphome/core/log.h"
+
+namespace esphome {
+namespace storage {
+
+static const char *const TAG = "storage.lvgl_fs";
+
+// Taille du buffer fn passé par lv_fs_dir_read()
+static const size_t LVGL_FS_NAME_MAX = 256;
+
+bool LvglFsDriver::register_driver() {
+  if (this->registered_) {
+    return true;
+  }
+  if (lv_fs_get_drv(this->letter_) != nullptr) {
+    ESP_LOGE(TAG, "LVGL drive letter '%c' is already registered", this->letter_);
+    return false;
+  }
+
+  lv_fs_drv_init(&this->drv_);
+  this->drv_.letter = this->letter_;
+  this->drv_.cache_size = this->cache_size_;
+  this->drv_.ready_cb = ready_cb_;
+  this->drv_.open_cb = open_cb_;
+  this->drv_.close_cb = close_cb_;
+  this->drv_.read_cb = read_cb_;
+  this->drv_.write_cb = write_cb_;
+  this->drv_.seek_cb = seek_cb_;
+  this->drv_.tell_cb = tell_cb_;
+  this->drv_.dir_open_cb = dir_open_cb_;
+  this->drv_.dir_read_cb = dir_read_cb_;
+  this->drv_.dir_close_cb = dir_close_cb_;
+  this->drv_.user_data = this;
+  lv_fs_drv_register(&this->drv_);
+
+  this->registered_ = true;
+  ESP_LOGI(TAG, "LVGL drive %c: -> %s (read cache %u bytes)", this->letter_, this->root_path_.c_str(),
+           this->cache_size_);
+  return true;
+}
+
+std::string LvglFsDriver::full_path_(const char *path) const {
+  // LVGL retire "S:" et laisse le reste tel quel ("/img/a.png" ou "img/a.png")
+  std::string full = this->root_path_;
+  if (!full.empty() && full.back() == '/' && path[0] == '/') {
+    full.pop_back();
+  } else if ((full.empty() || full.back() != '/') && path[0] != '/') {
+    full += '/';
+  }
+  return full + path;
+}
+
+bool LvglFsDriver::ready_cb_(lv_fs_drv_t *drv) {
+  auto *self = static_cast<LvglFsDriver *>(drv->user_data);
+  return self->sd_component_ == nullptr || !self->sd_component_->is_failed();
+}
+
+void *LvglFsDriver::open_cb_(lv_fs_drv_t *drv, const char *path, lv_fs_mode_t mode) {
+  auto *self = static_cast<LvglFsDriver *>(drv->user_data);
+  const char *flags = "rb";
+  if (mode == LV_FS_MODE_WR) {
+    flags = "wb";
+  } else if (mode == (LV_FS_MODE_WR | LV_FS_MODE_RD)) {
+    flags = "rb+";
+  }
+
+  std::string full = self->full_path_(path);
+  FILE *file = fopen(full.c_str(), flags);
+  if (file == nullptr) {
+    ESP_LOGW(TAG, "Cannot open %s", full.c_str());
+    return nullptr;
+  }
+  self->open_count_++;
+  ESP_LOGV(TAG, "Opened %s", full.c_str());
+  return file;
+}
+
+lv_fs_res_t LvglFsDriver::close_cb_(lv_fs_drv_t *drv, void *file_p) {
+  return fclose(static_cast<FILE *>(file_p)) == 0 ? LV_FS_RES_OK : LV_FS_RES_HW_ERR;
+}
+
+lv_fs_res_t LvglFsDriver::read_cb_(lv_fs_drv_t *drv, void *file_p, void *buf, uint32_t btr, uint32_t *br) {
+  FILE *file = static_cast<FILE *>(file_p);
+  *br = fread(buf, 1, btr, file);
+  return (*br == btr || !ferror(file)) ? LV_FS_RES_OK : LV_FS_RES_HW_ERR;
+}
+
+lv_fs_res_t LvglFsDriver::write_cb_(lv_fs_drv_t *drv, void *file_p, const void *buf, uint32_t btw, uint32_t *bw) {
+  *bw = fwrite(buf, 1, btw, static_cast<FILE *>(file_p));
+  return *bw == btw ? LV_FS_RES_OK : LV_FS_RES_FULL;
+}
+
+lv_fs_res_t LvglFsDriver::seek_cb_(lv_fs_drv_t *drv, void *file_p, uint32_t pos, lv_fs_whence_t whence) {
+  int origin = SEEK_SET;
+  if (whence == LV_FS_SEEK_CUR) {
+    origin = SEEK_CUR;
+  } else if (whence == LV_FS_SEEK_END) {
+    origin = SEEK_END;
+  }
+  return fseek(static_cast<FILE *>(file_p), pos, origin) == 0 ? LV_FS_RES_OK : LV_FS_RES_INV_PARAM;
+}
+
+lv_fs_res_t LvglFsDriver::tell_cb_(lv_fs_drv_t *drv, void *file_p, uint32_t *pos_p) {
+  long pos = ftell(static_cast<FILE *>(file_p));
+  if (pos < 0) {
+    return LV_FS_RES_HW_ERR;
+  }
+  *pos_p = pos;
+  return LV_FS_RES_OK;
+}
+
+void *LvglFsDriver::dir_open_cb_(lv_fs_drv_t *drv, const char *path) {
+  auto *self = static_cast<LvglFsDriver *>(drv->user_data);
+  std::string full = self->full_path_(path);
+  DIR *dir = opendir(full.c_str());
+  if (dir == nullptr) {
+    ESP_LOGW(TAG, "Cannot open directory %s", full.c_str());
+  }
+  return dir;
+}
+
+lv_fs_res_t LvglFsDriver::dir_read_cb_(lv_fs_drv_t *drv, void *dir_p, char *fn) {
+  // Convention LVGL: dossiers préfixés par '/', chaîne vide à la fin
+  struct dirent *entry;
+  do {
+    entry = readdir(static_cast<DIR *>(dir_p));
+  } while (entry != nullptr && (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0));
+
+  if (entry == nullptr) {
+    fn[0] = '\0';
+  } else if (entry->d_type == DT_DIR) {
+    snprintf(fn, LVGL_FS_NAME_MAX, "/%s", entry->d_name);
+  } else {
+    snprintf(fn, LVGL_FS_NAME_MAX, "%s", entry->d_name);
+  }
+  return LV_FS_RES_OK;
+}
+
+lv_fs_res_t LvglFsDriver::dir_close_cb_(lv_fs_drv_t *drv, void *dir_p) {
+  return closedir(static_cast<DIR *>(dir_p)) == 0 ? LV_FS_RES_OK : LV_FS_RES_HW_ERR;
+}
+
+}  // namespace storage
+}  // namespace esphome
+
+#endif  // USE_LVGL
@@ -0,0 +1,65 @@
+#pragma once
+#include "esphome/core/defines.h"
+
+#ifdef USE_LVGL
+#include <cstdint>
+#include <string>
+#include <lvgl.h>
+#include "../sd_mmc_card/sd_mmc_card.h"
+
+namespace esphome {
+namespace storage {
+
+// =====================================================
+// LVGL file system - lettre de lecteur sur la carte SD
+// =====================================================
+//
+// Registers an lv_fs_drv_t so LVGL opens "S:/images/logo.png" itself: its
+// decoders (when enabled in lv_conf) and its image cache then work on SD
+// files, without a second copy in an SdImageComponent buffer.
+//
+// Paths are resolved under the storage root_path, on the VFS mounted by
+// SdMmc. Reads go through LVGL's per-file read cache (drv.cache_size), so
+// the small header/row reads of its decoders become block-sized freads.
+
+class LvglFsDriver {
+ public:
+  void set_letter(char letter) { this->letter_ = letter; }
+  void set_cache_size(uint16_t cache_size) { this->cache_size_ = cache_size; }
+  void set_root_path(const std::string &root_path) { this->root_path_ = root_path; }
+  void set_sd_component(sd_mmc_card::SdMmc *sd_component) { this->sd_component_ = sd_component; }
+
+  // A appeler une fois LVGL initialisé; false si la lettre est déjà prise
+  bool register_driver();
+  bool is_registered() const { return this->registered_; }
+  char get_letter() const { return this->letter_; }
+  uint16_t get_cache_size() const { return this->cache_size_; }
+  uint32_t get_open_count() const { return this->open_count_; }
+
+ protected:
+  std::string full_path_(const char *path) const;
+
+  static bool ready_cb_(lv_fs_drv_t *drv);
+  static void *open_cb_(lv_fs_drv_t *drv, const char *path, lv_fs_mode_t mode);
+  static lv_fs_res_t close_cb_(lv_fs_drv_t *drv, void *file_p);
+  static lv_fs_res_t read_cb_(lv_fs_drv_t *drv, void *file_p, void *buf, uint32_t btr, uint32_t *br);
+  static lv_fs_res_t write_cb_(lv_fs_drv_t *drv, void *file_p, const void *buf, uint32_t btw, uint32_t *bw);
+  static lv_fs_res_t seek_cb_(lv_fs_drv_t *drv, void *file_p, uint32_t pos, lv_fs_whence_t whence);
+  static lv_fs_res_t tell_cb_(lv_fs_drv_t *drv, void *file_p, uint32_t *pos_p);
+  static void *dir_open_cb_(lv_fs_drv_t *drv, const char *path);
+  static lv_fs_res_t dir_read_cb_(lv_fs_drv_t *drv, void *dir_p, char *fn);
+  static lv_fs_res_t dir_close_cb_(lv_fs_drv_t *drv, void *dir_p);
+
+  lv_fs_drv_t drv_;
+  char letter_{'S'};
+  uint16_t cache_size_{4096};
+  std::string root_path_{"/"};
+  sd_mmc_card::SdMmc *sd_component_{nullptr};
+  bool registered_{false};
+  uint32_t open_count_{0};
+};
+
+}  // namespace storage
+}  // namespace esphome
+
+#endif  // USE_LVGL
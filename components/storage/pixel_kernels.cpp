@@ -0,0 +1,339 @@
+#include "pixel_kernels.h"
+#include <cstring>
+
+// Build-time selection: host SIMD when the compiler targets it, 32-bit SWAR on
+// the ESP32 family (little-endian Xtensa/RISC-V), scalar otherwise.
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define STORAGE_KERNELS_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define STORAGE_KERNELS_NEON
+#elif defined(ESP32) && defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define STORAGE_KERNELS_SWAR
+#endif
+
+namespace esphome {
+namespace storage {
+namespace kernels {
+
+// =====================================================
+// Scalar reference
+// =====================================================
+
+static inline uint16_t load565(const uint8_t *p, bool big_endian) {
+  return big_endian ? (p[0] << 8) | p[1] : p[0] | (p[1] << 8);
+}
+
+static inline void store565(uint8_t *p, uint16_t v, bool big_endian) {
+  p[big_endian ? 0 : 1] = v >> 8;
+  p[big_endian ? 1 : 0] = v & 0xFF;
+}
+
+static inline uint16_t blend_pixel(uint16_t a, uint16_t b, uint16_t weight) {
+  uint16_t inv = 256 - weight;
+  uint16_t r = ((a >> 11) * inv + (b >> 11) * weight) >> 8;
+  uint16_t g = (((a >> 5) & 0x3F) * inv + ((b >> 5) & 0x3F) * weight) >> 8;
+  uint16_t bl = ((a & 0x1F) * inv + (b & 0x1F) * weight) >> 8;
+  return (r << 11) | (g << 5) | bl;
+}
+
+namespace scalar {
+
+void rgba_to_rgb565(const uint8_t *rgba, uint8_t *dst, size_t count, bool big_endian) {
+  for (size_t i = 0; i < count; i++, rgba += 4, dst += 2) {
+    store565(dst, ((rgba[0] >> 3) << 11) | ((rgba[1] >> 2) << 5) | (rgba[2] >> 3), big_endian);
+  }
+}
+
+void swap565(uint8_t *buf, size_t count) {
+  for (size_t i = 0; i < count; i++, buf += 2) {
+    uint8_t t = buf[0];
+    buf[0] = buf[1];
+    buf[1] = t;
+  }
+}
+
+void rgb565_to_rgb888(const uint8_t *src, uint8_t *dst, size_t count, bool big_endian) {
+  for (size_t i = 0; i < count; i++, src += 2, dst += 3) {
+    uint16_t v = load565(src, big_endian);
+    uint8_t r = v >> 11;
+    uint8_t g = (v >> 5) & 0x3F;
+    uint8_t b = v & 0x1F;
+    // Réplication des bits de poids fort: 0x1F -> 0xFF, pas 0xF8
+    dst[0] = (r << 3) | (r >> 2);
+    dst[1] = (g << 2) | (g >> 4);
+    dst[2] = (b << 3) | (b >> 2);
+  }
+}
+
+void blend565(const uint8_t *a, const uint8_t *b, uint8_t *dst, size_t count, uint16_t weight, bool big_endian) {
+  for (size_t i = 0; i < count; i++, a += 2, b += 2, dst += 2) {
+    store565(dst, blend_pixel(load565(a, big_endian), load565(b, big_endian), weight), big_endian);
+  }
+}
+
+void gather565(const uint8_t *src, const uint16_t *x_map, uint8_t *dst, size_t count) {
+  for (size_t i = 0; i < count; i++, dst += 2) {
+    const uint8_t *p = src + x_map[i] * 2;
+    dst[0] = p[0];
+    dst[1] = p[1];
+  }
+}
+
+void resample565(const uint8_t *src, size_t src_count, const uint16_t *x_map, const uint16_t *x_weight, uint8_t *dst,
+                 size_t count, bool big_endian) {
+  for (size_t i = 0; i < count; i++, dst += 2) {
+    size_t x0 = x_map[i];
+    size_t x1 = x0 + 1 < src_count ? x0 + 1 : x0;
+    uint16_t a = load565(src + x0 * 2, big_endian);
+    uint16_t b = load565(src + x1 * 2, big_endian);
+    store565(dst, blend_pixel(a, b, x_weight[i]), big_endian);
+  }
+}
+
+}  // namespace scalar
+
+// gather/resample: aucun jeu d'instructions visé n'a de gather 16 bits utile
+void gather565(const uint8_t *src, const uint16_t *x_map, uint8_t *dst, size_t count) {
+  scalar::gather565(src, x_map, dst, count);
+}
+
+void resample565(const uint8_t *src, size_t src_count, const uint16_t *x_map, const uint16_t *x_weight, uint8_t *dst,
+                 size_t count, bool big_endian) {
+  scalar::resample565(src, src_count, x_map, x_weight, dst, count, big_endian);
+}
+
+#if defined(STORAGE_KERNELS_SSE2)
+
+// =====================================================
+// SSE2 (host x86-64)
+// =====================================================
+
+const char *implementation() { return "sse2"; }
+
+static inline __m128i swap_bytes_sse2(__m128i v) { return _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8)); }
+
+// 4 pixels RGBA -> 4 x RGB565 dans les 16 bits bas de chaque lane 32 bits
+static inline __m128i rgba_to_565_lanes(__m128i v) {
+  __m128i r = _mm_and_si128(v, _mm_set1_epi32(0xF8));
+  __m128i g = _mm_and_si128(v, _mm_set1_epi32(0xFC00));
+  __m128i b = _mm_and_si128(v, _mm_set1_epi32(0xF80000));
+  return _mm_or_si128(_mm_or_si128(_mm_slli_epi32(r, 8), _mm_srli_epi32(g, 5)), _mm_srli_epi32(b, 19));
+}
+
+void rgba_to_rgb565(const uint8_t *rgba, uint8_t *dst, size_t count, bool big_endian) {
+  const __m128i bias32 = _mm_set1_epi32(0x8000);
+  const __m128i bias16 = _mm_set1_epi16((int16_t) 0x8000);
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    __m128i lo = rgba_to_565_lanes(_mm_loadu_si128((const __m128i *) (rgba + i * 4)));
+    __m128i hi = rgba_to_565_lanes(_mm_loadu_si128((const __m128i *) (rgba + i * 4 + 16)));
+    // packs est signé: décaler de 0x8000 pour garder les 16 bits exacts
+    __m128i packed = _mm_packs_epi32(_mm_sub_epi32(lo, bias32), _mm_sub_epi32(hi, bias32));
+    packed = _mm_xor_si128(packed, bias16);
+    if (big_endian) {
+      packed = swap_bytes_sse2(packed);
+    }
+    _mm_storeu_si128((__m128i *) (dst + i * 2), packed);
+  }
+  scalar::rgba_to_rgb565(rgba + i * 4, dst + i * 2, count - i, big_endian);
+}
+
+void swap565(uint8_t *buf, size_t count) {
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    __m128i v = _mm_loadu_si128((const __m128i *) (buf + i * 2));
+    _mm_storeu_si128((__m128i *) (buf + i * 2), swap_bytes_sse2(v));
+  }
+  scalar::swap565(buf + i * 2, count - i);
+}
+
+// Sortie 3 octets/pixel: pas de store SSE2 adapté, la référence suffit
+void rgb565_to_rgb888(const uint8_t *src, uint8_t *dst, size_t count, bool big_endian) {
+  scalar::rgb565_to_rgb888(src, dst, count, big_endian);
+}
+
+void blend565(const uint8_t *a, const uint8_t *b, uint8_t *dst, size_t count, uint16_t weight, bool big_endian) {
+  const __m128i w = _mm_set1_epi16(weight);
+  const __m128i inv = _mm_set1_epi16(256 - weight);
+  const __m128i mask6 = _mm_set1_epi16(0x3F);
+  const __m128i mask5 = _mm_set1_epi16(0x1F);
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    __m128i va = _mm_loadu_si128((const __m128i *) (a + i * 2));
+    __m128i vb = _mm_loadu_si128((const __m128i *) (b + i * 2));
+    if (big_endian) {
+      va = swap_bytes_sse2(va);
+      vb = swap_bytes_sse2(vb);
+    }
+    // Canal * poids tient sur 16 bits: 63 * 256 = 16128
+    __m128i r = _mm_add_epi16(_mm_mullo_epi16(_mm_srli_epi16(va, 11), inv), _mm_mullo_epi16(_mm_srli_epi16(vb, 11), w));
+    __m128i g = _mm_add_epi16(_mm_mullo_epi16(_mm_and_si128(_mm_srli_epi16(va, 5), mask6), inv),
+                              _mm_mullo_epi16(_mm_and_si128(_mm_srli_epi16(vb, 5), mask6), w));
+    __m128i bl = _mm_add_epi16(_mm_mullo_epi16(_mm_and_si128(va, mask5), inv),
+                               _mm_mullo_epi16(_mm_and_si128(vb, mask5), w));
+    __m128i out = _mm_or_si128(_mm_or_si128(_mm_slli_epi16(_mm_srli_epi16(r, 8), 11),
+                                            _mm_slli_epi16(_mm_srli_epi16(g, 8), 5)),
+                               _mm_srli_epi16(bl, 8));
+    if (big_endian) {
+      out = swap_bytes_sse2(out);
+    }
+    _mm_storeu_si128((__m128i *) (dst + i * 2), out);
+  }
+  scalar::blend565(a + i * 2, b + i * 2, dst + i * 2, count - i, weight, big_endian);
+}
+
+#elif defined(STORAGE_KERNELS_NEON)
+
+// =====================================================
+// NEON (host ARM64 / ARMv7)
+// =====================================================
+
+const char *implementation() { return "neon"; }
+
+static inline uint16x8_t load565_neon(const uint8_t *p, bool big_endian) {
+  uint8x16_t v = vld1q_u8(p);
+  if (big_endian) {
+    v = vrev16q_u8(v);
+  }
+  return vreinterpretq_u16_u8(v);
+}
+
+static inline void store565_neon(uint8_t *p, uint16x8_t v, bool big_endian) {
+  uint8x16_t bytes = vreinterpretq_u8_u16(v);
+  if (big_endian) {
+    bytes = vrev16q_u8(bytes);
+  }
+  vst1q_u8(p, bytes);
+}
+
+void rgba_to_rgb565(const uint8_t *rgba, uint8_t *dst, size_t count, bool big_endian) {
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    uint8x8x4_t px = vld4_u8(rgba + i * 4);
+    uint16x8_t r = vshll_n_u8(vand_u8(px.val[0], vdup_n_u8(0xF8)), 8);
+    uint16x8_t g = vshll_n_u8(vand_u8(px.val[1], vdup_n_u8(0xFC)), 3);
+    uint16x8_t b = vmovl_u8(vshr_n_u8(px.val[2], 3));
+    store565_neon(dst + i * 2, vorrq_u16(vorrq_u16(r, g), b), big_endian);
+  }
+  scalar::rgba_to_rgb565(rgba + i * 4, dst + i * 2, count - i, big_endian);
+}
+
+void swap565(uint8_t *buf, size_t count) {
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    vst1q_u8(buf + i * 2, vrev16q_u8(vld1q_u8(buf + i * 2)));
+  }
+  scalar::swap565(buf + i * 2, count - i);
+}
+
+void rgb565_to_rgb888(const uint8_t *src, uint8_t *dst, size_t count, bool big_endian) {
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    uint16x8_t v = load565_neon(src + i * 2, big_endian);
+    uint8x8_t r = vshrn_n_u16(v, 11);
+    uint8x8_t g = vmovn_u16(vandq_u16(vshrq_n_u16(v, 5), vdupq_n_u16(0x3F)));
+    uint8x8_t b = vmovn_u16(vandq_u16(v, vdupq_n_u16(0x1F)));
+    uint8x8x3_t out;
+    out.val[0] = vorr_u8(vshl_n_u8(r, 3), vshr_n_u8(r, 2));
+    out.val[1] = vorr_u8(vshl_n_u8(g, 2), vshr_n_u8(g, 4));
+    out.val[2] = vorr_u8(vshl_n_u8(b, 3), vshr_n_u8(b, 2));
+    vst3_u8(dst + i * 3, out);
+  }
+  scalar::rgb565_to_rgb888(src + i * 2, dst + i * 3, count - i, big_endian);
+}
+
+void blend565(const uint8_t *a, const uint8_t *b, uint8_t *dst, size_t count, uint16_t weight, bool big_endian) {
+  const uint16x8_t w = vdupq_n_u16(weight);
+  const uint16x8_t inv = vdupq_n_u16(256 - weight);
+  const uint16x8_t mask6 = vdupq_n_u16(0x3F);
+  const uint16x8_t mask5 = vdupq_n_u16(0x1F);
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    uint16x8_t va = load565_neon(a + i * 2, big_endian);
+    uint16x8_t vb = load565_neon(b + i * 2, big_endian);
+    uint16x8_t r = vmlaq_u16(vmulq_u16(vshrq_n_u16(va, 11), inv), vshrq_n_u16(vb, 11), w);
+    uint16x8_t g = vmlaq_u16(vmulq_u16(vandq_u16(vshrq_n_u16(va, 5), mask6), inv),
+                             vandq_u16(vshrq_n_u16(vb, 5), mask6), w);
+    uint16x8_t bl = vmlaq_u16(vmulq_u16(vandq_u16(va, mask5), inv), vandq_u16(vb, mask5), w);
+    uint16x8_t out = vorrq_u16(vorrq_u16(vshlq_n_u16(vshrq_n_u16(r, 8), 11), vshlq_n_u16(vshrq_n_u16(g, 8), 5)),
+                               vshrq_n_u16(bl, 8));
+    store565_neon(dst + i * 2, out, big_endian);
+  }
+  scalar::blend565(a + i * 2, b + i * 2, dst + i * 2, count - i, weight, big_endian);
+}
+
+#elif defined(STORAGE_KERNELS_SWAR)
+
+// =====================================================
+// SWAR 32 bits (ESP32, ESP32-S3, C3...)
+// =====================================================
+//
+// Two RGB565 pixels per 32-bit register. The S3 PIE vector unit would need
+// hand-written EE.* assembly with 16-byte aligned buffers; the arena does not
+// guarantee that alignment, so the portable SWAR path is used on every chip.
+
+const char *implementation() { return "swar"; }
+
+static inline uint32_t swap_halves_bytes(uint32_t w) { return ((w & 0x00FF00FF) << 8) | ((w >> 8) & 0x00FF00FF); }
+
+static inline uint32_t rgba_word_to_565(uint32_t v) {
+  return ((v & 0xF8) << 8) | ((v & 0xFC00) >> 5) | ((v & 0xF80000) >> 19);
+}
+
+void rgba_to_rgb565(const uint8_t *rgba, uint8_t *dst, size_t count, bool big_endian) {
+  size_t i = 0;
+  for (; i + 2 <= count; i += 2) {
+    uint32_t p0, p1;
+    memcpy(&p0, rgba + i * 4, 4);
+    memcpy(&p1, rgba + i * 4 + 4, 4);
+    uint32_t out = rgba_word_to_565(p0) | (rgba_word_to_565(p1) << 16);
+    if (big_endian) {
+      out = swap_halves_bytes(out);
+    }
+    memcpy(dst + i * 2, &out, 4);
+  }
+  scalar::rgba_to_rgb565(rgba + i * 4, dst + i * 2, count - i, big_endian);
+}
+
+void swap565(uint8_t *buf, size_t count) {
+  size_t i = 0;
+  for (; i + 2 <= count; i += 2) {
+    uint32_t w;
+    memcpy(&w, buf + i * 2, 4);
+    w = swap_halves_bytes(w);
+    memcpy(buf + i * 2, &w, 4);
+  }
+  scalar::swap565(buf + i * 2, count - i);
+}
+
+void rgb565_to_rgb888(const uint8_t *src, uint8_t *dst, size_t count, bool big_endian) {
+  scalar::rgb565_to_rgb888(src, dst, count, big_endian);
+}
+
+// Les poids 8 bits débordent des champs SWAR 565: référence scalaire
+void blend565(const uint8_t *a, const uint8_t *b, uint8_t *dst, size_t count, uint16_t weight, bool big_endian) {
+  scalar::blend565(a, b, dst, count, weight, big_endian);
+}
+
+#else
+
+const char *implementation() { return "scalar"; }
+
+void rgba_to_rgb565(const uint8_t *rgba, uint8_t *dst, size_t count, bool big_endian) {
+  scalar::rgba_to_rgb565(rgba, dst, count, big_endian);
+}
+void swap565(uint8_t *buf, size_t count) { scalar::swap565(buf, count); }
+void rgb565_to_rgb888(const uint8_t *src, uint8_t *dst, size_t count, bool big_endian) {
+  scalar::rgb565_to_rgb888(src, dst, count, big_endian);
+}
+void blend565(const uint8_t *a, const uint8_t *b, uint8_t *dst, size_t count, uint16_t weight, bool big_endian) {
+  scalar::blend565(a, b, dst, count, weight, big_endian);
+}
+
+#endif
+
+}  // namespace kernels
+}  // namespace storage
+}  // namespace esphome
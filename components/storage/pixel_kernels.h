@@ -0,0 +1,61 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace esphome {
+namespace storage {
+namespace kernels {
+
+// =====================================================
+// Pixel kernels - conversions de lignes entières
+// =====================================================
+//
+// Row kernels used by the decoders, resizers and blit paths. The
+// implementation is picked at build time (see implementation()); every
+// variant must be bit-exact with the scalar reference below, which stays
+// compiled everywhere so the others can be checked against it.
+//
+// RGB565 buffers are 2 bytes per pixel in the given byte order. Blend weights
+// are 0..256 and apply to `b`: out = (a * (256 - w) + b * w) >> 8 per channel.
+
+void rgba_to_rgb565(const uint8_t *rgba, uint8_t *dst, size_t count, bool big_endian);
+void swap565(uint8_t *buf, size_t count);
+void rgb565_to_rgb888(const uint8_t *src, uint8_t *dst, size_t count, bool big_endian);
+void blend565(const uint8_t *a, const uint8_t *b, uint8_t *dst, size_t count, uint16_t weight, bool big_endian);
+// Nearest-neighbour row: dst[i] = src[x_map[i]] (2-byte pixels, order untouched)
+void gather565(const uint8_t *src, const uint16_t *x_map, uint8_t *dst, size_t count);
+// Horizontal bilinear row: dst[i] = blend(src[x_map[i]], src[x_map[i] + 1], x_weight[i]),
+// the right neighbour clamped to src_count - 1
+void resample565(const uint8_t *src, size_t src_count, const uint16_t *x_map, const uint16_t *x_weight, uint8_t *dst,
+                 size_t count, bool big_endian);
+
+// Source index of target pixel i for a nearest-neighbour resize of src_count -> dst_count
+// (resize_image_buffer, both PNG backends; tools/asset_packer.py reproduces it, see
+// tests/asset_packer_parity.py)
+inline int nearest_source(int i, int src_count, int dst_count) {
+  int src = i * src_count / dst_count;
+  return src < src_count - 1 ? src : src_count - 1;
+}
+
+// Inverse for decoders that push source pixels: the targets whose nearest_source()
+// is s are [first_target(s), first_target(s + 1)), empty when s is skipped
+inline int first_target(int s, int src_count, int dst_count) {
+  return (s * dst_count + src_count - 1) / src_count;
+}
+
+// "scalar", "swar", "sse2" or "neon"
+const char *implementation();
+
+namespace scalar {
+void rgba_to_rgb565(const uint8_t *rgba, uint8_t *dst, size_t count, bool big_endian);
+void swap565(uint8_t *buf, size_t count);
+void rgb565_to_rgb888(const uint8_t *src, uint8_t *dst, size_t count, bool big_endian);
+void blend565(const uint8_t *a, const uint8_t *b, uint8_t *dst, size_t count, uint16_t weight, bool big_endian);
+void gather565(const uint8_t *src, const uint16_t *x_map, uint8_t *dst, size_t count);
+void resample565(const uint8_t *src, size_t src_count, const uint16_t *x_map, const uint16_t *x_weight, uint8_t *dst,
+                 size_t count, bool big_endian);
+}  // namespace scalar
+
+}  // namespace kernels
+}  // namespace storage
+}  // namespace esphome
@@ -0,0 +1,186 @@
+#include "pixel_pipeline.h"
+#include <algorithm>
+#include <climits>
+
+namespace esphome {
+namespace storage {
+
+using RGBAPixel = PixelTraits<ImageFormat::RGBA, false>;
+
+template<typename P> static PixelOps make_pixel_ops() {
+  return PixelOps{P::SIZE, &P::pack, &read_color<P>, &convert_row<RGBAPixel, P>};
+}
+
+const PixelOps &get_pixel_ops(ImageFormat format, SdByteOrder order) {
+  static const PixelOps RGB565_LE = make_pixel_ops<PixelTraits<ImageFormat::RGB565, false>>();
+  static const PixelOps RGB565_BE = make_pixel_ops<PixelTraits<ImageFormat::RGB565, true>>();
+  static const PixelOps RGB888 = make_pixel_ops<PixelTraits<ImageFormat::RGB888, false>>();
+  static const PixelOps RGBA = make_pixel_ops<RGBAPixel>();
+
+  switch (format) {
+    case ImageFormat::RGB888:
+      return RGB888;
+    case ImageFormat::RGBA:
+      return RGBA;
+    case ImageFormat::RGB565:
+    default:
+      return order == SdByteOrder::BIG_ENDIAN_SD ? RGB565_BE : RGB565_LE;
+  }
+}
+
+const char *image_format_to_string(ImageFormat format) {
+  switch (format) {
+    case ImageFormat::RGB565: return "RGB565";
+    case ImageFormat::RGB888: return "RGB888";
+    case ImageFormat::RGBA: return "RGBA";
+    case ImageFormat::GRAYSCALE: return "GRAYSCALE";
+    case ImageFormat::BINARY: return "BINARY";
+    case ImageFormat::INDEXED8: return "INDEXED8";
+    default: return "Unknown";
+  }
+}
+
+size_t image_row_bytes(ImageFormat format, int width) {
+  switch (format) {
+    case ImageFormat::BINARY:
+      return (width + 7) / 8;
+    case ImageFormat::GRAYSCALE:
+    case ImageFormat::INDEXED8:
+      return width;
+    default:
+      return width * get_pixel_ops(format, SdByteOrder::LITTLE_ENDIAN_SD).size;
+  }
+}
+
+// =====================================================
+// Quantizer
+// =====================================================
+
+// Seuils 4x4 de Bayer, mis à l'échelle 8..248 à l'usage
+static const uint8_t BAYER_4X4[4][4] = {{0, 8, 2, 10}, {12, 4, 14, 6}, {3, 11, 1, 9}, {15, 7, 13, 5}};
+
+static const size_t PALETTE_CACHE_SIZE = 256;
+static const uint32_t PALETTE_CACHE_VALID = 1u << 24;
+
+void Quantizer::set_palette(const std::vector<uint32_t> &palette) {
+  this->custom_palette_ = !palette.empty();
+  this->palette_.assign(palette.begin(), palette.begin() + std::min<size_t>(palette.size(), 256));
+  this->cache_.assign(this->custom_palette_ ? PALETTE_CACHE_SIZE : 0, 0);
+}
+
+inline void Quantizer::put_binary_(uint8_t *row, int x, int y, uint8_t gray) const {
+  int threshold = this->dither_ ? BAYER_4X4[y & 3][x & 3] * 16 + 8 : 128;
+  uint8_t mask = 0x80 >> (x & 7);
+  if (gray < threshold) {
+    row[x >> 3] |= mask;
+  } else {
+    row[x >> 3] &= ~mask;
+  }
+}
+
+uint8_t Quantizer::nearest_index_(uint8_t r, uint8_t g, uint8_t b) {
+  if (!this->custom_palette_) {
+    // RGB332: l'index est la couleur
+    return (r & 0xE0) | ((g & 0xE0) >> 3) | (b >> 6);
+  }
+
+  // Les pixels voisins se répètent: clé RGB565, une case par hachage
+  uint16_t key = ((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3);
+  uint32_t &slot = this->cache_[((key * 0x9E37u) >> 8) & (PALETTE_CACHE_SIZE - 1)];
+  if ((slot & PALETTE_CACHE_VALID) && ((slot >> 8) & 0xFFFF) == key) {
+    return slot & 0xFF;
+  }
+
+  uint8_t best = 0;
+  int best_dist = INT_MAX;
+  for (size_t i = 0; i < this->palette_.size() && best_dist > 0; i++) {
+    int dr = (int) ((this->palette_[i] >> 16) & 0xFF) - r;
+    int dg = (int) ((this->palette_[i] >> 8) & 0xFF) - g;
+    int db = (int) (this->palette_[i] & 0xFF) - b;
+    // Pondération proche de la luminance perçue
+    int dist = 2 * dr * dr + 4 * dg * dg + 3 * db * db;
+    if (dist < best_dist) {
+      best_dist = dist;
+      best = i;
+    }
+  }
+  slot = PALETTE_CACHE_VALID | ((uint32_t) key << 8) | best;
+  return best;
+}
+
+void Quantizer::put(uint8_t *row, int x, int y, uint8_t r, uint8_t g, uint8_t b) {
+  switch (this->format_) {
+    case ImageFormat::GRAYSCALE:
+      row[x] = luma(r, g, b);
+      break;
+    case ImageFormat::BINARY:
+      this->put_binary_(row, x, y, luma(r, g, b));
+      break;
+    case ImageFormat::INDEXED8:
+      row[x] = this->nearest_index_(r, g, b);
+      break;
+    default:
+      break;
+  }
+}
+
+void Quantizer::put_row565(uint8_t *row, int x, int y, const uint8_t *src, int count, bool big_endian) {
+  // Un seul choix de format par ligne, le décodage RGB565 est commun
+  auto unpack = [big_endian](const uint8_t *p, uint8_t &r, uint8_t &g, uint8_t &b) {
+    uint16_t v = big_endian ? (p[0] << 8) | p[1] : p[0] | (p[1] << 8);
+    // Bits hauts répliqués: le blanc RGB565 reste 255
+    r = ((v >> 8) & 0xF8) | (v >> 13);
+    g = ((v >> 3) & 0xFC) | ((v >> 9) & 0x03);
+    b = ((v << 3) & 0xF8) | ((v >> 2) & 0x07);
+  };
+  uint8_t r, g, b;
+  switch (this->format_) {
+    case ImageFormat::GRAYSCALE:
+      for (int i = 0; i < count; i++, src += 2) {
+        unpack(src, r, g, b);
+        row[x + i] = luma(r, g, b);
+      }
+      break;
+    case ImageFormat::BINARY:
+      for (int i = 0; i < count; i++, src += 2) {
+        unpack(src, r, g, b);
+        this->put_binary_(row, x + i, y, luma(r, g, b));
+      }
+      break;
+    case ImageFormat::INDEXED8:
+      for (int i = 0; i < count; i++, src += 2) {
+        unpack(src, r, g, b);
+        row[x + i] = this->nearest_index_(r, g, b);
+      }
+      break;
+    default:
+      break;
+  }
+}
+
+Color Quantizer::read(const uint8_t *row, int x) const {
+  switch (this->format_) {
+    case ImageFormat::GRAYSCALE:
+      return Color(row[x], row[x], row[x]);
+    case ImageFormat::BINARY:
+      return (row[x >> 3] & (0x80 >> (x & 7))) ? Color(0, 0, 0) : Color(255, 255, 255);
+    case ImageFormat::INDEXED8: {
+      uint8_t index = row[x];
+      if (!this->custom_palette_) {
+        return Color(((index >> 5) & 7) * 255 / 7, ((index >> 2) & 7) * 255 / 7, (index & 3) * 255 / 3);
+      }
+      uint32_t rgb = index < this->palette_.size() ? this->palette_[index] : 0;
+      return Color((rgb >> 16) & 0xFF, (rgb >> 8) & 0xFF, rgb & 0xFF);
+    }
+    default:
+      return Color::BLACK;
+  }
+}
+
+uint16_t Quantizer::palette565(uint8_t index) const {
+  Color c = this->read(&index, 0);
+  return ((c.r >> 3) << 11) | ((c.g >> 2) << 5) | (c.b >> 3);
+}
+
+}  // namespace storage
+}  // namespace esphome
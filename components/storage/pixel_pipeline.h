@@ -0,0 +1,193 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "esphome/core/color.h"
+
+namespace esphome {
+namespace storage {
+
+// Image format enums
+enum class ImageFormat {
+  RGB565,
+  RGB888,
+  RGBA,
+  GRAYSCALE,  // 8 bits de luminance
+  BINARY,     // 1 bit, MSB en premier, lignes complétées à l'octet
+  INDEXED8    // index dans une palette de 256 couleurs au plus
+};
+
+enum class SdByteOrder {
+  LITTLE_ENDIAN_SD,
+  BIG_ENDIAN_SD
+};
+
+// =====================================================
+// Pixel pipeline - lecture/écriture de pixels spécialisées à la compilation
+// =====================================================
+//
+// PixelTraits<format, big_endian> packs and unpacks one pixel with no runtime
+// switch; alpha handling follows from the format (only RGBA stores it).
+// Callers pick the instantiation once per image, either through
+// dispatch_pixel_format() (the whole loop is instantiated per format, so the
+// compiler can unroll/vectorise it) or through the PixelOps table when the
+// caller only sees one pixel at a time (pngle callbacks, get_pixel_color).
+
+template<ImageFormat F, bool BigEndian> struct PixelTraits;
+
+template<bool BigEndian> struct PixelTraits<ImageFormat::RGB565, BigEndian> {
+  static constexpr ImageFormat FORMAT = ImageFormat::RGB565;
+  static constexpr size_t SIZE = 2;
+  static constexpr bool HAS_ALPHA = false;
+
+  static inline void pack(uint8_t *dst, uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
+    uint16_t v = ((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3);
+    dst[BigEndian ? 0 : 1] = v >> 8;
+    dst[BigEndian ? 1 : 0] = v & 0xFF;
+  }
+  static inline void unpack(const uint8_t *src, uint8_t &r, uint8_t &g, uint8_t &b, uint8_t &a) {
+    uint16_t v = BigEndian ? (src[0] << 8) | src[1] : src[0] | (src[1] << 8);
+    r = ((v >> 11) & 0x1F) << 3;
+    g = ((v >> 5) & 0x3F) << 2;
+    b = (v & 0x1F) << 3;
+    a = 255;
+  }
+};
+
+template<bool BigEndian> struct PixelTraits<ImageFormat::RGB888, BigEndian> {
+  static constexpr ImageFormat FORMAT = ImageFormat::RGB888;
+  static constexpr size_t SIZE = 3;
+  static constexpr bool HAS_ALPHA = false;
+
+  static inline void pack(uint8_t *dst, uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
+    dst[0] = r;
+    dst[1] = g;
+    dst[2] = b;
+  }
+  static inline void unpack(const uint8_t *src, uint8_t &r, uint8_t &g, uint8_t &b, uint8_t &a) {
+    r = src[0];
+    g = src[1];
+    b = src[2];
+    a = 255;
+  }
+};
+
+template<bool BigEndian> struct PixelTraits<ImageFormat::RGBA, BigEndian> {
+  static constexpr ImageFormat FORMAT = ImageFormat::RGBA;
+  static constexpr size_t SIZE = 4;
+  static constexpr bool HAS_ALPHA = true;
+
+  static inline void pack(uint8_t *dst, uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
+    dst[0] = r;
+    dst[1] = g;
+    dst[2] = b;
+    dst[3] = a;
+  }
+  static inline void unpack(const uint8_t *src, uint8_t &r, uint8_t &g, uint8_t &b, uint8_t &a) {
+    r = src[0];
+    g = src[1];
+    b = src[2];
+    a = src[3];
+  }
+};
+
+// Conversion d'une ligne entre deux formats (même format: copie)
+template<typename Src, typename Dst> inline void convert_row(const uint8_t *src, uint8_t *dst, int count) {
+  for (int i = 0; i < count; i++) {
+    uint8_t r, g, b, a;
+    Src::unpack(src + i * Src::SIZE, r, g, b, a);
+    Dst::pack(dst + i * Dst::SIZE, r, g, b, a);
+  }
+}
+
+template<typename P> inline Color read_color(const uint8_t *src) {
+  uint8_t r, g, b, a;
+  P::unpack(src, r, g, b, a);
+  return P::HAS_ALPHA ? Color(r, g, b, a) : Color(r, g, b);
+}
+
+// Calls fn(PixelTraits<...>{}) with the instantiation matching the runtime
+// format; fn is typically a generic lambda holding the whole pixel loop.
+template<typename Fn> inline auto dispatch_pixel_format(ImageFormat format, SdByteOrder order, Fn &&fn) {
+  switch (format) {
+    case ImageFormat::RGB888:
+      return fn(PixelTraits<ImageFormat::RGB888, false>{});
+    case ImageFormat::RGBA:
+      return fn(PixelTraits<ImageFormat::RGBA, false>{});
+    case ImageFormat::RGB565:
+    default:
+      if (order == SdByteOrder::BIG_ENDIAN_SD) {
+        return fn(PixelTraits<ImageFormat::RGB565, true>{});
+      }
+      return fn(PixelTraits<ImageFormat::RGB565, false>{});
+  }
+}
+
+// Per-pixel entry points of one instantiation, for callers that cannot hold
+// a loop (decoder callbacks delivering a single pixel)
+struct PixelOps {
+  size_t size;
+  void (*pack)(uint8_t *dst, uint8_t r, uint8_t g, uint8_t b, uint8_t a);
+  Color (*read)(const uint8_t *src);
+  void (*from_rgba_row)(const uint8_t *rgba, uint8_t *dst, int count);
+};
+
+const PixelOps &get_pixel_ops(ImageFormat format, SdByteOrder order);
+
+// =====================================================
+// Formats compacts - quantification pendant le décodage
+// =====================================================
+//
+// GRAYSCALE, BINARY and INDEXED8 are written by the Quantizer while the
+// decoder emits pixels, so a full RGB565 copy of the image never has to exist
+// (only the resize paths still work on RGB565 before the final pass). Layouts
+// follow image::Image: one byte per pixel, or for BINARY (width + 7) / 8 bytes
+// per row with the MSB first and a set bit for a dark pixel ("ink", drawn
+// with color_on).
+
+inline bool is_compact_format(ImageFormat format) {
+  return format == ImageFormat::GRAYSCALE || format == ImageFormat::BINARY || format == ImageFormat::INDEXED8;
+}
+
+const char *image_format_to_string(ImageFormat format);
+size_t image_row_bytes(ImageFormat format, int width);
+inline size_t image_buffer_bytes(ImageFormat format, int width, int height) {
+  return width > 0 && height > 0 ? image_row_bytes(format, width) * height : 0;
+}
+
+class Quantizer {
+ public:
+  void set_format(ImageFormat format) { this->format_ = format; }
+  // BINARY: tramage ordonné (Bayer 4x4) au lieu d'un seuil fixe à 50 %
+  void set_dither(bool dither) { this->dither_ = dither; }
+  // INDEXED8: couleurs 0xRRGGBB (256 au plus); palette vide = RGB332 fixe
+  void set_palette(const std::vector<uint32_t> &palette);
+
+  ImageFormat get_format() const { return this->format_; }
+  bool is_dither() const { return this->dither_; }
+  size_t get_palette_size() const { return this->custom_palette_ ? this->palette_.size() : 256; }
+
+  // Pixel x of the row starting at `row`; (x, y) also select the dither cell
+  void put(uint8_t *row, int x, int y, uint8_t r, uint8_t g, uint8_t b);
+  // Span of RGB565 pixels in display byte order (JPEGDEC/GIF output, resized buffers)
+  void put_row565(uint8_t *row, int x, int y, const uint8_t *src, int count, bool big_endian);
+
+  Color read(const uint8_t *row, int x) const;
+  // Entrée de palette en RGB565 (ordre CPU), pour le blit des images INDEXED8
+  uint16_t palette565(uint8_t index) const;
+
+ protected:
+  static inline uint8_t luma(uint8_t r, uint8_t g, uint8_t b) { return (77 * r + 150 * g + 29 * b) >> 8; }
+  inline void put_binary_(uint8_t *row, int x, int y, uint8_t gray) const;
+  uint8_t nearest_index_(uint8_t r, uint8_t g, uint8_t b);
+
+  ImageFormat format_{ImageFormat::GRAYSCALE};
+  bool dither_{false};
+  bool custom_palette_{false};
+  std::vector<uint32_t> palette_;
+  // Palette utilisateur: cache direct (RGB565 -> index) devant la recherche linéaire
+  std::vector<uint32_t> cache_;
+};
+
+}  // namespace storage
+}  // namespace esphome
@@ -0,0 +1,93 @@
+#include "png_rows.h"
+#include <cstring>
+
+namespace esphome {
+namespace storage {
+
+// Échantillon de `depth` bits (< 8) en position x, MSB en premier
+static inline uint8_t packed_sample(const uint8_t *pixels, int x, int depth) {
+  int bit = x * depth;
+  return (pixels[bit >> 3] >> (8 - depth - (bit & 7))) & ((1 << depth) - 1);
+}
+
+void png_row_to_rgba(const PngRowFormat &format, const uint8_t *pixels, int x0, int count, uint8_t *rgba) {
+  // 16 bits: octet de poids fort seulement (big endian dans le fichier)
+  int step = format.bit_depth == 16 ? 2 : 1;
+
+  switch (format.pixel_type) {
+    case PNG_TYPE_TRUECOLOR_ALPHA: {
+      const uint8_t *src = pixels + x0 * 4 * step;
+      if (step == 1) {
+        memcpy(rgba, src, count * 4);
+        return;
+      }
+      for (int i = 0; i < count; i++, src += 8, rgba += 4) {
+        rgba[0] = src[0];
+        rgba[1] = src[2];
+        rgba[2] = src[4];
+        rgba[3] = src[6];
+      }
+      return;
+    }
+    case PNG_TYPE_TRUECOLOR: {
+      const uint8_t *src = pixels + x0 * 3 * step;
+      for (int i = 0; i < count; i++, src += 3 * step, rgba += 4) {
+        rgba[0] = src[0];
+        rgba[1] = src[step];
+        rgba[2] = src[2 * step];
+        rgba[3] = 255;
+      }
+      return;
+    }
+    case PNG_TYPE_GRAY_ALPHA: {
+      const uint8_t *src = pixels + x0 * 2 * step;
+      for (int i = 0; i < count; i++, src += 2 * step, rgba += 4) {
+        rgba[0] = rgba[1] = rgba[2] = src[0];
+        rgba[3] = src[step];
+      }
+      return;
+    }
+    case PNG_TYPE_INDEXED: {
+      const uint8_t *palette = format.palette;
+      for (int i = 0; i < count; i++, rgba += 4) {
+        int x = x0 + i;
+        uint8_t index = format.bit_depth == 8 ? pixels[x] : packed_sample(pixels, x, format.bit_depth);
+        if (palette == nullptr) {
+          rgba[0] = rgba[1] = rgba[2] = index;
+          rgba[3] = 255;
+          continue;
+        }
+        memcpy(rgba, palette + index * 3, 3);
+        rgba[3] = format.palette_alpha ? palette[768 + index] : 255;
+      }
+      return;
+    }
+    case PNG_TYPE_GRAYSCALE:
+    default: {
+      if (format.bit_depth >= 8) {
+        const uint8_t *src = pixels + x0 * step;
+        for (int i = 0; i < count; i++, src += step, rgba += 4) {
+          rgba[0] = rgba[1] = rgba[2] = src[0];
+          rgba[3] = 255;
+        }
+        return;
+      }
+      // 1/2/4 bits étendus à 0..255
+      int max = (1 << format.bit_depth) - 1;
+      for (int i = 0; i < count; i++, rgba += 4) {
+        uint8_t gray = packed_sample(pixels, x0 + i, format.bit_depth) * 255 / max;
+        rgba[0] = rgba[1] = rgba[2] = gray;
+        rgba[3] = 255;
+      }
+      return;
+    }
+  }
+}
+
+bool png_is_interlaced(const uint8_t *data, size_t size) {
+  // Signature (8) + longueur/type du chunk (8) + IHDR: interlace en dernier octet
+  return size >= 29 && memcmp(data + 12, "IHDR", 4) == 0 && data[28] != 0;
+}
+
+}  // namespace storage
+}  // namespace esphome
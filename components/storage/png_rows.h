@@ -0,0 +1,39 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace esphome {
+namespace storage {
+
+// =====================================================
+// PNG rows - lignes défiltrées -> RGBA8888
+// =====================================================
+//
+// Row decoders (PNGdec) hand out one unfiltered row in the file's own pixel
+// format. This expands a span of it to RGBA8888 in one loop, so the storage
+// pipeline converts/resizes whole rows (rgba_to_rgb565, put_rgba_row_)
+// instead of taking one callback per pixel as with pngle.
+
+enum PngPixelType : uint8_t {
+  PNG_TYPE_GRAYSCALE = 0,
+  PNG_TYPE_TRUECOLOR = 2,
+  PNG_TYPE_INDEXED = 3,
+  PNG_TYPE_GRAY_ALPHA = 4,
+  PNG_TYPE_TRUECOLOR_ALPHA = 6,
+};
+
+struct PngRowFormat {
+  uint8_t pixel_type{PNG_TYPE_TRUECOLOR};
+  uint8_t bit_depth{8};            // bits par composante: 1, 2, 4, 8 ou 16
+  const uint8_t *palette{nullptr};  // INDEXED: 256 x RGB, puis 256 alphas si palette_alpha
+  bool palette_alpha{false};
+};
+
+// Pixels [x0, x0 + count) de la ligne -> rgba (count * 4 octets)
+void png_row_to_rgba(const PngRowFormat &format, const uint8_t *pixels, int x0, int count, uint8_t *rgba);
+
+// Octet d'entrelacement de l'IHDR (Adam7); data = début du fichier
+bool png_is_interlaced(const uint8_t *data, size_t size);
+
+}  // namespace storage
+}  // namespace esphome
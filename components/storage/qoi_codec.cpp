@@ -0,0 +1,278 @@
+#include "qoi_codec.h"
+#include "load_stats.h"
+#include "esphome/core/hal.h"
+#include <cstring>
+
+namespace esphome {
+namespace storage {
+
+static const uint8_t QOI_OP_INDEX = 0x00;
+static const uint8_t QOI_OP_DIFF = 0x40;
+static const uint8_t QOI_OP_LUMA = 0x80;
+static const uint8_t QOI_OP_RUN = 0xC0;
+static const uint8_t QOI_OP_RGB = 0xFE;
+static const uint8_t QOI_OP_RGBA = 0xFF;
+static const uint8_t QOI_MASK_2 = 0xC0;
+static const int QOI_MAX_RUN = 62;
+// Limite de la spécification (400 Mpixels); l'ESP32 refuse bien avant
+static const uint32_t QOI_PIXELS_MAX = 400000000;
+
+static inline int qoi_hash(const uint8_t px[4]) { return (px[0] * 3 + px[1] * 5 + px[2] * 7 + px[3] * 11) & 63; }
+
+static inline uint32_t read_be32(const uint8_t *p) {
+  return ((uint32_t) p[0] << 24) | ((uint32_t) p[1] << 16) | ((uint32_t) p[2] << 8) | p[3];
+}
+
+bool is_qoi_data(const uint8_t *data, size_t size) {
+  return size >= QOI_HEADER_SIZE && memcmp(data, "qoif", 4) == 0;
+}
+
+bool qoi_read_header(const uint8_t *data, size_t size, QoiHeader &header) {
+  if (!is_qoi_data(data, size)) {
+    return false;
+  }
+  header.width = read_be32(data + 4);
+  header.height = read_be32(data + 8);
+  header.channels = data[12];
+  header.colorspace = data[13];
+  return header.width > 0 && header.height > 0 && (header.channels == 3 || header.channels == 4) &&
+         header.colorspace <= 1 && header.height < QOI_PIXELS_MAX / header.width;
+}
+
+// =====================================================
+// QoiDecoder
+// =====================================================
+
+bool QoiDecoder::begin(const uint8_t *data, size_t size) {
+  this->file_ = nullptr;
+  if (!qoi_read_header(data, size, this->header_)) {
+    return false;
+  }
+  this->pos_ = data + QOI_HEADER_SIZE;
+  this->end_ = data + size;
+  return this->reset_();
+}
+
+bool QoiDecoder::begin(FILE *file) {
+  uint8_t head[QOI_HEADER_SIZE];
+  this->file_ = nullptr;
+  if (file == nullptr || fread(head, 1, sizeof(head), file) != sizeof(head) ||
+      !qoi_read_header(head, sizeof(head), this->header_)) {
+    return false;
+  }
+  this->file_ = file;
+  this->pos_ = this->end_ = this->buffer_;
+  return this->reset_();
+}
+
+bool QoiDecoder::reset_() {
+  memset(this->index_, 0, sizeof(this->index_));
+  this->px_[0] = this->px_[1] = this->px_[2] = 0;
+  this->px_[3] = 255;
+  this->run_ = 0;
+  this->row_ = 0;
+  return true;
+}
+
+bool QoiDecoder::refill_() {
+  if (this->file_ == nullptr) {
+    return false;
+  }
+  uint32_t start = micros();
+  size_t n = fread(this->buffer_, 1, sizeof(this->buffer_), this->file_);
+  note_load_read(n, micros() - start);
+  this->pos_ = this->buffer_;
+  this->end_ = this->buffer_ + n;
+  return n > 0;
+}
+
+bool QoiDecoder::decode_row(uint8_t *rgba) {
+  if (this->row_ >= (int) this->header_.height) {
+    return false;
+  }
+
+  uint8_t *px = this->px_;
+  for (uint32_t x = 0; x < this->header_.width; x++, rgba += 4) {
+    // Un run continue d'une ligne à l'autre
+    if (this->run_ > 0) {
+      this->run_--;
+    } else {
+      uint8_t op;
+      if (!this->next_(op)) {
+        return false;
+      }
+      if (op == QOI_OP_RGB || op == QOI_OP_RGBA) {
+        for (int c = 0; c < (op == QOI_OP_RGBA ? 4 : 3); c++) {
+          if (!this->next_(px[c])) {
+            return false;
+          }
+        }
+      } else {
+        switch (op & QOI_MASK_2) {
+          case QOI_OP_INDEX:
+            memcpy(px, this->index_[op], 4);
+            break;
+          case QOI_OP_DIFF:
+            px[0] += ((op >> 4) & 3) - 2;
+            px[1] += ((op >> 2) & 3) - 2;
+            px[2] += (op & 3) - 2;
+            break;
+          case QOI_OP_LUMA: {
+            uint8_t second;
+            if (!this->next_(second)) {
+              return false;
+            }
+            int dg = (op & 0x3F) - 32;
+            px[0] += dg - 8 + ((second >> 4) & 0x0F);
+            px[1] += dg;
+            px[2] += dg - 8 + (second & 0x0F);
+            break;
+          }
+          case QOI_OP_RUN:
+          default:
+            this->run_ = op & 0x3F;
+            break;
+        }
+      }
+      memcpy(this->index_[qoi_hash(px)], px, 4);
+    }
+    memcpy(rgba, px, 4);
+  }
+  this->row_++;
+  return true;
+}
+
+bool QoiDecoder::skip_rows(int count, uint8_t *scratch_rgba) {
+  for (int i = 0; i < count; i++) {
+    if (!this->decode_row(scratch_rgba)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// =====================================================
+// QoiEncoder
+// =====================================================
+
+bool QoiEncoder::begin(uint32_t width, uint32_t height, uint8_t channels, WriteFn write) {
+  if (width == 0 || height == 0 || (channels != 3 && channels != 4) || height >= QOI_PIXELS_MAX / width) {
+    return false;
+  }
+  this->write_ = std::move(write);
+  this->width_ = width;
+  this->channels_ = channels;
+  this->length_ = 0;
+  this->written_ = 0;
+  this->ok_ = true;
+  memset(this->index_, 0, sizeof(this->index_));
+  this->prev_[0] = this->prev_[1] = this->prev_[2] = 0;
+  this->prev_[3] = 255;
+  this->run_ = 0;
+
+  uint8_t head[QOI_HEADER_SIZE] = {'q', 'o', 'i', 'f'};
+  for (int i = 0; i < 4; i++) {
+    head[4 + i] = width >> (24 - 8 * i);
+    head[8 + i] = height >> (24 - 8 * i);
+  }
+  head[12] = channels;
+  head[13] = 0;
+  for (uint8_t byte : head) {
+    this->emit_(byte);
+  }
+  return true;
+}
+
+void QoiEncoder::flush_() {
+  if (this->length_ > 0 && this->ok_) {
+    this->ok_ = this->write_(this->out_, this->length_);
+    this->written_ += this->length_;
+  }
+  this->length_ = 0;
+}
+
+inline void QoiEncoder::push_pixel_(const uint8_t px[4]) {
+  if (memcmp(px, this->prev_, 4) == 0) {
+    if (++this->run_ == QOI_MAX_RUN) {
+      this->emit_(QOI_OP_RUN | (this->run_ - 1));
+      this->run_ = 0;
+    }
+    return;
+  }
+  if (this->run_ > 0) {
+    this->emit_(QOI_OP_RUN | (this->run_ - 1));
+    this->run_ = 0;
+  }
+
+  int hash = qoi_hash(px);
+  if (memcmp(this->index_[hash], px, 4) == 0) {
+    this->emit_(QOI_OP_INDEX | hash);
+  } else {
+    memcpy(this->index_[hash], px, 4);
+    if (px[3] == this->prev_[3]) {
+      int8_t dr = px[0] - this->prev_[0];
+      int8_t dg = px[1] - this->prev_[1];
+      int8_t db = px[2] - this->prev_[2];
+      int8_t dr_dg = dr - dg;
+      int8_t db_dg = db - dg;
+      if (dr > -3 && dr < 2 && dg > -3 && dg < 2 && db > -3 && db < 2) {
+        this->emit_(QOI_OP_DIFF | ((dr + 2) << 4) | ((dg + 2) << 2) | (db + 2));
+      } else if (dr_dg > -9 && dr_dg < 8 && dg > -33 && dg < 32 && db_dg > -9 && db_dg < 8) {
+        this->emit_(QOI_OP_LUMA | (dg + 32));
+        this->emit_(((dr_dg + 8) << 4) | (db_dg + 8));
+      } else {
+        this->emit_(QOI_OP_RGB);
+        this->emit_(px[0]);
+        this->emit_(px[1]);
+        this->emit_(px[2]);
+      }
+    } else {
+      this->emit_(QOI_OP_RGBA);
+      for (int c = 0; c < 4; c++) {
+        this->emit_(px[c]);
+      }
+    }
+  }
+  memcpy(this->prev_, px, 4);
+}
+
+bool QoiEncoder::write_row_rgba(const uint8_t *rgba) {
+  uint8_t px[4];
+  for (uint32_t x = 0; x < this->width_; x++, rgba += 4) {
+    memcpy(px, rgba, 4);
+    if (this->channels_ == 3) {
+      px[3] = 255;
+    }
+    this->push_pixel_(px);
+  }
+  return this->ok_;
+}
+
+bool QoiEncoder::write_row_rgb565(const uint8_t *src, bool big_endian) {
+  uint8_t px[4] = {0, 0, 0, 255};
+  for (uint32_t x = 0; x < this->width_; x++, src += 2) {
+    uint16_t v = big_endian ? (src[0] << 8) | src[1] : src[0] | (src[1] << 8);
+    // Bits hauts répliqués: le blanc reste 255
+    px[0] = ((v >> 8) & 0xF8) | (v >> 13);
+    px[1] = ((v >> 3) & 0xFC) | ((v >> 9) & 0x03);
+    px[2] = ((v << 3) & 0xF8) | ((v >> 2) & 0x07);
+    this->push_pixel_(px);
+  }
+  return this->ok_;
+}
+
+bool QoiEncoder::finish() {
+  if (this->run_ > 0) {
+    this->emit_(QOI_OP_RUN | (this->run_ - 1));
+    this->run_ = 0;
+  }
+  static const uint8_t END_MARKER[QOI_END_MARKER_SIZE] = {0, 0, 0, 0, 0, 0, 0, 1};
+  for (uint8_t byte : END_MARKER) {
+    this->emit_(byte);
+  }
+  this->flush_();
+  return this->ok_;
+}
+
+}  // namespace storage
+}  // namespace esphome
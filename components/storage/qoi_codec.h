@@ -0,0 +1,104 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+
+namespace esphome {
+namespace storage {
+
+// =====================================================
+// QOI - fichiers "Quite OK Image" (qoiformat.org)
+// =====================================================
+//
+// Lossless like PNG, but a single linear pass with no inflate window and no
+// filters: each pixel costs one or two bytes of input and a table lookup.
+// The decoder hands out one RGBA8888 row at a time, from memory or straight
+// from a FILE* through a small read buffer, so callers convert/resize/clip a
+// row and never hold the whole RGBA image. The encoder is streaming too
+// (rows in, chunks out through a write callback) for caches and screenshots.
+
+static const size_t QOI_HEADER_SIZE = 14;
+static const size_t QOI_END_MARKER_SIZE = 8;
+
+struct QoiHeader {
+  uint32_t width{0};
+  uint32_t height{0};
+  uint8_t channels{4};    // 3 = RGB, 4 = RGBA
+  uint8_t colorspace{0};  // 0 = sRGB, 1 = linéaire (informatif)
+};
+
+bool is_qoi_data(const uint8_t *data, size_t size);
+bool qoi_read_header(const uint8_t *data, size_t size, QoiHeader &header);
+
+class QoiDecoder {
+ public:
+  // Source en mémoire (fichier déjà lu) ou FILE* positionné au début
+  bool begin(const uint8_t *data, size_t size);
+  bool begin(FILE *file);
+
+  const QoiHeader &get_header() const { return this->header_; }
+  int get_row() const { return this->row_; }
+  // Next row as RGBA8888 (width * 4 bytes); false at the end or on truncated data
+  bool decode_row(uint8_t *rgba);
+  // Lignes décodées et ignorées (viewport sous le haut de l'image)
+  bool skip_rows(int count, uint8_t *scratch_rgba);
+
+ protected:
+  bool reset_();
+  bool refill_();
+  inline bool next_(uint8_t &byte) {
+    if (this->pos_ == this->end_ && !this->refill_()) {
+      return false;
+    }
+    byte = *this->pos_++;
+    return true;
+  }
+
+  QoiHeader header_;
+  const uint8_t *pos_{nullptr};
+  const uint8_t *end_{nullptr};
+  FILE *file_{nullptr};
+  uint8_t buffer_[512];
+  uint8_t index_[64][4];
+  uint8_t px_[4];
+  int run_{0};
+  int row_{0};
+};
+
+class QoiEncoder {
+ public:
+  using WriteFn = std::function<bool(const uint8_t *data, size_t len)>;
+
+  bool begin(uint32_t width, uint32_t height, uint8_t channels, WriteFn write);
+  // Exactly `width` pixels per call, `height` calls before finish()
+  bool write_row_rgba(const uint8_t *rgba);
+  bool write_row_rgb565(const uint8_t *src, bool big_endian);
+  // Run en cours + marqueur de fin; false si une écriture a échoué
+  bool finish();
+  size_t get_bytes_written() const { return this->written_; }
+
+ protected:
+  inline void push_pixel_(const uint8_t px[4]);
+  inline void emit_(uint8_t byte) {
+    if (this->length_ == sizeof(this->out_)) {
+      this->flush_();
+    }
+    this->out_[this->length_++] = byte;
+  }
+  void flush_();
+
+  WriteFn write_;
+  uint32_t width_{0};
+  uint8_t channels_{4};
+  uint8_t out_[512];
+  size_t length_{0};
+  size_t written_{0};
+  bool ok_{false};
+  uint8_t index_[64][4];
+  uint8_t prev_[4];
+  int run_{0};
+};
+
+}  // namespace storage
+}  // namespace esphome
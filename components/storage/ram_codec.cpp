@@ -0,0 +1,249 @@
+#include "ram_codec.h"
+#include <algorithm>
+#include <cstring>
+
+namespace esphome {
+namespace storage {
+
+static const int RLE_MAX_PACKET = 128;
+
+static const uint8_t QOI_OP_INDEX = 0x00;
+static const uint8_t QOI_OP_DIFF = 0x40;
+static const uint8_t QOI_OP_LUMA = 0x80;
+static const uint8_t QOI_OP_RUN = 0xC0;
+static const uint8_t QOI_OP_RAW = 0xFE;
+static const uint8_t QOI_MASK_2 = 0xC0;
+static const int QOI_MAX_RUN = 62;
+
+const char *ram_compression_to_string(RamCompression compression) {
+  switch (compression) {
+    case RamCompression::RLE: return "RLE";
+    case RamCompression::QOI: return "QOI";
+    case RamCompression::NONE:
+    default: return "NONE";
+  }
+}
+
+static inline uint16_t load565(const uint8_t *p, bool big_endian) {
+  return big_endian ? (p[0] << 8) | p[1] : p[0] | (p[1] << 8);
+}
+
+static inline void store565(uint8_t *p, uint16_t v, bool big_endian) {
+  p[big_endian ? 0 : 1] = v >> 8;
+  p[big_endian ? 1 : 0] = v & 0xFF;
+}
+
+static inline int qoi_hash(uint16_t v) {
+  return (((v >> 11) & 0x1F) * 3 + ((v >> 5) & 0x3F) * 5 + (v & 0x1F) * 7) & 63;
+}
+
+// =====================================================
+// RLE
+// =====================================================
+
+static void rle_encode_row(const uint8_t *src, int width, std::vector<uint8_t> &out) {
+  int x = 0;
+  while (x < width) {
+    // Run: au moins 2 pixels identiques
+    int run = 1;
+    while (x + run < width && run < RLE_MAX_PACKET && memcmp(src + (x + run) * 2, src + x * 2, 2) == 0) {
+      run++;
+    }
+    if (run > 1) {
+      out.push_back(0x80 | (run - 1));
+      out.push_back(src[x * 2]);
+      out.push_back(src[x * 2 + 1]);
+      x += run;
+      continue;
+    }
+
+    // Littéraux jusqu'au prochain run de 2
+    int start = x;
+    int count = 0;
+    while (x < width && count < RLE_MAX_PACKET &&
+           !(x + 1 < width && memcmp(src + x * 2, src + (x + 1) * 2, 2) == 0)) {
+      x++;
+      count++;
+    }
+    if (count == 0) {
+      continue;
+    }
+    out.push_back(count - 1);
+    out.insert(out.end(), src + start * 2, src + (start + count) * 2);
+  }
+}
+
+static void rle_decode_row(const uint8_t *src, int width, uint8_t *dst) {
+  uint8_t *end = dst + width * 2;
+  while (dst < end) {
+    uint8_t header = *src++;
+    int count = (header & 0x7F) + 1;
+    if (dst + count * 2 > end) {
+      count = (end - dst) / 2;
+    }
+    if (header & 0x80) {
+      // Aplat: rempli par mots de 16 bits
+      uint16_t pixel;
+      memcpy(&pixel, src, 2);
+      src += 2;
+      uint16_t *fill = reinterpret_cast<uint16_t *>(dst);
+      for (int i = 0; i < count; i++) {
+        fill[i] = pixel;
+      }
+    } else {
+      memcpy(dst, src, count * 2);
+      src += count * 2;
+    }
+    dst += count * 2;
+  }
+}
+
+// =====================================================
+// QOI (composantes RGB565, état remis à zéro à chaque ligne)
+// =====================================================
+
+static void qoi_encode_row(const uint8_t *src, int width, bool big_endian, std::vector<uint8_t> &out) {
+  uint16_t index[64] = {0};
+  uint16_t prev = 0;
+  int run = 0;
+
+  for (int x = 0; x < width; x++) {
+    uint16_t v = load565(src + x * 2, big_endian);
+    if (v == prev) {
+      run++;
+      if (run == QOI_MAX_RUN || x == width - 1) {
+        out.push_back(QOI_OP_RUN | (run - 1));
+        run = 0;
+      }
+      continue;
+    }
+    if (run > 0) {
+      out.push_back(QOI_OP_RUN | (run - 1));
+      run = 0;
+    }
+
+    int hash = qoi_hash(v);
+    if (index[hash] == v) {
+      out.push_back(QOI_OP_INDEX | hash);
+    } else {
+      index[hash] = v;
+      int dr = (int) ((v >> 11) & 0x1F) - (int) ((prev >> 11) & 0x1F);
+      int dg = (int) ((v >> 5) & 0x3F) - (int) ((prev >> 5) & 0x3F);
+      int db = (int) (v & 0x1F) - (int) (prev & 0x1F);
+      int dr_dg = dr - dg;
+      int db_dg = db - dg;
+      if (dr >= -2 && dr <= 1 && dg >= -2 && dg <= 1 && db >= -2 && db <= 1) {
+        out.push_back(QOI_OP_DIFF | ((dr + 2) << 4) | ((dg + 2) << 2) | (db + 2));
+      } else if (dg >= -32 && dg <= 31 && dr_dg >= -8 && dr_dg <= 7 && db_dg >= -8 && db_dg <= 7) {
+        out.push_back(QOI_OP_LUMA | (dg + 32));
+        out.push_back(((dr_dg + 8) << 4) | (db_dg + 8));
+      } else {
+        out.push_back(QOI_OP_RAW);
+        out.push_back(src[x * 2]);
+        out.push_back(src[x * 2 + 1]);
+      }
+    }
+    prev = v;
+  }
+}
+
+static void qoi_decode_row(const uint8_t *src, int width, bool big_endian, uint8_t *dst) {
+  uint16_t index[64] = {0};
+  uint16_t prev = 0;
+  int x = 0;
+
+  while (x < width) {
+    uint8_t op = *src++;
+    if (op == QOI_OP_RAW) {
+      memcpy(dst + x * 2, src, 2);
+      src += 2;
+      prev = load565(dst + x * 2, big_endian);
+      index[qoi_hash(prev)] = prev;
+      x++;
+      continue;
+    }
+
+    switch (op & QOI_MASK_2) {
+      case QOI_OP_RUN: {
+        int run = std::min<int>((op & 0x3F) + 1, width - x);
+        for (int i = 0; i < run; i++, x++) {
+          store565(dst + x * 2, prev, big_endian);
+        }
+        continue;
+      }
+      case QOI_OP_INDEX:
+        prev = index[op & 0x3F];
+        break;
+      case QOI_OP_DIFF: {
+        int r = ((prev >> 11) & 0x1F) + ((op >> 4) & 3) - 2;
+        int g = ((prev >> 5) & 0x3F) + ((op >> 2) & 3) - 2;
+        int b = (prev & 0x1F) + (op & 3) - 2;
+        prev = ((r & 0x1F) << 11) | ((g & 0x3F) << 5) | (b & 0x1F);
+        index[qoi_hash(prev)] = prev;
+        break;
+      }
+      case QOI_OP_LUMA:
+      default: {
+        uint8_t second = *src++;
+        int dg = (op & 0x3F) - 32;
+        int r = ((prev >> 11) & 0x1F) + dg + ((second >> 4) & 0x0F) - 8;
+        int g = ((prev >> 5) & 0x3F) + dg;
+        int b = (prev & 0x1F) + dg + (second & 0x0F) - 8;
+        prev = ((r & 0x1F) << 11) | ((g & 0x3F) << 5) | (b & 0x1F);
+        index[qoi_hash(prev)] = prev;
+        break;
+      }
+    }
+    store565(dst + x * 2, prev, big_endian);
+    x++;
+  }
+}
+
+size_t ram_encode_row(RamCompression compression, const uint8_t *src, int width, bool big_endian,
+                      std::vector<uint8_t> &out) {
+  size_t before = out.size();
+  switch (compression) {
+    case RamCompression::RLE:
+      rle_encode_row(src, width, out);
+      break;
+    case RamCompression::QOI:
+      qoi_encode_row(src, width, big_endian, out);
+      break;
+    case RamCompression::NONE:
+    default:
+      out.insert(out.end(), src, src + width * 2);
+      break;
+  }
+  return out.size() - before;
+}
+
+void ram_decode_row(RamCompression compression, const uint8_t *src, int width, bool big_endian, uint8_t *dst) {
+  switch (compression) {
+    case RamCompression::RLE:
+      rle_decode_row(src, width, dst);
+      break;
+    case RamCompression::QOI:
+      qoi_decode_row(src, width, big_endian, dst);
+      break;
+    case RamCompression::NONE:
+    default:
+      memcpy(dst, src, width * 2);
+      break;
+  }
+}
+
+void ram_encode_image(RamCompression compression, const uint8_t *src, int width, int height, bool big_endian,
+                      std::vector<uint8_t> &out) {
+  out.assign(ram_table_bytes(height), 0);
+  std::vector<uint32_t> offsets(height + 1, 0);
+  size_t rows_start = out.size();
+  for (int y = 0; y < height; y++) {
+    offsets[y] = out.size() - rows_start;
+    ram_encode_row(compression, src + y * width * 2, width, big_endian, out);
+  }
+  offsets[height] = out.size() - rows_start;
+  memcpy(out.data(), offsets.data(), ram_table_bytes(height));
+}
+
+}  // namespace storage
+}  // namespace esphome
@@ -0,0 +1,59 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace esphome {
+namespace storage {
+
+// =====================================================
+// RAM codec - image RGB565 compressée en mémoire
+// =====================================================
+//
+// A decoded RGB565 image can be kept compressed in its ImageBuffer and
+// expanded one row at a time when drawn. Every row is encoded on its own, so
+// any row (clipping, get_pixel_color) is reached without touching the rows
+// above it. Buffer layout:
+//
+//   uint32_t row_offsets[height + 1]   relative to the first row, last = end
+//   encoded rows
+//
+// RLE: packets of a header byte then pixels, 0x80 | (n - 1) = n copies of the
+// next pixel, (n - 1) = n literal pixels; n <= 128. Pixels are stored as raw
+// bytes, so the codec does not care about the byte order.
+//
+// QOI: the QOI ops (INDEX, DIFF, LUMA, RUN, raw pixel) applied to the 5/6/5
+// bit components, with the state (previous pixel, 64-entry index) reset at
+// every row. A raw pixel is 0xFE followed by the 2 RGB565 bytes. Better than
+// RLE on gradients and anti-aliased edges, a little slower to expand.
+
+enum class RamCompression : uint8_t {
+  NONE,
+  RLE,
+  QOI,
+};
+
+const char *ram_compression_to_string(RamCompression compression);
+
+// Appends the encoded row to out; returns the encoded size
+size_t ram_encode_row(RamCompression compression, const uint8_t *src, int width, bool big_endian,
+                      std::vector<uint8_t> &out);
+// Expands one encoded row of `width` pixels into dst (width * 2 bytes)
+void ram_decode_row(RamCompression compression, const uint8_t *src, int width, bool big_endian, uint8_t *dst);
+
+// Whole image: row table + rows, ready to be copied into an ImageBuffer
+void ram_encode_image(RamCompression compression, const uint8_t *src, int width, int height, bool big_endian,
+                      std::vector<uint8_t> &out);
+
+inline size_t ram_table_bytes(int height) { return (height + 1) * sizeof(uint32_t); }
+// Encoded bytes of a row inside a buffer laid out by ram_encode_image
+inline const uint8_t *ram_row(const uint8_t *buffer, int height, int y, size_t *length = nullptr) {
+  const uint32_t *offsets = reinterpret_cast<const uint32_t *>(buffer);
+  if (length != nullptr) {
+    *length = offsets[y + 1] - offsets[y];
+  }
+  return buffer + ram_table_bytes(height) + offsets[y];
+}
+
+}  // namespace storage
+}  // namespace esphome
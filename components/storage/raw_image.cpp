@@ -0,0 +1,244 @@
+#include "raw_image.h"
+#include <cstring>
+
+namespace esphome {
+namespace storage {
+
+static const uint32_t BMP_BI_RGB = 0;
+static const uint32_t BMP_BI_BITFIELDS = 3;
+static const uint32_t BMP_BI_ALPHABITFIELDS = 6;
+static const uint32_t BMP_FILE_HEADER_SIZE = 14;
+
+static const uint8_t LV_IMG_CF_TRUE_COLOR = 4;
+static const uint8_t LV_IMG_CF_TRUE_COLOR_ALPHA = 5;
+static const uint32_t LV_IMG_HEADER_SIZE = 4;
+
+// Au-delà, le buffer ne tiendrait de toute façon pas en RAM
+static const int RAW_MAX_DIMENSION = 8192;
+
+static inline uint16_t read_le16(const uint8_t *p) { return p[0] | (p[1] << 8); }
+static inline uint32_t read_le32(const uint8_t *p) {
+  return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t) p[3] << 24);
+}
+
+size_t raw_pixel_size(RawPixels pixels) {
+  switch (pixels) {
+    case RawPixels::RGB565_LE:
+      return 2;
+    case RawPixels::RGB888:
+    case RawPixels::BGR888:
+      return 3;
+    case RawPixels::RGBA8888:
+    case RawPixels::BGRA8888:
+    case RawPixels::BGRX8888:
+    default:
+      return 4;
+  }
+}
+
+static bool layout_fits(const RawLayout &layout, uint32_t file_size) {
+  if (layout.width <= 0 || layout.height <= 0 || layout.width > RAW_MAX_DIMENSION ||
+      layout.height > RAW_MAX_DIMENSION) {
+    return false;
+  }
+  // La dernière ligne n'a pas besoin de son bourrage
+  uint64_t end = (uint64_t) layout.data_offset + (uint64_t) (layout.height - 1) * layout.stride +
+                 layout.width * raw_pixel_size(layout.pixels);
+  return end <= file_size;
+}
+
+// =====================================================
+// BMP
+// =====================================================
+
+bool is_bmp_data(const uint8_t *data, size_t size) {
+  // "BM" puis une taille d'en-tête DIB connue (40 = BITMAPINFOHEADER, 52/56 = V2/V3, 108 = V4, 124 = V5)
+  if (size < BMP_FILE_HEADER_SIZE + 4 || data[0] != 'B' || data[1] != 'M') {
+    return false;
+  }
+  uint32_t dib_size = read_le32(data + 14);
+  return dib_size == 40 || dib_size == 52 || dib_size == 56 || dib_size == 108 || dib_size == 124;
+}
+
+bool bmp_read_layout(const uint8_t *head, size_t head_size, uint32_t file_size, RawLayout &layout) {
+  if (head_size < 54 || !is_bmp_data(head, head_size)) {
+    return false;
+  }
+  uint32_t dib_size = read_le32(head + 14);
+  int32_t width = (int32_t) read_le32(head + 18);
+  int32_t height = (int32_t) read_le32(head + 22);
+  uint16_t planes = read_le16(head + 26);
+  uint16_t bpp = read_le16(head + 28);
+  uint32_t compression = read_le32(head + 30);
+  if (planes != 1 || width <= 0 || height == 0) {
+    return false;
+  }
+
+  layout = RawLayout();
+  layout.width = width;
+  layout.height = height < 0 ? -height : height;
+  layout.bottom_up = height > 0;
+  layout.data_offset = read_le32(head + 10);
+
+  // Masques juste après BITMAPINFOHEADER, ou dans l'en-tête V4/V5: même position
+  bool has_masks = compression == BMP_BI_BITFIELDS || compression == BMP_BI_ALPHABITFIELDS;
+  bool has_alpha_mask = compression == BMP_BI_ALPHABITFIELDS || dib_size >= 56;
+  if (has_masks && head_size < (has_alpha_mask ? 70u : 66u)) {
+    return false;
+  }
+  uint32_t red = has_masks ? read_le32(head + 54) : 0;
+  uint32_t green = has_masks ? read_le32(head + 58) : 0;
+  uint32_t blue = has_masks ? read_le32(head + 62) : 0;
+  uint32_t alpha = has_masks && has_alpha_mask ? read_le32(head + 66) : 0;
+
+  if (bpp == 16 && has_masks && red == 0xF800 && green == 0x07E0 && blue == 0x001F) {
+    layout.pixels = RawPixels::RGB565_LE;
+  } else if (bpp == 24 && compression == BMP_BI_RGB) {
+    layout.pixels = RawPixels::BGR888;
+  } else if (bpp == 32 && compression == BMP_BI_RGB) {
+    layout.pixels = RawPixels::BGRX8888;
+  } else if (bpp == 32 && has_masks && red == 0x00FF0000 && green == 0x0000FF00 && blue == 0x000000FF) {
+    layout.pixels = alpha == 0xFF000000 ? RawPixels::BGRA8888 : RawPixels::BGRX8888;
+  } else {
+    // Palettes, RLE, 555: pas de lecture directe possible
+    return false;
+  }
+
+  layout.stride = (layout.width * bpp / 8 + 3) & ~3u;
+  return layout_fits(layout, file_size);
+}
+
+// =====================================================
+// Raw sans en-tête / LVGL .bin
+// =====================================================
+
+bool raw_layout_from_size(int width, int height, uint32_t file_size, RawLayout &layout) {
+  if (width <= 0 || height <= 0) {
+    return false;
+  }
+  uint32_t pixels = (uint32_t) width * height;
+  // En-tête LVGL de 4 octets toléré devant les pixels
+  static const uint32_t OFFSETS[2] = {0, LV_IMG_HEADER_SIZE};
+  for (uint32_t offset : OFFSETS) {
+    if (file_size < offset) {
+      continue;
+    }
+    uint32_t size = file_size - offset;
+    layout = RawLayout();
+    layout.width = width;
+    layout.height = height;
+    layout.data_offset = offset;
+    if (size == pixels * 2) {
+      layout.pixels = RawPixels::RGB565_LE;
+    } else if (size == pixels * 3) {
+      layout.pixels = RawPixels::RGB888;
+    } else if (size == pixels * 4) {
+      layout.pixels = offset == 0 ? RawPixels::RGBA8888 : RawPixels::BGRA8888;
+    } else {
+      continue;
+    }
+    layout.stride = width * raw_pixel_size(layout.pixels);
+    return true;
+  }
+  return false;
+}
+
+bool lvgl_bin_read_layout(const uint8_t *head, size_t head_size, uint32_t file_size, RawLayout &layout) {
+  if (head_size < LV_IMG_HEADER_SIZE) {
+    return false;
+  }
+  // lv_img_header_t (LVGL 8): cf:5, always_zero:3, reserved:2, w:11, h:11
+  uint32_t header = read_le32(head);
+  uint8_t cf = header & 0x1F;
+  int width = (header >> 10) & 0x7FF;
+  int height = (header >> 21) & 0x7FF;
+  if (((header >> 5) & 0x07) != 0 || (cf != LV_IMG_CF_TRUE_COLOR && cf != LV_IMG_CF_TRUE_COLOR_ALPHA)) {
+    return false;
+  }
+  if (width == 0 || height == 0 || file_size < LV_IMG_HEADER_SIZE) {
+    return false;
+  }
+
+  // Profondeur de couleur LVGL déduite de la taille des données
+  uint32_t size = file_size - LV_IMG_HEADER_SIZE;
+  uint32_t pixels = (uint32_t) width * height;
+  layout = RawLayout();
+  layout.width = width;
+  layout.height = height;
+  layout.data_offset = LV_IMG_HEADER_SIZE;
+  if (cf == LV_IMG_CF_TRUE_COLOR && size == pixels * 2) {
+    layout.pixels = RawPixels::RGB565_LE;
+  } else if (size == pixels * 4) {
+    layout.pixels = cf == LV_IMG_CF_TRUE_COLOR ? RawPixels::BGRX8888 : RawPixels::BGRA8888;
+  } else {
+    return false;  // RGB565 + alpha 8 bits: pas de lecture directe
+  }
+  layout.stride = width * raw_pixel_size(layout.pixels);
+  return true;
+}
+
+// =====================================================
+// Conversion de lignes
+// =====================================================
+
+void raw_row_to_rgba(RawPixels pixels, const uint8_t *src, uint8_t *rgba, int count) {
+  for (int x = 0; x < count; x++, rgba += 4) {
+    switch (pixels) {
+      case RawPixels::RGB565_LE: {
+        // Bits hauts répliqués: le blanc reste 255
+        uint16_t v = read_le16(src);
+        rgba[0] = ((v >> 8) & 0xF8) | (v >> 13);
+        rgba[1] = ((v >> 3) & 0xFC) | ((v >> 9) & 0x03);
+        rgba[2] = ((v << 3) & 0xF8) | ((v >> 2) & 0x07);
+        rgba[3] = 255;
+        src += 2;
+        break;
+      }
+      case RawPixels::RGB888:
+        rgba[0] = src[0];
+        rgba[1] = src[1];
+        rgba[2] = src[2];
+        rgba[3] = 255;
+        src += 3;
+        break;
+      case RawPixels::BGR888:
+        rgba[0] = src[2];
+        rgba[1] = src[1];
+        rgba[2] = src[0];
+        rgba[3] = 255;
+        src += 3;
+        break;
+      case RawPixels::RGBA8888:
+        memcpy(rgba, src, 4);
+        src += 4;
+        break;
+      case RawPixels::BGRA8888:
+      case RawPixels::BGRX8888:
+      default:
+        rgba[0] = src[2];
+        rgba[1] = src[1];
+        rgba[2] = src[0];
+        rgba[3] = pixels == RawPixels::BGRA8888 ? src[3] : 255;
+        src += 4;
+        break;
+    }
+  }
+}
+
+void raw_swap_red_blue(RawPixels pixels, uint8_t *row, int count) {
+  size_t size = raw_pixel_size(pixels);
+  if (pixels != RawPixels::BGR888 && pixels != RawPixels::BGRA8888 && pixels != RawPixels::BGRX8888) {
+    return;
+  }
+  for (int x = 0; x < count; x++, row += size) {
+    uint8_t blue = row[0];
+    row[0] = row[2];
+    row[2] = blue;
+    if (pixels == RawPixels::BGRX8888) {
+      row[3] = 255;
+    }
+  }
+}
+
+}  // namespace storage
+}  // namespace esphome
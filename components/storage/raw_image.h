@@ -0,0 +1,65 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace esphome {
+namespace storage {
+
+// =====================================================
+// Raw / BMP - pixels non compressés
+// =====================================================
+//
+// Nothing to decode: the file is a pixel array at a known offset, so rows are
+// read straight into the image buffer and at most fixed up in place (RGB565
+// byte swap, BGR -> RGB, bottom-up BMP rows read into their final position).
+// RawLayout says where row y starts in the file and how its pixels are stored.
+//
+// Sources:
+//   BMP  - BITMAPINFOHEADER and later, uncompressed 24/32 bpp (BI_RGB), or
+//          16 bpp RGB565 / 32 bpp with masks (BI_BITFIELDS, BI_ALPHABITFIELDS)
+//   raw  - no header, dimensions from the configuration; the pixel layout
+//          follows the file size (w*h*2 RGB565 LE, w*h*3 RGB888, w*h*4 RGBA)
+//   LVGL - .bin from the LVGL image converter: 4-byte lv_img_header_t, true
+//          color (RGB565 LE or 32-bit BGRA)
+
+// Octets d'en-tête à lire pour reconnaître un fichier (BMP jusqu'au masque alpha)
+static const size_t RAW_HEADER_SIZE = 70;
+
+enum class RawPixels : uint8_t {
+  RGB565_LE,
+  RGB888,
+  BGR888,
+  RGBA8888,
+  BGRA8888,
+  BGRX8888,  // BMP 32 bits sans alpha: octet ignoré
+};
+
+struct RawLayout {
+  int width{0};
+  int height{0};
+  RawPixels pixels{RawPixels::RGB565_LE};
+  uint32_t data_offset{0};  // première ligne stockée
+  uint32_t stride{0};       // octets par ligne stockée (BMP: multiple de 4)
+  bool bottom_up{false};    // BMP: dernière ligne de l'image en premier
+
+  uint32_t row_offset(int y) const {
+    return this->data_offset + (this->bottom_up ? this->height - 1 - y : y) * this->stride;
+  }
+};
+
+size_t raw_pixel_size(RawPixels pixels);
+
+bool is_bmp_data(const uint8_t *data, size_t size);
+// head: au moins les 54 premiers octets (70 pour les masques V4/V5)
+bool bmp_read_layout(const uint8_t *head, size_t head_size, uint32_t file_size, RawLayout &layout);
+// Sans en-tête (ou en-tête LVGL de 4 octets devant) aux dimensions configurées
+bool raw_layout_from_size(int width, int height, uint32_t file_size, RawLayout &layout);
+bool lvgl_bin_read_layout(const uint8_t *head, size_t head_size, uint32_t file_size, RawLayout &layout);
+
+// Ligne stockée -> RGBA8888 (lignes que l'écran ne lit pas telles quelles)
+void raw_row_to_rgba(RawPixels pixels, const uint8_t *src, uint8_t *rgba, int count);
+// Correction en place d'une ligne lue directement: BGR(A/X) -> RGB(A), alpha opaque pour BGRX
+void raw_swap_red_blue(RawPixels pixels, uint8_t *row, int count);
+
+}  // namespace storage
+}  // namespace esphome
@@ -0,0 +1,113 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components import sensor
+from esphome.const import (
+    CONF_TYPE,
+    STATE_CLASS_MEASUREMENT,
+    UNIT_BYTES,
+    UNIT_MILLISECOND,
+    UNIT_PERCENT,
+    ICON_MEMORY,
+    ICON_TIMER,
+    ENTITY_CATEGORY_DIAGNOSTIC,
+)
+from . import (
+    StorageComponent,
+    CONF_STORAGE_ID,
+)
+
+DEPENDENCIES = ["storage"]
+
+CONF_MEMORY_USED = "memory_used"
+CONF_MEMORY_USAGE = "memory_usage"
+CONF_ARENA_FREE = "arena_free"
+CONF_ARENA_FREE_BLOCKS = "arena_free_blocks"
+CONF_ARENA_FRAGMENTATION = "arena_fragmentation"
+CONF_LOAD_TIME = "load_time"
+CONF_LOAD_READ_TIME = "load_read_time"
+CONF_LOAD_DECODE_TIME = "load_decode_time"
+CONF_LOAD_RESIZE_TIME = "load_resize_time"
+CONF_LOAD_CONVERT_TIME = "load_convert_time"
+CONF_LOAD_BYTES_READ = "load_bytes_read"
+CONF_LOAD_PEAK_HEAP = "load_peak_heap"
+
+STORAGE_SENSOR_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(CONF_STORAGE_ID): cv.use_id(StorageComponent),
+    }
+)
+
+# Dernier chargement terminé, toutes images confondues
+LOAD_TIME_SCHEMA = sensor.sensor_schema(
+    unit_of_measurement=UNIT_MILLISECOND,
+    icon=ICON_TIMER,
+    accuracy_decimals=0,
+    state_class=STATE_CLASS_MEASUREMENT,
+    entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+).extend(STORAGE_SENSOR_SCHEMA)
+
+CONFIG_SCHEMA = cv.typed_schema(
+    {
+        CONF_MEMORY_USED: sensor.sensor_schema(
+            unit_of_measurement=UNIT_BYTES,
+            icon=ICON_MEMORY,
+            accuracy_decimals=0,
+            state_class=STATE_CLASS_MEASUREMENT,
+            entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+        ).extend(STORAGE_SENSOR_SCHEMA),
+        CONF_MEMORY_USAGE: sensor.sensor_schema(
+            unit_of_measurement=UNIT_PERCENT,
+            icon=ICON_MEMORY,
+            accuracy_decimals=1,
+            state_class=STATE_CLASS_MEASUREMENT,
+            entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+        ).extend(STORAGE_SENSOR_SCHEMA),
+        CONF_ARENA_FREE: sensor.sensor_schema(
+            unit_of_measurement=UNIT_BYTES,
+            icon=ICON_MEMORY,
+            accuracy_decimals=0,
+            state_class=STATE_CLASS_MEASUREMENT,
+            entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+        ).extend(STORAGE_SENSOR_SCHEMA),
+        CONF_ARENA_FREE_BLOCKS: sensor.sensor_schema(
+            icon=ICON_MEMORY,
+            accuracy_decimals=0,
+            state_class=STATE_CLASS_MEASUREMENT,
+            entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+        ).extend(STORAGE_SENSOR_SCHEMA),
+        CONF_ARENA_FRAGMENTATION: sensor.sensor_schema(
+            unit_of_measurement=UNIT_PERCENT,
+            icon=ICON_MEMORY,
+            accuracy_decimals=1,
+            state_class=STATE_CLASS_MEASUREMENT,
+            entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+        ).extend(STORAGE_SENSOR_SCHEMA),
+        CONF_LOAD_TIME: LOAD_TIME_SCHEMA,
+        CONF_LOAD_READ_TIME: LOAD_TIME_SCHEMA,
+        CONF_LOAD_DECODE_TIME: LOAD_TIME_SCHEMA,
+        CONF_LOAD_RESIZE_TIME: LOAD_TIME_SCHEMA,
+        CONF_LOAD_CONVERT_TIME: LOAD_TIME_SCHEMA,
+        CONF_LOAD_BYTES_READ: sensor.sensor_schema(
+            unit_of_measurement=UNIT_BYTES,
+            icon=ICON_MEMORY,
+            accuracy_decimals=0,
+            state_class=STATE_CLASS_MEASUREMENT,
+            entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+        ).extend(STORAGE_SENSOR_SCHEMA),
+        CONF_LOAD_PEAK_HEAP: sensor.sensor_schema(
+            unit_of_measurement=UNIT_BYTES,
+            icon=ICON_MEMORY,
+            accuracy_decimals=0,
+            state_class=STATE_CLASS_MEASUREMENT,
+            entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+        ).extend(STORAGE_SENSOR_SCHEMA),
+    },
+    lower=True,
+)
+
+
+async def to_code(config):
+    storage_component = await cg.get_variable(config[CONF_STORAGE_ID])
+    var = await sensor.new_sensor(config)
+    func = getattr(storage_component, f"set_{config[CONF_TYPE]}_sensor")
+    cg.add(func(var))
@@ -0,0 +1,180 @@
+#include "slideshow.h"
+#include "storage.h"
+#include "image_probe.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/helpers.h"
+#include "esphome/core/log.h"
+#include <dirent.h>
+#include <algorithm>
+
+namespace esphome {
+namespace storage {
+
+static const char *const TAG = "storage.slideshow";
+
+bool Slideshow::build_playlist_() {
+  this->built_ = true;
+  this->playlist_.clear();
+
+  StorageComponent *storage = this->image_->get_storage_component();
+  if (!this->folder_.empty() && storage != nullptr) {
+    std::string full_folder = storage->get_root_path() + this->folder_;
+    DIR *dir = opendir(full_folder.c_str());
+    if (dir == nullptr) {
+      ESP_LOGE(TAG, "Cannot open folder %s", full_folder.c_str());
+    } else {
+      struct dirent *ent;
+      while ((ent = readdir(dir)) != nullptr && this->playlist_.size() < UINT16_MAX) {
+        if (is_image_file_name(ent->d_name)) {
+          this->playlist_.emplace_back(ent->d_name);
+        }
+      }
+      closedir(dir);
+      std::sort(this->playlist_.begin(), this->playlist_.end());
+
+      std::string prefix = this->folder_;
+      if (prefix.empty() || prefix.back() != '/') {
+        prefix += '/';
+      }
+      for (std::string &name : this->playlist_) {
+        name.insert(0, prefix);
+      }
+    }
+  }
+  for (const std::string &file : this->files_) {
+    if (this->playlist_.size() < UINT16_MAX) {
+      this->playlist_.push_back(file);
+    }
+  }
+
+  this->order_.resize(this->playlist_.size());
+  for (size_t i = 0; i < this->order_.size(); i++) {
+    this->order_[i] = i;
+  }
+  if (this->shuffle_) {
+    this->shuffle_order_();
+  }
+  this->position_ = 0;
+  this->pending_position_ = -1;
+
+  if (this->order_.empty()) {
+    ESP_LOGW(TAG, "Slideshow has no images (folder '%s', %zu files)", this->folder_.c_str(), this->files_.size());
+    return false;
+  }
+  ESP_LOGI(TAG, "Slideshow: %zu images, %u ms interval%s", this->order_.size(), this->interval_ms_,
+           this->shuffle_ ? ", shuffled" : "");
+  return true;
+}
+
+void Slideshow::shuffle_order_() {
+  // Fisher-Yates
+  for (size_t i = this->order_.size(); i > 1; i--) {
+    std::swap(this->order_[i - 1], this->order_[random_uint32() % i]);
+  }
+  // Pas deux fois la même image à la jonction de deux cycles
+  if (this->order_.size() > 1 && this->playlist_[this->order_[0]] == this->current_path_) {
+    std::swap(this->order_[0], this->order_[1]);
+  }
+}
+
+void Slideshow::loop() {
+  if (!this->built_) {
+    // La SD est montée pendant le setup, même attente que l'auto-load
+    if (millis() < 2000) {
+      return;
+    }
+    if (this->build_playlist_()) {
+      this->show_(0);
+    }
+    return;
+  }
+  if (this->order_.size() < 2) {
+    return;
+  }
+
+  // Retour en arrière demandé pendant un job: lancé dès que la tâche est libre
+  if (this->pending_position_ >= 0) {
+    if (this->show_(this->pending_position_)) {
+      this->pending_position_ = -1;
+    }
+    return;
+  }
+
+  bool due = this->advance_requested_ || (this->running_ && millis() - this->shown_at_ >= this->interval_ms_);
+  size_t next = this->next_position_();
+  const std::string &next_path = this->path_at_(next);
+
+  if (this->image_->is_prefetch_failed(next_path)) {
+    this->drop_(next);
+    return;
+  }
+
+  bool ready = this->image_->is_prefetched(next_path);
+  if (!ready && !this->image_->is_load_pending() && !this->image_->prefetch(next_path)) {
+    // Pas de préchargement possible (GIF animé, viewport, pas de tâche de fond): chargement à l'échéance
+    if (due && this->show_(next)) {
+      this->advance_requested_ = false;
+    }
+    return;
+  }
+
+  // Pas encore décodée: l'image courante reste affichée jusqu'à la fin du job
+  if (due && ready && this->show_(next)) {
+    this->advance_requested_ = false;
+  }
+}
+
+bool Slideshow::show_(size_t position) {
+  std::string path = this->path_at_(position);
+  if (this->image_->is_prefetched(path)) {
+    this->image_->show_prefetched();
+  } else {
+    if (this->image_->is_load_pending()) {
+      return false;
+    }
+    this->image_->discard_prefetched();
+    this->image_->request_load(path, LOAD_PRIORITY_VISIBLE);
+  }
+
+  this->position_ = position;
+  this->current_path_ = path;
+  this->shown_at_ = millis();
+  ESP_LOGD(TAG, "Showing %zu/%zu: %s", position + 1, this->order_.size(), path.c_str());
+
+  // Fin de cycle: nouvel ordre, la suivante est order_[0]
+  if (this->shuffle_ && this->order_.size() > 2 && position == this->order_.size() - 1) {
+    this->shuffle_order_();
+  }
+  return true;
+}
+
+void Slideshow::drop_(size_t position) {
+  ESP_LOGW(TAG, "Removing unreadable image from the slideshow: %s", this->path_at_(position).c_str());
+  this->order_.erase(this->order_.begin() + position);
+  if (position < this->position_) {
+    this->position_--;
+  }
+  if (this->position_ >= this->order_.size()) {
+    this->position_ = 0;
+  }
+}
+
+void Slideshow::previous() {
+  if (this->order_.size() < 2) {
+    return;
+  }
+  size_t previous = (this->position_ + this->order_.size() - 1) % this->order_.size();
+  if (!this->show_(previous)) {
+    this->pending_position_ = previous;
+  }
+}
+
+void Slideshow::set_running(bool running) {
+  if (running && !this->running_) {
+    this->shown_at_ = millis();
+  }
+  this->running_ = running;
+}
+
+}  // namespace storage
+}  // namespace esphome
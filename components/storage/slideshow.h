@@ -0,0 +1,76 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace esphome {
+namespace storage {
+
+class SdImageComponent;
+
+// =====================================================
+// Slideshow - diaporama sur un SdImageComponent
+// =====================================================
+//
+// Playlist from a folder listing and/or explicit paths. While image N is on
+// screen, image N+1 is decoded by the background loader into the image's back
+// buffer (SdImageComponent::prefetch); when the interval expires the buffers
+// are swapped on the main loop, so the display never shows a blank or partly
+// decoded frame. If N+1 is not ready yet, N simply stays up a little longer.
+//
+// Shuffle draws a new order each cycle, never starting the new cycle with the
+// image that ended the previous one.
+class Slideshow {
+ public:
+  explicit Slideshow(SdImageComponent *image) : image_(image) {}
+
+  void set_folder(const std::string &folder) { this->folder_ = folder; }
+  void add_file(const std::string &path) { this->files_.push_back(path); }
+  void set_interval(uint32_t interval_ms) { this->interval_ms_ = interval_ms; }
+  void set_shuffle(bool shuffle) { this->shuffle_ = shuffle; }
+
+  // Appelé par SdImageComponent::loop()
+  void loop();
+
+  void next() { this->advance_requested_ = true; }
+  void previous();
+  void set_running(bool running);
+  bool is_running() const { return this->running_; }
+  // Relit le dossier au prochain passage (fichiers ajoutés/supprimés)
+  void rebuild() { this->built_ = false; }
+
+  size_t get_count() const { return this->order_.size(); }
+  size_t get_position() const { return this->position_; }
+  const std::string &get_current_path() const { return this->current_path_; }
+  uint32_t get_interval() const { return this->interval_ms_; }
+  const std::string &get_folder() const { return this->folder_; }
+  bool is_shuffle() const { return this->shuffle_; }
+
+ protected:
+  bool build_playlist_();
+  void shuffle_order_();
+  size_t next_position_() const { return (this->position_ + 1) % this->order_.size(); }
+  const std::string &path_at_(size_t position) const { return this->playlist_[this->order_[position]]; }
+  // Affiche la position (bascule si préchargée, sinon chargement de fond); false si occupé
+  bool show_(size_t position);
+  void drop_(size_t position);
+
+  SdImageComponent *image_;
+  std::string folder_;
+  std::vector<std::string> files_;
+  uint32_t interval_ms_{10000};
+  bool shuffle_{false};
+
+  std::vector<std::string> playlist_;
+  std::vector<uint16_t> order_;
+  size_t position_{0};
+  std::string current_path_;
+  bool built_{false};
+  bool running_{true};
+  bool advance_requested_{false};
+  int pending_position_{-1};  // retour en arrière en attente de la fin du job en vol
+  uint32_t shown_at_{0};
+};
+
+}  // namespace storage
+}  // namespace esphome
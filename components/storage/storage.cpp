@@ -1,4 +1,8 @@
 #include "storage.h"
+#include "image_loader.h"
+#include "gif_player.h"
+#include "stream_io.h"
+#include "pixel_kernels.h"
 #include "esphome/core/log.h"
 #include "esphome/core/application.h"
 #include <sys/stat.h>
@@ -27,8 +31,83 @@ namespace storage {
 static const char *const TAG = "storage";
 static const char *const TAG_IMAGE = "storage.image";
 
-// Global decoder instances for callbacks
-static SdImageComponent *current_image_component = nullptr;
+// Lectures à une position du fichier; lignes contiguës lues sans seek
+static bool read_file_at(FILE *file, uint32_t offset, uint8_t *dst, size_t len) {
+  uint32_t start = micros();
+  if (ftell(file) != (long) offset && fseek(file, offset, SEEK_SET) != 0) {
+    return false;
+  }
+  size_t read = fread(dst, 1, len, file);
+  note_load_read(read, micros() - start);
+  return read == len;
+}
+
+// Premiers octets du fichier (signature, IHDR), 0 si illisible
+static size_t read_file_head(const std::string &full_path, uint8_t *head, size_t size) {
+  FILE *file = fopen(full_path.c_str(), "rb");
+  if (!file) {
+    return 0;
+  }
+  size_t got = fread(head, 1, size, file);
+  fclose(file);
+  return got;
+}
+
+// Tranche du décodage découpé pas encore écoulée (micros(), sûr au débordement)
+static inline bool slice_time_left(uint32_t deadline_us) { return (int32_t) (micros() - deadline_us) < 0; }
+
+#ifdef USE_PNGLE
+static const size_t PNGLE_CHUNK_SIZE = 1024;
+
+// pngle est incrémental: un bloc lu et passé au décodeur, le reste non consommé
+// (pending) gardé en tête du bloc suivant. 1: progression, 0: fin du fichier, -1: erreur.
+static int feed_pngle_chunk(pngle_t *pngle, FILE *file, uint8_t *chunk, size_t size, size_t &pending) {
+  uint32_t start = micros();
+  size_t n = fread(chunk + pending, 1, size - pending, file);
+  note_load_read(n, micros() - start);
+  if (n == 0) {
+    return 0;
+  }
+  pending += n;
+  int fed = pngle_feed(pngle, chunk, pending);
+  if (fed < 0) {
+    ESP_LOGE(TAG_IMAGE, "PNG decode error: %s", pngle_error(pngle));
+    return -1;
+  }
+  pending -= fed;
+  memmove(chunk, chunk + fed, pending);
+  return 1;
+}
+
+// Fichier entier par blocs de 1 Ko; *stop (optionnel) arrête la lecture tôt
+static bool feed_pngle_file(pngle_t *pngle, FILE *file, const bool *stop) {
+  uint8_t chunk[PNGLE_CHUNK_SIZE];
+  size_t pending = 0;
+  int result = 1;
+  while (result > 0 && (stop == nullptr || !*stop)) {
+    result = feed_pngle_chunk(pngle, file, chunk, sizeof(chunk), pending);
+    decode_yield();
+  }
+  return result >= 0;
+}
+#endif
+
+#ifdef USE_PNGDEC
+static bool png_file_interlaced(const std::string &full_path) {
+  uint8_t head[32];
+  return png_is_interlaced(head, read_file_head(full_path, head, sizeof(head)));
+}
+
+static PngRowFormat png_row_format(const PNGDRAW *draw) {
+  PngRowFormat format;
+  format.pixel_type = draw->iPixelType;
+  format.bit_depth = draw->iBpp;
+  format.palette = draw->pPalette;
+  format.palette_alpha = draw->iHasAlpha;
+  return format;
+}
+#endif
+
 
 // =====================================================
 // StorageComponent Implementation
@@ -41,6 +120,29 @@ void StorageComponent::setup() {
   ESP_LOGCONFIG(TAG, "  SD component: %s", this->sd_component_ ? "configured" : "not configured");
   ESP_LOGCONFIG(TAG, "  Auto load: %s", this->auto_load_ ? "YES" : "NO (on-demand)");
   ESP_LOGCONFIG(TAG, "  Registered images: %zu", this->sd_images_.size());
+  ESP_LOGCONFIG(TAG, "  Pixel kernels: %s", kernels::implementation());
+#ifdef USE_PNGDEC
+  ESP_LOGCONFIG(TAG, "  PNG decoder: PNGdec (pngle for interlaced)");
+#else
+  ESP_LOGCONFIG(TAG, "  PNG decoder: pngle");
+#endif
+  
+  if (this->psram_arena_size_ > 0) {
+    ImageArena::get(MemoryPlacement::PSRAM)->init(this->psram_arena_size_);
+  }
+  if (this->internal_arena_size_ > 0) {
+    ImageArena::get(MemoryPlacement::INTERNAL)->init(this->internal_arena_size_);
+  }
+  ImageArena::add_compaction_listener([this]() {
+    for (SdImageComponent *img : this->sd_images_) {
+      img->on_buffer_moved();
+    }
+  });
+  
+  if (this->background_loading_ && !this->loader_.start(8192, this->loader_workers_, this->loader_core_)) {
+    ESP_LOGW(TAG, "Background loading unavailable, falling back to %s",
+             this->loader_.is_sliced() ? "sliced loads in loop()" : "synchronous loads");
+  }
   
   if (this->auto_load_) {
     ESP_LOGI(TAG, "Auto-load enabled globally - will load all images during setup");
@@ -50,6 +152,62 @@ void StorageComponent::setup() {
 }
 
 void StorageComponent::loop() {
+  // Compactage périodique hors rendu, seulement si la fragmentation est élevée
+  uint32_t arena_now = millis();
+  if (arena_now - this->last_arena_check_ > 5000) {
+    this->last_arena_check_ = arena_now;
+    for (MemoryPlacement placement : {MemoryPlacement::PSRAM, MemoryPlacement::INTERNAL}) {
+      ImageArena *arena = ImageArena::get(placement);
+      if (arena->is_initialized() && arena->compact_if_fragmented(this->arena_compact_threshold_)) {
+        this->memory_dirty_ = true;
+      }
+    }
+  }
+  
+  // Sans worker: une tranche du job en cours (budget decode_budget)
+  this->loader_.run_slice();
+  
+  // Résultats de la tâche de chargement: publication sur la loop principale
+  LoadJob job;
+  while (this->loader_.pop_completed(job)) {
+    if (job.thumbnails != nullptr) {
+      job.thumbnails->finish(job.thumbnail, job.generation, job.success);
+    } else {
+      job.image->complete_background_load(job);
+    }
+  }
+  
+  if (this->memory_dirty_) {
+    this->publish_memory_usage_();
+  }
+  
+#ifdef USE_LVGL
+  // Lecteur LVGL: lv_init() est fait dans le setup du composant lvgl, qui passe après le nôtre
+  if (this->lvgl_fs_enabled_ && !this->lvgl_fs_.is_registered()) {
+    this->lvgl_fs_.set_root_path(this->root_path_);
+    this->lvgl_fs_.set_sd_component(this->sd_component_);
+    if (!this->lvgl_fs_.register_driver()) {
+      this->lvgl_fs_enabled_ = false;
+    }
+  }
+#endif
+  
+  // Vignettes: dossier ouvert tard (SD montée), puis une à la fois en job du
+  // chargeur (échéance de préchargement); sans chargeur, tout est synchrone
+  uint32_t thumb_now = millis();
+  if (!this->thumbnail_open_attempted_ && !this->thumbnail_folder_.empty() && thumb_now > 2000) {
+    this->thumbnail_open_attempted_ = true;
+    this->open_thumbnail_folder(this->thumbnail_folder_);
+  }
+  if (this->thumbnails_.get_pending() > 0 && !this->thumbnails_.is_rendering()) {
+    if (this->loader_.is_running()) {
+      this->submit_thumbnail_();
+    } else if (thumb_now - this->last_thumbnail_ >= THUMBNAIL_IDLE_INTERVAL_MS) {
+      this->thumbnails_.generate_next();
+      this->last_thumbnail_ = millis();
+    }
+  }
+  
   // Auto-load global avec retry si nécessaire
   if (this->auto_load_) {
     static uint32_t last_auto_load_attempt = 0;
@@ -69,7 +227,7 @@ void StorageComponent::loop() {
       if (now - last_auto_load_attempt > 10000) { // Retry toutes les 10s
         bool has_failed_images = false;
         for (SdImageComponent* img : this->sd_images_) {
-          if (!img->is_loaded()) {
+          if (!img->is_loaded() && !img->is_evicted()) {
             has_failed_images = true;
             break;
           }
@@ -88,6 +246,22 @@ void StorageComponent::loop() {
 void StorageComponent::load_all_images() {
   ESP_LOGI(TAG, "Loading all registered SD images (%zu total)", this->sd_images_.size());
   
+  // Mode tâche de fond: on ne fait que mettre en file, la loop n'attend rien
+  if (this->is_background_loading()) {
+    int queued = 0;
+    for (SdImageComponent* img : this->sd_images_) {
+      // Un diaporama charge ses images lui-même
+      if (img->is_loaded() || img->is_evicted() || img->is_load_pending() || img->get_slideshow() != nullptr) {
+        continue;
+      }
+      if (img->request_load(img->get_file_path())) {
+        queued++;
+      }
+    }
+    ESP_LOGI(TAG, "Queued %d image loads for the background loader", queued);
+    return;
+  }
+  
   int loaded_count = 0;
   int failed_count = 0;
   
@@ -96,6 +270,12 @@ void StorageComponent::load_all_images() {
       loaded_count++;
       continue; // Déjà chargée
     }
+    if (img->is_evicted()) {
+      continue; // Évincée par le budget, rechargée au prochain draw()
+    }
+    if (img->get_slideshow() != nullptr) {
+      continue; // Chargée par son diaporama
+    }
     
     ESP_LOGI(TAG, "Auto-loading: %s", img->get_file_path().c_str());
     if (img->load_image()) {
@@ -115,6 +295,32 @@ void StorageComponent::load_all_images() {
            loaded_count, failed_count, this->sd_images_.size());
 }
 
+bool StorageComponent::submit_load(SdImageComponent *image, const std::string &path, uint32_t generation,
+                                   LoadPriority priority, bool preview) {
+  LoadJob job;
+  job.image = image;
+  job.path = path;
+  job.generation = generation;
+  job.deadline = load_deadline(priority);
+  job.prefetch = priority == LOAD_PRIORITY_PREFETCH;
+  job.preview = preview;
+  return this->loader_.submit(std::move(job));
+}
+
+void StorageComponent::submit_thumbnail_() {
+  LoadJob job;
+  if (!this->thumbnails_.begin_next(job.thumbnail, job.path)) {
+    return;
+  }
+  job.thumbnails = &this->thumbnails_;
+  job.generation = this->thumbnails_.get_generation();
+  job.deadline = load_deadline(LOAD_PRIORITY_PREFETCH);
+  size_t index = job.thumbnail;
+  if (!this->loader_.submit(std::move(job))) {
+    this->thumbnails_.finish(index, this->thumbnails_.get_generation(), false);
+  }
+}
+
 void StorageComponent::unload_all_images() {
   ESP_LOGI(TAG, "Unloading all registered SD images");
   
@@ -125,6 +331,113 @@ void StorageComponent::unload_all_images() {
   ESP_LOGI(TAG, "All images unloaded");
 }
 
+size_t StorageComponent::get_memory_used() const {
+  size_t used = 0;
+  for (SdImageComponent* img : this->sd_images_) {
+    used += img->get_memory_footprint();
+  }
+  return used;
+}
+
+bool StorageComponent::reserve_image_memory(SdImageComponent *requester, size_t bytes) {
+  if (this->memory_budget_ == 0) {
+    return true;
+  }
+  
+  if (bytes > this->memory_budget_) {
+    ESP_LOGE(TAG, "Image needs %zu bytes, more than the whole budget (%zu bytes)", 
+             bytes, this->memory_budget_);
+    return false;
+  }
+  
+  // Les buffers du demandeur sont comptés dans `bytes` (affichée gardée pour un préchargement)
+  size_t used = this->get_memory_used() - requester->get_memory_footprint();
+  
+  while (used + bytes > this->memory_budget_) {
+    SdImageComponent *victim = nullptr;
+    for (SdImageComponent* img : this->sd_images_) {
+      if (img == requester || img->get_memory_footprint() == 0) {
+        continue;
+      }
+      if (victim == nullptr || img->get_last_draw_time() < victim->get_last_draw_time()) {
+        victim = img;
+      }
+    }
+    
+    if (victim == nullptr) {
+      ESP_LOGW(TAG, "Memory budget exhausted: %zu + %zu > %zu bytes and nothing left to evict", 
+               used, bytes, this->memory_budget_);
+      return false;
+    }
+    
+    size_t freed = victim->get_memory_footprint();
+    ESP_LOGI(TAG, "Evicting %s (%zu bytes, last drawn %u ms ago) for %s", 
+             victim->get_file_path().c_str(), freed, millis() - victim->get_last_draw_time(),
+             requester->get_file_path().c_str());
+    victim->evict();
+    used -= freed;
+    this->eviction_count_++;
+  }
+  
+  return true;
+}
+
+ArenaStats StorageComponent::get_arena_stats() const {
+  // Agrégat des deux arènes; la fragmentation retenue est la pire des deux
+  ArenaStats total;
+  float worst = 0.0f;
+  for (MemoryPlacement placement : {MemoryPlacement::PSRAM, MemoryPlacement::INTERNAL}) {
+    ImageArena *arena = ImageArena::get(placement);
+    if (!arena->is_initialized()) {
+      continue;
+    }
+    ArenaStats stats = arena->get_stats();
+    total.capacity += stats.capacity;
+    total.used += stats.used;
+    total.free += stats.free;
+    total.free_blocks += stats.free_blocks;
+    total.reuse_hits += stats.reuse_hits;
+    total.compactions += stats.compactions;
+    total.heap_fallbacks += stats.heap_fallbacks;
+    if (stats.fragmentation() >= worst) {
+      worst = stats.fragmentation();
+      total.largest_free = stats.largest_free;
+    }
+  }
+  return total;
+}
+
+void StorageComponent::publish_memory_usage_() {
+  this->memory_dirty_ = false;
+#ifdef USE_SENSOR
+  ArenaStats arena = this->get_arena_stats();
+  if (this->arena_free_sensor_ != nullptr) {
+    this->arena_free_sensor_->publish_state(arena.free);
+  }
+  if (this->arena_free_blocks_sensor_ != nullptr) {
+    this->arena_free_blocks_sensor_->publish_state(arena.free_blocks);
+  }
+  if (this->arena_fragmentation_sensor_ != nullptr) {
+    float fragmentation = 0.0f;
+    for (MemoryPlacement placement : {MemoryPlacement::PSRAM, MemoryPlacement::INTERNAL}) {
+      ImageArena *a = ImageArena::get(placement);
+      if (a->is_initialized()) {
+        fragmentation = std::max(fragmentation, a->get_stats().fragmentation());
+      }
+    }
+    this->arena_fragmentation_sensor_->publish_state(fragmentation * 100.0f);
+  }
+  
+  size_t used = this->get_memory_used();
+  if (this->memory_used_sensor_ != nullptr) {
+    this->memory_used_sensor_->publish_state(used);
+  }
+  if (this->memory_usage_sensor_ != nullptr && this->memory_budget_ > 0) {
+    this->memory_usage_sensor_->publish_state(100.0f * used / this->memory_budget_);
+  }
+#endif
+}
+
 void StorageComponent::dump_config() {
   ESP_LOGCONFIG(TAG, "Storage Component:");
   ESP_LOGCONFIG(TAG, "  Platform: %s", this->platform_.c_str());
@@ -132,6 +445,235 @@ void StorageComponent::dump_config() {
   ESP_LOGCONFIG(TAG, "  SD component: %s", this->sd_component_ ? "YES" : "NO");
   ESP_LOGCONFIG(TAG, "  Auto load: %s", this->auto_load_ ? "YES" : "NO");
   ESP_LOGCONFIG(TAG, "  Registered images: %zu", this->sd_images_.size());
+  ESP_LOGCONFIG(TAG, "  Background loading: %s (%u workers)", this->is_background_loading() ? "YES" : "NO",
+                this->loader_.get_worker_count());
+  if (this->loader_.is_sliced()) {
+    ESP_LOGCONFIG(TAG, "  Decode budget: %u us per loop", this->loader_.get_slice_budget());
+  }
+  if (this->memory_budget_ > 0) {
+    ESP_LOGCONFIG(TAG, "  Memory budget: %zu bytes (used: %zu, evictions: %u)", 
+                  this->memory_budget_, this->get_memory_used(), this->eviction_count_);
+  }
+  for (MemoryPlacement placement : {MemoryPlacement::PSRAM, MemoryPlacement::INTERNAL}) {
+    ImageArena *arena = ImageArena::get(placement);
+    if (!arena->is_initialized()) {
+      continue;
+    }
+    ArenaStats stats = arena->get_stats();
+    ESP_LOGCONFIG(TAG, "  %s arena: %zu bytes, %zu used, %zu free in %zu blocks (largest %zu, fragmentation %.0f%%)",
+                  placement_to_string(placement), stats.capacity, stats.used, stats.free, stats.free_blocks,
+                  stats.largest_free, stats.fragmentation() * 100.0f);
+    ESP_LOGCONFIG(TAG, "    Slot reuses: %u, compactions: %u, heap fallbacks: %u",
+                  stats.reuse_hits, stats.compactions, stats.heap_fallbacks);
+  }
+#ifdef USE_SENSOR
+  LOG_SENSOR("  ", "Memory used", this->memory_used_sensor_);
+  LOG_SENSOR("  ", "Memory usage", this->memory_usage_sensor_);
+  LOG_SENSOR("  ", "Arena free", this->arena_free_sensor_);
+  LOG_SENSOR("  ", "Arena free blocks", this->arena_free_blocks_sensor_);
+  LOG_SENSOR("  ", "Arena fragmentation", this->arena_fragmentation_sensor_);
+  LOG_SENSOR("  ", "Load time", this->load_time_sensor_);
+  LOG_SENSOR("  ", "Load read time", this->load_read_time_sensor_);
+  LOG_SENSOR("  ", "Load decode time", this->load_decode_time_sensor_);
+  LOG_SENSOR("  ", "Load resize time", this->load_resize_time_sensor_);
+  LOG_SENSOR("  ", "Load convert time", this->load_convert_time_sensor_);
+  LOG_SENSOR("  ", "Load bytes read", this->load_bytes_read_sensor_);
+  LOG_SENSOR("  ", "Load peak heap", this->load_peak_heap_sensor_);
+#endif
+  if (!this->thumbnail_folder_.empty()) {
+    ESP_LOGCONFIG(TAG, "  Thumbnails: %dx%d, folder %s", this->thumbnails_.get_thumb_width(),
+                  this->thumbnails_.get_thumb_height(), this->thumbnail_folder_.c_str());
+  }
+#ifdef USE_LVGL
+  if (this->lvgl_fs_enabled_ || this->lvgl_fs_.is_registered()) {
+    ESP_LOGCONFIG(TAG, "  LVGL drive: %c: (read cache %u bytes, %u files opened)", this->lvgl_fs_.get_letter(),
+                  this->lvgl_fs_.get_cache_size(), this->lvgl_fs_.get_open_count());
+  }
+#endif
+  if (!this->asset_pack_path_.empty()) {
+    ESP_LOGCONFIG(TAG, "  Asset pack: %s (%s)", this->asset_pack_path_.c_str(),
+                  this->asset_pack_.is_open() ? "open" : "not opened yet");
+  }
+}
+
+// =====================================================
+// Load statistics
+// =====================================================
+
+void StorageComponent::record_load(SdImageComponent *image, const std::string &path, const LoadStats &stats) {
+  ESP_LOGD(TAG, "Load %s %s: %s", path.c_str(), stats.success ? "done" : "failed", stats.to_string().c_str());
+  if (stats.success && stats.total_us >= this->slowest_load_.total_us) {
+    this->slowest_load_ = stats;
+    this->slowest_load_path_ = path;
+  }
+#ifdef USE_SENSOR
+  if (this->load_time_sensor_ != nullptr) {
+    this->load_time_sensor_->publish_state(stats.total_us / 1000.0f);
+  }
+  if (this->load_read_time_sensor_ != nullptr) {
+    this->load_read_time_sensor_->publish_state(stats.phase_us[LOAD_PHASE_READ] / 1000.0f);
+  }
+  if (this->load_decode_time_sensor_ != nullptr) {
+    this->load_decode_time_sensor_->publish_state(stats.phase_us[LOAD_PHASE_DECODE] / 1000.0f);
+  }
+  if (this->load_resize_time_sensor_ != nullptr) {
+    this->load_resize_time_sensor_->publish_state(stats.phase_us[LOAD_PHASE_RESIZE] / 1000.0f);
+  }
+  if (this->load_convert_time_sensor_ != nullptr) {
+    this->load_convert_time_sensor_->publish_state(stats.phase_us[LOAD_PHASE_CONVERT] / 1000.0f);
+  }
+  if (this->load_bytes_read_sensor_ != nullptr) {
+    this->load_bytes_read_sensor_->publish_state(stats.bytes_read);
+  }
+  if (this->load_peak_heap_sensor_ != nullptr) {
+    this->load_peak_heap_sensor_->publish_state(stats.peak_heap);
+  }
+#endif
+}
+
+void StorageComponent::dump_load_stats() {
+  ESP_LOGI(TAG, "Load statistics (%zu images):", this->sd_images_.size());
+  for (SdImageComponent *image : this->sd_images_) {
+    if (image->get_load_count() == 0) {
+      ESP_LOGI(TAG, "  %s: never loaded", image->get_file_path().c_str());
+      continue;
+    }
+    const LoadStats &stats = image->get_load_stats();
+    ESP_LOGI(TAG, "  %s: %u loads, %u failed", image->get_load_stats_path().c_str(), image->get_load_count(),
+             image->get_load_failures());
+    ESP_LOGI(TAG, "    last %s: %s", stats.success ? "load" : "failure", stats.to_string().c_str());
+  }
+  if (!this->slowest_load_path_.empty()) {
+    ESP_LOGI(TAG, "  Slowest load: %s, %s", this->slowest_load_path_.c_str(), this->slowest_load_.to_string().c_str());
+  }
+}
+
+const AssetPackEntry *StorageComponent::find_asset(const std::string &name) {
+  if (this->asset_pack_path_.empty()) {
+    ESP_LOGE(TAG, "No asset pack configured, cannot load '%s'", name.c_str());
+    return nullptr;
+  }
+  
+  // Ouverture paresseuse: la SD n'est pas forcément montée pendant setup()
+  LockGuard guard(this->asset_pack_lock_);
+  if (!this->asset_pack_.is_open()) {
+    if (this->asset_pack_open_failed_) {
+      return nullptr;
+    }
+    if (!this->asset_pack_.open(this->root_path_ + this->asset_pack_path_)) {
+      this->asset_pack_open_failed_ = true;
+      return nullptr;
+    }
+  }
+  
+  const AssetPackEntry *entry = this->asset_pack_.find(name);
+  if (!entry) {
+    ESP_LOGE(TAG, "Asset '%s' (hash 0x%08X) not found in %s", 
+             name.c_str(), asset_name_hash(name), this->asset_pack_path_.c_str());
+  }
+  return entry;
+}
+
+bool StorageComponent::read_asset(const AssetPackEntry &entry, uint8_t *dst) {
+  uint32_t start = micros();
+  bool success = this->asset_pack_.read(entry, dst);
+  note_load_read(success ? entry.size : 0, micros() - start);
+  return success;
+}
+
+// =====================================================
+// Image probe - en-têtes seulement, résultat mis en cache
+// =====================================================
+
+bool StorageComponent::probe_image(const std::string &path, ImageInfo &info) {
+  {
+    LockGuard guard(this->probe_lock_);
+    auto it = this->probe_cache_.find(path);
+    if (it != this->probe_cache_.end()) {
+      info = it->second;
+      return true;
+    }
+    if (this->probe_failures_.count(path) != 0) {
+      return false;
+    }
+  }
+  
+  bool ok = false;
+  if (path.compare(0, strlen(ASSET_PACK_PREFIX), ASSET_PACK_PREFIX) == 0) {
+    ok = this->probe_asset_(path.substr(strlen(ASSET_PACK_PREFIX)), info);
+    if (!ok) {
+      ESP_LOGW(TAG, "No readable image header in %s", path.c_str());
+    }
+  } else {
+    std::string full_path = this->root_path_ + path;
+    FILE *file = fopen(full_path.c_str(), "rb");
+    if (!file) {
+      ESP_LOGW(TAG, "Cannot probe %s (errno: %d)", full_path.c_str(), errno);
+    } else {
+      ok = probe_image_file(file, info);
+      fclose(file);
+      if (!ok) {
+        ESP_LOGW(TAG, "No readable image header in %s", path.c_str());
+      }
+    }
+  }
+  
+  // Échecs gardés aussi, jusqu'à invalidate_probe(): signalés une seule fois
+  LockGuard guard(this->probe_lock_);
+  if (this->probe_cache_.size() + this->probe_failures_.size() >= PROBE_CACHE_MAX) {
+    this->probe_cache_.clear();
+    this->probe_failures_.clear();
+  }
+  if (!ok) {
+    this->probe_failures_.insert(path);
+    return false;
+  }
+  ESP_LOGV(TAG, "Probed %s: %s %dx%d, %u bytes", path.c_str(), image_file_type_to_string(info.type),
+           info.width, info.height, (unsigned) info.file_size);
+  this->probe_cache_[path] = info;
+  return true;
+}
+
+bool StorageComponent::probe_asset_(const std::string &name, ImageInfo &info) {
+  const AssetPackEntry *entry = this->find_asset(name);
+  if (!entry) {
+    return false;
+  }
+  
+  // Pixels pré-convertis: les dimensions sont dans l'index
+  if (static_cast<AssetEncoding>(entry->encoding) != AssetEncoding::ENCODED) {
+    info = ImageInfo();
+    info.width = entry->width;
+    info.height = entry->height;
+    info.file_size = entry->size;
+    return info.width > 0 && info.height > 0;
+  }
+  
+  // Entrée encodée: le SOF d'un JPEG avec EXIF peut être loin, on lit un peu plus
+  static const size_t PROBE_HEAD_SIZE = 4096;
+  std::vector<uint8_t> head(std::min<size_t>(PROBE_HEAD_SIZE, entry->size));
+  size_t got = this->asset_pack_.read_prefix(*entry, head.data(), head.size());
+  if (!probe_image_data(head.data(), got, info)) {
+    return false;
+  }
+  info.file_size = entry->size;
+  return true;
+}
+
+bool StorageComponent::open_thumbnail_folder(const std::string &folder) {
+  this->thumbnail_folder_ = folder;
+  this->thumbnail_open_attempted_ = true;
+  std::string full_folder = this->root_path_ + folder;
+  while (full_folder.size() > 1 && full_folder.back() == '/') {
+    full_folder.pop_back();
+  }
+  return this->thumbnails_.open_folder(full_folder);
+}
+
+void StorageComponent::invalidate_probe(const std::string &path) {
+  LockGuard guard(this->probe_lock_);
+  this->probe_cache_.erase(path);
+  this->probe_failures_.erase(path);
 }
 
 bool StorageComponent::file_exists_direct(const std::string &path) {
@@ -170,8 +712,10 @@ std::vector<uint8_t> StorageComponent::read_file_direct(const std::string &path)
   }
   
   std::vector<uint8_t> data(size);
+  uint32_t read_start = micros();
   size_t read_size = fread(data.data(), 1, size, file);
   fclose(file);
+  note_load_read(read_size, micros() - read_start);
   
   if (read_size != static_cast<size_t>(size)) {
     ESP_LOGE(TAG, "Failed to read complete file: expected %ld, got %zu", size, read_size);
@@ -192,6 +736,7 @@ bool StorageComponent::write_file_direct(const std::string &path, const std::vec
   
   size_t written = fwrite(data.data(), 1, data.size(), file);
   fclose(file);
+  this->invalidate_probe(path);
   
   return written == data.size();
 }
@@ -213,6 +758,9 @@ void SdImageComponent::setup() {
   ESP_LOGCONFIG(TAG_IMAGE, "Setting up SD Image Component...");
   ESP_LOGCONFIG(TAG_IMAGE, "  File path: %s", this->file_path_.c_str());
   ESP_LOGCONFIG(TAG_IMAGE, "  Resize: %dx%d", this->resize_width_, this->resize_height_);
+  if (this->raw_width_ > 0) {
+    ESP_LOGCONFIG(TAG_IMAGE, "  Raw size: %dx%d", this->raw_width_, this->raw_height_);
+  }
   ESP_LOGCONFIG(TAG_IMAGE, "  Format: %s", this->format_to_string().c_str());
   ESP_LOGCONFIG(TAG_IMAGE, "  Storage component: %s", this->storage_component_ ? "configured" : "not configured");
   
@@ -238,6 +786,17 @@ void SdImageComponent::setup() {
 void SdImageComponent::loop() {
   // Plus de retry individuel - tout est géré au niveau du StorageComponent
   // ou par le système on-demand
+  
+  // Animation: une frame par échéance, décodée directement dans le canvas
+  if (this->gif_player_ != nullptr && this->playing_ && this->image_loaded_) {
+    if ((int32_t) (millis() - this->next_frame_ms_) >= 0) {
+      this->advance_animation_();
+    }
+  }
+  
+  if (this->slideshow_ != nullptr) {
+    this->slideshow_->loop();
+  }
 }
 
 // NOUVEAU: Méthodes pour LVGL avec chargement automatique intégré
@@ -247,6 +806,10 @@ const uint8_t* SdImageComponent::get_image_data_for_lvgl() {
     ESP_LOGW(TAG_IMAGE, "Failed to auto-load image for LVGL: %s", this->file_path_.c_str());
     return nullptr;
   }
+  if (this->compression_ != RamCompression::NONE) {
+    ESP_LOGW(TAG_IMAGE, "%s is compressed in RAM, no raw pixels for LVGL", this->file_path_.c_str());
+    return nullptr;
+  }
   
   return this->image_buffer_.empty() ? nullptr : this->image_buffer_.data();
 }
@@ -257,22 +820,114 @@ size_t SdImageComponent::get_image_data_size_for_lvgl() {
     ESP_LOGW(TAG_IMAGE, "Failed to auto-load image for LVGL: %s", this->file_path_.c_str());
     return 0;
   }
+  if (this->compression_ != RamCompression::NONE) {
+    return 0;
+  }
   
   return this->image_buffer_.size();
 }
 
+#ifdef USE_LVGL
+lv_img_dsc_t *SdImageComponent::get_lv_img_dsc() {
+  if (!this->ensure_loaded()) {
+    ESP_LOGW(TAG_IMAGE, "Failed to auto-load image for LVGL: %s", this->file_path_.c_str());
+    return nullptr;
+  }
+  this->update_lv_img_dsc_();
+  return this->lv_img_dsc_.data != nullptr ? &this->lv_img_dsc_ : nullptr;
+}
+
+void SdImageComponent::update_lv_img_dsc_() {
+  lv_img_dsc_t &dsc = this->lv_img_dsc_;
+  dsc.header.always_zero = 0;
+  dsc.header.reserved = 0;
+  int width = this->get_current_width();
+  int height = this->get_current_height();
+  if (!this->image_loaded_ || this->image_buffer_.empty() || width <= 0 || height <= 0) {
+    dsc.header.w = 0;
+    dsc.header.h = 0;
+    dsc.data_size = 0;
+    dsc.data = nullptr;
+    return;
+  }
+  if (this->compression_ != RamCompression::NONE) {
+    ESP_LOGW(TAG_IMAGE, "%s is compressed in RAM (%s), no LVGL descriptor", this->file_path_.c_str(),
+             ram_compression_to_string(this->compression_));
+    dsc.data = nullptr;
+    return;
+  }
+  // Champs w/h de 11 bits en LVGL 8
+  if (width > 2047 || height > 2047) {
+    ESP_LOGW(TAG_IMAGE, "%dx%d is too large for an LVGL image descriptor: %s", width, height,
+             this->file_path_.c_str());
+    dsc.data = nullptr;
+    return;
+  }
+
+  // Même correspondance que image::Image pour LVGL 8
+  switch (this->format_) {
+    case ImageFormat::RGB888:
+      dsc.header.cf = LV_IMG_CF_RGB888;
+      break;
+    case ImageFormat::RGBA:
+      dsc.header.cf = LV_IMG_CF_RGBA8888;
+      break;
+    case ImageFormat::GRAYSCALE:
+      dsc.header.cf = LV_IMG_CF_ALPHA_8BIT;
+      break;
+    case ImageFormat::BINARY:
+      dsc.header.cf = LV_IMG_CF_ALPHA_1BIT;
+      break;
+    case ImageFormat::INDEXED8:
+      // LVGL attend la palette en tête des données
+      ESP_LOGW(TAG_IMAGE, "INDEXED8 has no LVGL descriptor, use RGB565 for %s", this->file_path_.c_str());
+      dsc.data = nullptr;
+      return;
+    case ImageFormat::RGB565:
+    default:
+      dsc.header.cf = LV_IMG_CF_TRUE_COLOR;
+#if LV_COLOR_DEPTH == 16
+      if (!this->lv_byte_order_warned_ && this->is_big_endian_() != (LV_COLOR_16_SWAP != 0)) {
+        this->lv_byte_order_warned_ = true;
+        ESP_LOGW(TAG_IMAGE, "%s: byte_order %s does not match LVGL (LV_COLOR_16_SWAP=%d), use byte_order: auto",
+                 this->file_path_.c_str(), this->is_big_endian_() ? "big_endian" : "little_endian", LV_COLOR_16_SWAP);
+      }
+#endif
+      break;
+  }
+  dsc.header.w = width;
+  dsc.header.h = height;
+  dsc.data_size = image_buffer_bytes(this->format_, width, height);
+  dsc.data = this->image_buffer_.data();
+}
+#endif
+
 bool SdImageComponent::ensure_loaded() {
   // Si déjà chargée, OK
   if (this->image_loaded_ && !this->image_buffer_.empty()) {
     return true;
   }
   
+  // Décodage en cours sur la tâche de chargement: ne jamais attendre, mais
+  // l'image est visible, son job passe devant ceux qui ne sont pas dessinés
+  if (this->load_pending_) {
+    if (this->storage_component_) {
+      this->storage_component_->promote_load(this);
+    }
+    return false;
+  }
+  bool background = this->storage_component_ && this->storage_component_->is_background_loading();
+  
   // Si auto_load global est activé, attendre que le système global charge
   if (this->should_auto_load()) {
     // En mode auto-load global, on fait un seul essai on-demand si pas encore chargé
     if (this->load_state_ == LoadState::NOT_LOADED) {
       ESP_LOGI(TAG_IMAGE, "Global auto-load active but image not loaded yet, trying once: %s", 
                this->file_path_.c_str());
+      if (background) {
+        this->request_load(this->file_path_, LOAD_PRIORITY_VISIBLE);
+        return false;
+      }
       return this->load_image();
     }
     return false; // Laisser le système global gérer
@@ -295,6 +950,11 @@ bool SdImageComponent::ensure_loaded() {
   
   ESP_LOGI(TAG_IMAGE, "On-demand loading: %s", this->file_path_.c_str());
   
+  if (background) {
+    this->request_load(this->file_path_, LOAD_PRIORITY_VISIBLE);
+    return false;
+  }
+  
   this->load_state_ = LoadState::LOADING;
   this->last_load_attempt_ = millis();
   
@@ -316,6 +976,23 @@ void SdImageComponent::dump_config() {
   ESP_LOGCONFIG(TAG_IMAGE, "  File: %s", this->file_path_.c_str());
   ESP_LOGCONFIG(TAG_IMAGE, "  Dimensions: %dx%d", this->image_width_, this->image_height_);
   ESP_LOGCONFIG(TAG_IMAGE, "  Format: %s", this->format_to_string().c_str());
+  ESP_LOGCONFIG(TAG_IMAGE, "  Placement: %s", placement_to_string(this->placement_));
+  if (this->ram_compression_ != RamCompression::NONE) {
+    ESP_LOGCONFIG(TAG_IMAGE, "  RAM compression: %s", ram_compression_to_string(this->ram_compression_));
+  }
+  if (this->output_format_ == ImageFormat::BINARY) {
+    ESP_LOGCONFIG(TAG_IMAGE, "  Dither: %s", this->quantizer_.is_dither() ? "YES" : "NO");
+  } else if (this->output_format_ == ImageFormat::INDEXED8) {
+    ESP_LOGCONFIG(TAG_IMAGE, "  Palette: %zu colors", this->quantizer_.get_palette_size());
+  }
+  if (this->viewport_enabled_) {
+    ESP_LOGCONFIG(TAG_IMAGE, "  Viewport: %dx%d at (%d, %d)", this->viewport_w_, this->viewport_h_,
+                  this->viewport_x_, this->viewport_y_);
+  }
+  if (this->slideshow_ != nullptr) {
+    ESP_LOGCONFIG(TAG_IMAGE, "  Slideshow: folder '%s', %u ms, shuffle %s", this->slideshow_->get_folder().c_str(),
+                  this->slideshow_->get_interval(), this->slideshow_->is_shuffle() ? "YES" : "NO");
+  }
   ESP_LOGCONFIG(TAG_IMAGE, "  Loaded: %s", this->image_loaded_ ? "YES" : "NO");
   if (this->image_loaded_) {
     ESP_LOGCONFIG(TAG_IMAGE, "  Buffer size: %zu bytes", this->image_buffer_.size());
@@ -325,33 +1002,76 @@ void SdImageComponent::dump_config() {
 }
 
 // REQUIRED VIRTUAL METHODS - These fix the linker error
+// Les getters servent à la mise en page: ils sondent l'en-tête au lieu de décoder
 int SdImageComponent::get_width() const {
-  // CORRECTION: Auto-load pour les getters aussi
-  if (!this->image_loaded_ && !const_cast<SdImageComponent*>(this)->ensure_loaded()) {
-    return this->resize_width_ > 0 ? this->resize_width_ : 1;
+  if (this->image_loaded_) {
+    return this->get_current_width();
+  }
+  if (this->resize_width_ > 0 && !this->viewport_enabled_) {
+    return this->resize_width_;
+  }
+  ImageInfo info;
+  if (!this->get_image_info(info)) {
+    return this->viewport_enabled_ ? this->viewport_w_ : std::max(this->resize_width_, 1);
   }
-  return this->get_current_width();
+  return this->viewport_enabled_ ? std::min(this->viewport_w_, info.width) : info.width;
 }
 
 int SdImageComponent::get_height() const {
-  // CORRECTION: Auto-load pour les getters aussi
-  if (!this->image_loaded_ && !const_cast<SdImageComponent*>(this)->ensure_loaded()) {
-    return this->resize_height_ > 0 ? this->resize_height_ : 1;
+  if (this->image_loaded_) {
+    return this->get_current_height();
+  }
+  if (this->resize_height_ > 0 && !this->viewport_enabled_) {
+    return this->resize_height_;
+  }
+  ImageInfo info;
+  if (!this->get_image_info(info)) {
+    return this->viewport_enabled_ ? this->viewport_h_ : std::max(this->resize_height_, 1);
+  }
+  return this->viewport_enabled_ ? std::min(this->viewport_h_, info.height) : info.height;
+}
+
+bool SdImageComponent::get_image_info(ImageInfo &info) const {
+  if (!this->storage_component_ || this->file_path_.empty()) {
+    return false;
+  }
+  if (this->storage_component_->probe_image(this->file_path_, info)) {
+    return true;
+  }
+  // Raw sans en-tête: seules les dimensions configurées sont connues
+  if (this->raw_width_ > 0) {
+    info = ImageInfo();
+    info.type = ImageFileType::RAW;
+    info.width = this->raw_width_;
+    info.height = this->raw_height_;
+    return true;
   }
-  return this->get_current_height();
+  return false;
 }
 
 // Compatibility methods for YAML configuration
+void SdImageComponent::set_format(ImageFormat format) {
+  this->output_format_ = format;
+  this->format_ = format;
+  this->quantizer_.set_format(format);
+}
+
 void SdImageComponent::set_output_format_string(const std::string &format) {
   if (format == "RGB565") {
-    this->format_ = ImageFormat::RGB565;
+    this->set_format(ImageFormat::RGB565);
   } else if (format == "RGB888") {
-    this->format_ = ImageFormat::RGB888;
+    this->set_format(ImageFormat::RGB888);
   } else if (format == "RGBA") {
-    this->format_ = ImageFormat::RGBA;
+    this->set_format(ImageFormat::RGBA);
+  } else if (format == "GRAYSCALE") {
+    this->set_format(ImageFormat::GRAYSCALE);
+  } else if (format == "BINARY") {
+    this->set_format(ImageFormat::BINARY);
+  } else if (format == "INDEXED8") {
+    this->set_format(ImageFormat::INDEXED8);
   } else {
     ESP_LOGW(TAG_IMAGE, "Unknown format: %s, using RGB565", format.c_str());
-    this->format_ = ImageFormat::RGB565;
+    this->set_format(ImageFormat::RGB565);
   }
 }
 
@@ -367,19 +1087,30 @@ void SdImageComponent::set_byte_order_string(const std::string &byte_order) {
 
 // Implementation of draw() method according to ESPHome source code
 void SdImageComponent::draw(int x, int y, display::Display *display, Color color_on, Color color_off) {
+  this->last_draw_ms_ = millis();
+  
   // CORRECTION: Auto-load intégré dans draw()
   if (!this->ensure_loaded()) {
-    ESP_LOGW(TAG_IMAGE, "Cannot draw: failed to load image %s", this->file_path_.c_str());
-    return;
+    if (this->load_pending_) {
+      ESP_LOGV(TAG_IMAGE, "Not drawn yet, still loading: %s", this->file_path_.c_str());
+    } else {
+      ESP_LOGW(TAG_IMAGE, "Cannot draw: failed to load image %s", this->file_path_.c_str());
+    }
+    return;
   }
   
-  ESP_LOGD(TAG_IMAGE, "Drawing SD image %dx%d at position %d,%d (Base: W:%d H:%d Data:%p)", 
+  ESP_LOGV(TAG_IMAGE, "Drawing SD image %dx%d at position %d,%d (Base: W:%d H:%d Data:%p)", 
            this->get_current_width(), this->get_current_height(), x, y,
            this->width_, this->height_, this->data_start_);
   
+  // Chemin rapide: lignes entières vers le driver, sans Color par pixel
+  if (this->blit_(x, y, 0, 0, this->get_current_width(), this->get_current_height(), display)) {
+    return;
+  }
+  
   // If base data is correct, use ESPHome's optimized method
   if (this->data_start_ && this->width_ > 0 && this->height_ > 0) {
-    ESP_LOGD(TAG_IMAGE, "Using ESPHome base image draw method");
+    ESP_LOGV(TAG_IMAGE, "Using ESPHome base image draw method");
     // Call base method that handles clipping and optimization
     image::Image::draw(x, y, display, color_on, color_off);
   } else {
@@ -402,8 +1133,65 @@ bool SdImageComponent::load_image_from_path(const std::string &path) {
     return false;
   }
   
-  // Unload previous image
-  this->unload_image();
+  // decode_ appartient à la tâche de chargement tant que le job n'est pas revenu
+  if (this->load_pending_) {
+    ESP_LOGW(TAG_IMAGE, "Background load in progress, synchronous load of %s refused", path.c_str());
+    return false;
+  }
+  
+  // L'image courante reste affichée pendant le décodage dans decode_ (buffer de
+  // staging); elle n'est remplacée qu'en cas de succès, par un simple échange
+  if (this->animated_ && this->is_gif_path_(path)) {
+    return this->start_animation_(path);
+  }
+  
+  bool success = this->read_and_decode_(path);
+  this->record_load_stats_(path);
+  if (!success) {
+    // Le slot de staging retourne à l'arène, l'ancienne image est intacte
+    this->decode_.buffer.release();
+    this->load_failed_callback_.call();
+    return false;
+  }
+  
+  this->stop_animation_();
+  this->publish_decoded_(this->decode_, path);
+  return true;
+}
+
+bool SdImageComponent::read_and_decode_(const std::string &path) {
+  // Lectures de cette tâche comptées dans decode_stats_ pendant le chargement
+  LoadStats &stats = this->decode_stats_;
+  LoadStatsScope scope(&stats);
+  stats.begin();
+  uint32_t start = micros();
+  bool success = this->decode_file_(path);
+  stats.total_us = micros() - start;
+  stats.finish(success);
+  return success;
+}
+
+bool SdImageComponent::decode_file_(const std::string &path) {
+  // Chaque décodeur choisit son format d'écriture avant d'allouer
+  this->decode_.format = ImageFormat::RGB565;
+  
+  // Entrée d'un asset pack: pas de stat/fopen par image
+  if (path.compare(0, strlen(ASSET_PACK_PREFIX), ASSET_PACK_PREFIX) == 0) {
+    this->decode_stats_.decoder = "asset pack";
+    if (this->viewport_enabled_) {
+      ESP_LOGW(TAG_IMAGE, "Viewport ignored for asset pack entry %s", path.c_str());
+    }
+    if (!this->load_from_asset_pack(path.substr(strlen(ASSET_PACK_PREFIX)))) {
+      ESP_LOGE(TAG_IMAGE, "Failed to load asset: %s", path.c_str());
+      return false;
+    }
+    return this->convert_decoded_();
+  }
+  
+  // Viewport: décodage en streaming, seule la fenêtre arrive en RAM
+  if (this->viewport_enabled_) {
+    return this->decode_viewport_(path);
+  }
   
   // Check file existence
   if (!this->storage_component_->file_exists_direct(path)) {
@@ -417,6 +1205,34 @@ bool SdImageComponent::load_image_from_path(const std::string &path) {
     return false;
   }
   
+  // BMP/raw: pixels lus directement dans le buffer, le fichier n'est jamais copié en RAM
+  std::string full_path = this->storage_component_->get_root_path() + path;
+  RawLayout layout;
+  FILE *raw_file = this->open_raw_(full_path, layout);
+  if (raw_file != nullptr) {
+    this->decode_stats_.decoder = "BMP/raw";
+    bool success = this->load_raw_(layout, [raw_file](uint32_t offset, uint8_t *dst, size_t len) {
+      return read_file_at(raw_file, offset, dst, len);
+    });
+    fclose(raw_file);
+    if (!success) {
+      ESP_LOGE(TAG_IMAGE, "Failed to read raw image: %s", path.c_str());
+      return false;
+    }
+    return this->convert_decoded_();
+  }
+  
+  // PNG: décodé en flux depuis la SD, le fichier compressé n'est jamais entier en RAM
+  uint8_t head[32];
+  size_t head_size = read_file_head(full_path, head, sizeof(head));
+  if (this->is_png_data(std::vector<uint8_t>(head, head + head_size))) {
+    if (!this->decode_png_file_(full_path, png_is_interlaced(head, head_size))) {
+      ESP_LOGE(TAG_IMAGE, "Failed to decode image: %s", path.c_str());
+      return false;
+    }
+    return this->convert_decoded_();
+  }
+  
   // Read file data
   std::vector<uint8_t> file_data = this->storage_component_->read_file_direct(path);
   if (file_data.empty()) {
@@ -425,6 +1241,7 @@ bool SdImageComponent::load_image_from_path(const std::string &path) {
   }
   
   ESP_LOGI(TAG_IMAGE, "Read %zu bytes from file", file_data.size());
+  this->decode_stats_.sample_heap();
   
   // Show first few bytes for debugging
   if (file_data.size() >= 16) {
@@ -441,22 +1258,631 @@ bool SdImageComponent::load_image_from_path(const std::string &path) {
     return false;
   }
   
+  return this->convert_decoded_();
+}
+
+void SdImageComponent::publish_decoded_(DecodeTarget &source, const std::string &path) {
+  // Bascule atomique vu de draw(): l'ancien slot est rendu à l'arène ici
+  this->image_buffer_ = std::move(source.buffer);
+  this->image_width_ = source.width;
+  this->image_height_ = source.height;
+  this->format_ = source.format;
+  this->compression_ = source.compression;
+  if (is_compact_format(this->format_)) {
+    this->pixel_ops_ = nullptr;  // lu par quantizer_
+  } else {
+    this->pixel_ops_ = source.ops != nullptr ? source.ops : &get_pixel_ops(this->format_, this->byte_order_);
+  }
+  
   this->file_path_ = path;
   this->image_loaded_ = true;
+  this->showing_preview_ = false;
+  this->evicted_ = false;
+  this->load_state_ = LoadState::LOADED;
+  this->load_retry_count_ = 0;
   
   // Finalize loading by updating base properties
   this->finalize_image_load();
   
+  if (this->storage_component_) {
+    this->storage_component_->notify_memory_changed();
+  }
+  
   ESP_LOGI(TAG_IMAGE, "Image loaded successfully: %dx%d, %zu bytes", 
            this->image_width_, this->image_height_, this->image_buffer_.size());
+  this->loaded_callback_.call();
+}
+
+void SdImageComponent::record_load_stats_(const std::string &path) {
+  // decode_stats_ n'est plus touché par la tâche de chargement: copie sur la loop
+  this->load_stats_ = this->decode_stats_;
+  this->load_stats_path_ = path;
+  this->load_count_++;
+  if (!this->load_stats_.success) {
+    this->load_failures_++;
+  }
+  if (this->storage_component_) {
+    this->storage_component_->record_load(this, path, this->load_stats_);
+  }
+}
+
+bool SdImageComponent::request_load(const std::string &path, LoadPriority priority) {
+  // Une animation ne décode que sa première frame au démarrage: reste sur la loop
+  if (!this->storage_component_ || !this->storage_component_->is_background_loading() ||
+      (this->animated_ && this->is_gif_path_(path))) {
+    return this->load_image_from_path(path);
+  }
+  
+  if (this->load_pending_) {
+    // Job déjà en file: il hérite de l'urgence de la demande
+    if (priority == LOAD_PRIORITY_VISIBLE) {
+      this->storage_component_->promote_load(this);
+    }
+    // Chemin qui sera publié au retour du job en vol
+    const std::string &queued = this->deferred_load_.empty() ? this->pending_load_ : this->deferred_load_;
+    if (this->prefetch_pending_ || path != queued) {
+      // Préchargement ou autre fichier en vol: abandonné, ce chargement part à son retour
+      this->load_generation_++;
+      this->deferred_load_ = path;
+      this->deferred_priority_ = priority;
+      ESP_LOGD(TAG_IMAGE, "Load of %s deferred until the job in flight returns", path.c_str());
+      return true;
+    }
+    ESP_LOGD(TAG_IMAGE, "Load already queued for %s", path.c_str());
+    return true;
+  }
+  
+  // Aperçu: la vignette EXIF (quelques Ko) tout de suite, sinon le décodage 1/8
+  // part en premier passage du job, jamais sur la loop (draw() peut nous appeler)
+  bool preview_stage = false;
+  if (this->progressive_preview_ && !this->viewport_enabled_ &&
+      path.compare(0, strlen(ASSET_PACK_PREFIX), ASSET_PACK_PREFIX) != 0) {
+    if (this->decode_preview(path, true)) {
+      this->show_preview_(path);
+    } else {
+      ImageInfo info;
+      int preview_width, preview_height;
+      preview_stage = this->storage_component_->has_loader_workers() &&
+                      this->preview_target_(path, info, preview_width, preview_height);
+    }
+  }
+  
+  this->load_pending_ = true;
+  this->pending_load_ = path;
+  this->load_state_ = LoadState::LOADING;
+  this->last_load_attempt_ = millis();
+  
+  if (!this->storage_component_->submit_load(this, path, this->load_generation_, priority, preview_stage)) {
+    this->load_pending_ = false;
+    return this->load_image_from_path(path);
+  }
+  
+  ESP_LOGD(TAG_IMAGE, "Queued background load: %s", path.c_str());
+  return true;
+}
+
+bool SdImageComponent::decode_in_background(const std::string &path) {
+  this->decode_.background = true;
+  bool success = this->read_and_decode_(path);
+  this->decode_.background = false;
+  
+  if (!success) {
+    this->decode_.buffer.release();
+  }
+  return success;
+}
+
+void SdImageComponent::complete_background_load(const LoadJob &job) {
+  if (!job.preview) {
+    this->record_load_stats_(job.path);
+  }
+  this->load_pending_ = false;
+  this->prefetch_pending_ = false;
+  
+  // Déchargée (ou rechargée ailleurs) pendant le décodage: résultat périmé
+  if (job.generation != this->load_generation_) {
+    ESP_LOGD(TAG_IMAGE, "Dropping stale background load of %s", job.path.c_str());
+    this->decode_.buffer.release();
+    this->preview_.release();
+    if (!this->deferred_load_.empty()) {
+      std::string path = std::move(this->deferred_load_);
+      this->deferred_load_.clear();
+      this->request_load(path, this->deferred_priority_);
+    }
+    return;
+  }
+  
+  if (job.preview) {
+    this->complete_preview_(job);
+    return;
+  }
+  
+  if (job.prefetch) {
+    this->complete_prefetch_(job);
+    return;
+  }
+  
+  bool success = job.success;
+  
+  // Le budget n'a pas pu être réservé depuis la tâche: c'est ici qu'on évince
+  if (success && this->storage_component_ &&
+      !this->storage_component_->reserve_image_memory(this, this->decode_.buffer.size() + this->staged_.buffer.size())) {
+    ESP_LOGE(TAG_IMAGE, "Memory budget refused %zu bytes for %s", this->decode_.buffer.size(), job.path.c_str());
+    success = false;
+  }
+  
+  if (!success) {
+    this->decode_.buffer.release();
+    this->load_state_ = LoadState::FAILED;
+    this->load_retry_count_++;
+    ESP_LOGW(TAG_IMAGE, "Background load failed: %s", job.path.c_str());
+    this->load_failed_callback_.call();
+    return;
+  }
   
+  this->stop_animation_();
+  this->publish_decoded_(this->decode_, job.path);
+}
+
+// =====================================================
+// Sliced Decoding (loop principale, sans worker)
+// =====================================================
+
+bool SdImageComponent::begin_sliced_decode(const std::string &path) {
+  this->sliced_.path = path;
+  this->decode_.background = true;
+  this->decode_.format = ImageFormat::RGB565;
+  
+  // Seul le temps passé dans les tranches compte, pas l'attente entre deux
+  LoadStats &stats = this->decode_stats_;
+  LoadStatsScope scope(&stats);
+  stats.begin();
+  uint32_t start = micros();
+  bool started = this->start_sliced_decode_();
+  stats.total_us += micros() - start;
+  if (!started) {
+    stats.finish(false);
+    this->end_sliced_decode_(false);
+    return false;
+  }
   return true;
 }
 
+bool SdImageComponent::start_sliced_decode_() {
+  SlicedDecode &sliced = this->sliced_;
+  const std::string &path = sliced.path;
+  if (!this->storage_component_ || this->viewport_enabled_ ||
+      path.compare(0, strlen(ASSET_PACK_PREFIX), ASSET_PACK_PREFIX) == 0) {
+    return true;
+  }
+  std::string full_path = this->storage_component_->get_root_path() + path;
+  
+  sliced.file = this->open_raw_(full_path, sliced.layout);
+  if (sliced.file != nullptr) {
+    sliced.type = FileType::RAW;
+    this->decode_stats_.decoder = "BMP/raw";
+    if (!this->begin_raw_target_(sliced.layout, sliced.direct)) {
+      return false;
+    }
+    if (!sliced.direct) {
+      sliced.chunk.resize(sliced.layout.width * raw_pixel_size(sliced.layout.pixels));
+      sliced.rgba.resize(sliced.layout.width * 4);
+    }
+    return true;
+  }
+  
+  // Fichier absent ou illisible: read_and_decode_ le signale au premier pas
+  uint8_t head[32];
+  size_t head_size = read_file_head(full_path, head, sizeof(head));
+  std::vector<uint8_t> header(head, head + head_size);
+  
+  if (this->is_qoi_data(header)) {
+    sliced.type = FileType::QOI;
+    this->decode_stats_.decoder = "QOI";
+    sliced.file = fopen(full_path.c_str(), "rb");
+    if (!sliced.file) {
+      ESP_LOGE(TAG_IMAGE, "Failed to open QOI: %s", full_path.c_str());
+      return false;
+    }
+    sliced.qoi = new QoiDecoder();
+    if (!sliced.qoi->begin(sliced.file)) {
+      ESP_LOGE(TAG_IMAGE, "Invalid QOI header");
+      return false;
+    }
+    if (!this->begin_qoi_target_(*sliced.qoi)) {
+      return false;
+    }
+    sliced.rgba.resize(this->decode_.width * 4);
+    return true;
+  }
+  
+#ifdef USE_PNGLE
+  bool pngle_stream = this->is_png_data(header);
+#ifdef USE_PNGDEC
+  pngle_stream = pngle_stream && png_is_interlaced(head, head_size);
+#endif
+  if (pngle_stream) {
+    sliced.type = FileType::PNG;
+    this->decode_stats_.decoder = "pngle";
+    sliced.file = fopen(full_path.c_str(), "rb");
+    if (!sliced.file) {
+      ESP_LOGE(TAG_IMAGE, "Failed to open PNG: %s", full_path.c_str());
+      return false;
+    }
+    sliced.chunk.resize(PNGLE_CHUNK_SIZE);
+    return this->begin_png_decoder_();
+  }
+#endif
+  return true;
+}
+
+bool SdImageComponent::step_sliced_decode(uint32_t deadline_us, bool &success) {
+  SlicedDecode &sliced = this->sliced_;
+  LoadStats &stats = this->decode_stats_;
+  LoadStatsScope scope(&stats);
+  uint32_t start = micros();
+  bool ok = true;
+  bool done;
+  
+  switch (sliced.type) {
+    case FileType::QOI: {
+      int width = sliced.qoi->get_header().width;
+      int height = sliced.qoi->get_header().height;
+      do {
+        ok = sliced.qoi->decode_row(sliced.rgba.data());
+        if (!ok) {
+          ESP_LOGE(TAG_IMAGE, "QOI data truncated at row %d", sliced.row);
+          break;
+        }
+        this->put_rgba_row_(sliced.row++, sliced.rgba.data(), width);
+      } while (sliced.row < height && slice_time_left(deadline_us));
+      done = !ok || sliced.row == height;
+      ok = ok && (!done || this->finish_resize_("QOI", width, height));
+      break;
+    }
+    
+    case FileType::RAW: {
+      FILE *file = sliced.file;
+      RawReadFn read = [file](uint32_t offset, uint8_t *dst, size_t len) {
+        return read_file_at(file, offset, dst, len);
+      };
+      do {
+        ok = this->read_raw_row_(sliced.layout, sliced.row++, sliced.direct, read, sliced.chunk.data(),
+                                 sliced.rgba.data());
+      } while (ok && sliced.row < sliced.layout.height && slice_time_left(deadline_us));
+      done = !ok || sliced.row == sliced.layout.height;
+      ok = ok && (!done || this->finish_raw_(sliced.layout, sliced.direct));
+      break;
+    }
+    
+#ifdef USE_PNGLE
+    case FileType::PNG: {
+      int result;
+      do {
+        result = feed_pngle_chunk(this->png_decoder_, sliced.file, sliced.chunk.data(), sliced.chunk.size(),
+                                  sliced.pending);
+      } while (result > 0 && slice_time_left(deadline_us));
+      done = result <= 0;
+      ok = result == 0;
+      // Fichier tronqué: pngle attend encore des données à la fin du flux
+      if (done && ok && (!this->png_done_ || this->decode_.buffer.empty())) {
+        ESP_LOGE(TAG_IMAGE, "PNG incomplete: %s", sliced.path.c_str());
+        ok = false;
+      }
+      break;
+    }
+#endif
+    
+    default:
+      // Le décodeur mène sa propre boucle: tout le décodage dans ce pas (et sa mesure)
+      success = this->read_and_decode_(sliced.path);
+      this->end_sliced_decode_(success);
+      return true;
+  }
+  
+  if (!done) {
+    stats.total_us += micros() - start;
+    return false;
+  }
+  success = ok && this->convert_decoded_();
+  stats.total_us += micros() - start;
+  stats.finish(success);
+  this->end_sliced_decode_(success);
+  return true;
+}
+
+void SdImageComponent::end_sliced_decode_(bool success) {
+  SlicedDecode &sliced = this->sliced_;
+#ifdef USE_PNGLE
+  if (sliced.type == FileType::PNG && this->png_decoder_) {
+    pngle_destroy(this->png_decoder_);
+    this->png_decoder_ = nullptr;
+  }
+#endif
+  if (sliced.file) {
+    fclose(sliced.file);
+  }
+  delete sliced.qoi;
+  sliced = SlicedDecode();
+  
+  this->decode_.background = false;
+  if (!success) {
+    this->decode_.buffer.release();
+  }
+}
+
+// =====================================================
+// Prefetch (buffer arrière)
+// =====================================================
+
+bool SdImageComponent::prefetch(const std::string &path) {
+  // Viewport et GIF animé dépendent de l'état affiché: pas de décodage à l'avance
+  if (!this->storage_component_ || !this->storage_component_->is_background_loading() || this->load_pending_ ||
+      this->viewport_enabled_ || (this->animated_ && this->is_gif_path_(path))) {
+    return false;
+  }
+  if (this->is_prefetched(path)) {
+    return true;
+  }
+  
+  this->discard_prefetched();
+  this->prefetch_failed_path_.clear();
+  this->load_pending_ = true;
+  this->prefetch_pending_ = true;
+  if (!this->storage_component_->submit_load(this, path, this->load_generation_, LOAD_PRIORITY_PREFETCH)) {
+    this->load_pending_ = false;
+    this->prefetch_pending_ = false;
+    return false;
+  }
+  ESP_LOGD(TAG_IMAGE, "Queued prefetch: %s", path.c_str());
+  return true;
+}
+
+void SdImageComponent::complete_prefetch_(const LoadJob &job) {
+  // L'image affichée reste en place: le budget doit contenir les deux
+  bool success = job.success;
+  if (success && this->storage_component_ &&
+      !this->storage_component_->reserve_image_memory(this, this->image_buffer_.size() + this->decode_.buffer.size())) {
+    ESP_LOGW(TAG_IMAGE, "Memory budget refused prefetch of %s (%zu bytes)", job.path.c_str(),
+             this->decode_.buffer.size());
+    success = false;
+  }
+  if (!success) {
+    this->decode_.buffer.release();
+    this->prefetch_failed_path_ = job.path;
+    ESP_LOGW(TAG_IMAGE, "Prefetch failed: %s", job.path.c_str());
+    return;
+  }
+  
+  this->staged_.buffer = std::move(this->decode_.buffer);
+  this->staged_.width = this->decode_.width;
+  this->staged_.height = this->decode_.height;
+  this->staged_.format = this->decode_.format;
+  this->staged_.compression = this->decode_.compression;
+  this->staged_.ops = this->decode_.ops;
+  this->staged_path_ = job.path;
+  if (this->storage_component_) {
+    this->storage_component_->notify_memory_changed();
+  }
+  ESP_LOGD(TAG_IMAGE, "Prefetched %s: %dx%d, %zu bytes", job.path.c_str(), this->staged_.width,
+           this->staged_.height, this->staged_.buffer.size());
+}
+
+bool SdImageComponent::show_prefetched() {
+  if (this->staged_.buffer.empty()) {
+    return false;
+  }
+  this->stop_animation_();
+  std::string path = std::move(this->staged_path_);
+  this->staged_path_.clear();
+  // Échange de pointeurs: aucune copie de pixels sur la loop
+  this->publish_decoded_(this->staged_, path);
+  return true;
+}
+
+void SdImageComponent::discard_prefetched() {
+  if (this->staged_.buffer.empty()) {
+    return;
+  }
+  this->staged_.buffer.release();
+  this->staged_path_.clear();
+  if (this->storage_component_) {
+    this->storage_component_->notify_memory_changed();
+  }
+}
+
+Slideshow *SdImageComponent::enable_slideshow() {
+  if (this->slideshow_ == nullptr) {
+    this->slideshow_ = new Slideshow(this);
+  }
+  return this->slideshow_;
+}
+
+// Bilinéaire RGB565 en virgule fixe 8 bits (coins alignés): passe verticale sur
+// toute la ligne source (poids unique, vectorisée), puis passe horizontale
+static void bilinear_resize565(const uint8_t *src, int src_width, int src_height, uint8_t *dst, int dst_width,
+                               int dst_height, bool big_endian) {
+  auto source_pos = [](int d, int dst_size, int src_size) -> uint32_t {
+    return dst_size > 1 ? (uint32_t) d * (src_size - 1) * 256 / (dst_size - 1) : 0;
+  };
+  std::vector<uint16_t> x_map(dst_width);
+  std::vector<uint16_t> x_weight(dst_width);
+  for (int dst_x = 0; dst_x < dst_width; dst_x++) {
+    uint32_t pos = source_pos(dst_x, dst_width, src_width);
+    x_map[dst_x] = pos >> 8;
+    x_weight[dst_x] = pos & 0xFF;
+  }
+  
+  std::vector<uint8_t> blended(src_width * 2);
+  for (int dst_y = 0; dst_y < dst_height; dst_y++) {
+    uint32_t pos = source_pos(dst_y, dst_height, src_height);
+    int src_y0 = pos >> 8;
+    int src_y1 = std::min(src_y0 + 1, src_height - 1);
+    kernels::blend565(src + src_y0 * src_width * 2, src + src_y1 * src_width * 2, blended.data(), src_width,
+                      pos & 0xFF, big_endian);
+    kernels::resample565(blended.data(), src_width, x_map.data(), x_weight.data(), dst + dst_y * dst_width * 2,
+                         dst_width, big_endian);
+    
+    if (dst_y % 16 == 0) {
+      decode_yield();
+    }
+  }
+}
+
+// =====================================================
+// Progressive preview
+// =====================================================
+
+bool SdImageComponent::preview_target_(const std::string &path, ImageInfo &info, int &width, int &height) {
+  if (!this->storage_component_->probe_image(path, info) || info.type != ImageFileType::JPEG) {
+    return false;
+  }
+  width = this->resize_width_ > 0 ? this->resize_width_ : info.width;
+  height = this->resize_height_ > 0 ? this->resize_height_ : info.height;
+  // Le décodage complet refusera aussi ces dimensions
+  return width <= 2048 && height <= 2048;
+}
+
+bool SdImageComponent::decode_preview(const std::string &path, bool exif_only) {
+  ImageInfo info;
+  int dst_width, dst_height;
+  if (!this->preview_target_(path, info, dst_width, dst_height)) {
+    return false;
+  }
+  
+  uint32_t start = millis();
+  std::string full_path = this->storage_component_->get_root_path() + path;
+  JPEGDEC *jpeg = new JPEGDEC();
+  if (!jpeg->open(full_path.c_str(), stream_open, stream_close, stream_read<JPEGFILE>, stream_seek<JPEGFILE>,
+                  SdImageComponent::jpeg_preview_callback)) {
+    delete jpeg;
+    return false;
+  }
+  jpeg->setUserPointer(this);
+  jpeg->setPixelType(this->is_big_endian_() ? RGB565_BIG_ENDIAN : RGB565_LITTLE_ENDIAN);
+  
+  // Vignette EXIF si son cadrage est celui de la photo (quelques Ko à décoder),
+  // sinon 1/8: seuls les coefficients DC, sans IDCT, mais tout le fichier est lu
+  int options = JPEG_SCALE_EIGHTH;
+  this->preview_src_width_ = (info.width + 7) / 8;
+  this->preview_src_height_ = (info.height + 7) / 8;
+  const char *source = "1/8 scale";
+  if (jpeg->hasThumb() && jpeg->getThumbWidth() > 0 && jpeg->getThumbHeight() > 0) {
+    int thumb_w = jpeg->getThumbWidth();
+    int thumb_h = jpeg->getThumbHeight();
+    int aspect_error = std::abs(thumb_w * info.height - thumb_h * info.width);
+    if (aspect_error * 50 <= thumb_w * info.height) {  // < 2 %
+      options = JPEG_EXIF_THUMBNAIL;
+      this->preview_src_width_ = thumb_w;
+      this->preview_src_height_ = thumb_h;
+      source = "EXIF thumbnail";
+    }
+  }
+  if (exif_only && options != JPEG_EXIF_THUMBNAIL) {
+    jpeg->close();
+    delete jpeg;
+    return false;
+  }
+  
+  // Budget réservé à la publication (show_preview_), jamais depuis la tâche
+  bool success = this->preview_src_.allocate(this->preview_src_width_ * this->preview_src_height_ * 2,
+                                             this->placement_) &&
+                 this->preview_.allocate((size_t) dst_width * dst_height * 2, this->placement_);
+  // Pas de compactage d'arène pendant qu'on écrit dans ces deux buffers
+  ImageArena::pin();
+  success = success && jpeg->decode(0, 0, options) == 1;
+  if (success) {
+    bilinear_resize565(this->preview_src_.data(), this->preview_src_width_, this->preview_src_height_,
+                       this->preview_.data(), dst_width, dst_height, this->is_big_endian_());
+  }
+  ImageArena::unpin();
+  jpeg->close();
+  delete jpeg;
+  this->preview_src_.release();
+  if (!success) {
+    this->preview_.release();
+    ESP_LOGD(TAG_IMAGE, "No preview for %s", path.c_str());
+    return false;
+  }
+  
+  this->preview_width_ = dst_width;
+  this->preview_height_ = dst_height;
+  ESP_LOGD(TAG_IMAGE, "Preview of %s from %s (%dx%d) decoded in %u ms", path.c_str(), source,
+           this->preview_src_width_, this->preview_src_height_, millis() - start);
+  return true;
+}
+
+bool SdImageComponent::show_preview_(const std::string &path) {
+  if (!this->storage_component_->reserve_image_memory(this, this->preview_.size() + this->staged_.buffer.size())) {
+    ESP_LOGD(TAG_IMAGE, "Memory budget refused the preview of %s", path.c_str());
+    this->preview_.release();
+    return false;
+  }
+  
+  // Publiée comme une image normale; publish_decoded_ la remplacera. Une
+  // animation en cours écrirait sa frame (taille du canvas) dans ce buffer
+  this->stop_animation_();
+  this->playing_ = false;
+  this->image_buffer_ = std::move(this->preview_);
+  this->image_width_ = this->preview_width_;
+  this->image_height_ = this->preview_height_;
+  this->format_ = ImageFormat::RGB565;
+  this->compression_ = RamCompression::NONE;
+  this->pixel_ops_ = &get_pixel_ops(ImageFormat::RGB565, this->byte_order_);
+  this->file_path_ = path;
+  this->image_loaded_ = true;
+  this->showing_preview_ = true;
+  this->evicted_ = false;
+  this->finalize_image_load();
+  this->storage_component_->notify_memory_changed();
+  
+  ESP_LOGI(TAG_IMAGE, "Showing preview of %s (%dx%d)", path.c_str(), this->image_width_, this->image_height_);
+  this->preview_callback_.call();
+  return true;
+}
+
+void SdImageComponent::complete_preview_(const LoadJob &job) {
+  if (job.success) {
+    this->show_preview_(job.path);
+  }
+  
+  // Deuxième passage: le décodage complet, même génération et même échéance
+  LoadJob full = job;
+  full.preview = false;
+  full.success = false;
+  this->load_pending_ = true;
+  if (!this->storage_component_->resubmit_load(std::move(full))) {
+    this->load_pending_ = false;
+    this->load_image_from_path(job.path);
+  }
+}
+
+int SdImageComponent::jpeg_preview_callback(JPEGDRAW *pDraw) {
+  if (!pDraw || !pDraw->pUser || !pDraw->pPixels) {
+    return 0;
+  }
+  SdImageComponent *component = static_cast<SdImageComponent *>(pDraw->pUser);
+  int w = component->preview_src_width_;
+  int x_end = std::min(pDraw->x + pDraw->iWidth, w);
+  int y_end = std::min(pDraw->y + pDraw->iHeight, component->preview_src_height_);
+  if (pDraw->x >= x_end) {
+    return 1;
+  }
+  const uint16_t *pixels = (const uint16_t *) pDraw->pPixels;
+  uint8_t *dst = component->preview_src_.data();
+  for (int y = pDraw->y; y < y_end; y++) {
+    memcpy(dst + (y * w + pDraw->x) * 2, pixels + (y - pDraw->y) * pDraw->iWidth, (x_end - pDraw->x) * 2);
+  }
+  return 1;
+}
+
 void SdImageComponent::unload_image() {
-  this->image_buffer_.clear();
-  this->image_buffer_.shrink_to_fit();
+  this->stop_animation_();
+  
+  // Le slot retourne à l'arène et sera réutilisé au prochain chargement de même taille
+  this->image_buffer_.release();
   this->image_loaded_ = false;
+  this->showing_preview_ = false;
   this->image_width_ = 0;
   this->image_height_ = 0;
   
@@ -465,16 +1891,558 @@ void SdImageComponent::unload_image() {
   this->height_ = 0;
   this->data_start_ = nullptr;
   this->bpp_ = 0;
+#ifdef USE_LVGL
+  this->update_lv_img_dsc_();
+#endif
   
   // Reset load state
   this->load_state_ = LoadState::NOT_LOADED;
   this->load_retry_count_ = 0;
+  this->evicted_ = false;
+  // Un chargement de fond encore en vol ne sera pas publié
+  this->load_generation_++;
+  this->deferred_load_.clear();
+  this->staged_.buffer.release();
+  this->staged_path_.clear();
+  
+  if (this->storage_component_) {
+    this->storage_component_->notify_memory_changed();
+  }
 }
 
-bool SdImageComponent::reload_image() {
-  std::string path = this->file_path_;
+void SdImageComponent::evict() {
   this->unload_image();
-  return this->load_image_from_path(path);
+  // Rechargement transparent au prochain draw() via ensure_loaded()
+  this->evicted_ = true;
+}
+
+// =====================================================
+// GIF Animation
+// =====================================================
+
+bool SdImageComponent::is_gif_path_(const std::string &path) const {
+  if (path.size() < 4) {
+    return false;
+  }
+  std::string ext = path.substr(path.size() - 4);
+  std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+  return ext == ".gif";
+}
+
+void SdImageComponent::stop_animation_() {
+#ifdef USE_ANIMATEDGIF
+  if (this->gif_player_ != nullptr) {
+    delete this->gif_player_;  // ferme le fichier
+    this->gif_player_ = nullptr;
+  }
+#endif
+}
+
+bool SdImageComponent::start_animation_(const std::string &path) {
+#ifdef USE_ANIMATEDGIF
+  GifPlayer *player = new GifPlayer();
+  if (!player->open(this->storage_component_->get_root_path() + path, this->is_big_endian_())) {
+    delete player;
+    this->load_failed_callback_.call();
+    return false;
+  }
+  
+  // Canvas RGB565 à la taille de sortie, les frames y sont écrites ligne par ligne
+  this->decode_.format = ImageFormat::RGB565;
+  this->decode_.width = this->resize_width_ > 0 ? this->resize_width_ : player->get_width();
+  this->decode_.height = this->resize_height_ > 0 ? this->resize_height_ : player->get_height();
+  player->set_output(this->decode_.width, this->decode_.height);
+  
+  int delay = -1;
+  if (this->allocate_image_buffer()) {
+    delay = player->next_frame(this->decode_.buffer.data(), this->animation_loop_);
+  }
+  if (delay < 0) {
+    delete player;
+    this->decode_.buffer.release();
+    this->load_failed_callback_.call();
+    return false;
+  }
+  
+  // Une seule frame: image fixe, inutile de garder le fichier ouvert
+  if (player->get_frame_count() == 1) {
+    delete player;
+    player = nullptr;
+  }
+  this->stop_animation_();
+  this->gif_player_ = player;
+  this->publish_decoded_(this->decode_, path);
+  this->playing_ = player != nullptr && delay > 0;
+  this->next_frame_ms_ = millis() + delay;
+  
+  if (player != nullptr) {
+    ESP_LOGI(TAG_IMAGE, "Animation started: %s (%dx%d canvas)", path.c_str(), this->image_width_, this->image_height_);
+  }
+  return true;
+#else
+  ESP_LOGE(TAG_IMAGE, "GIF animation needs GIF support (USE_ANIMATEDGIF not defined)");
+  return false;
+#endif
+}
+
+void SdImageComponent::advance_animation_() {
+#ifdef USE_ANIMATEDGIF
+  int delay = this->gif_player_->next_frame(this->image_buffer_.data(), this->animation_loop_);
+  if (delay < 0) {
+    ESP_LOGW(TAG_IMAGE, "Animation stopped on decode error: %s", this->file_path_.c_str());
+    this->playing_ = false;
+    return;
+  }
+  if (delay == 0) {
+    ESP_LOGD(TAG_IMAGE, "Animation finished: %s", this->file_path_.c_str());
+    this->playing_ = false;
+    return;
+  }
+  
+  // Cadence du GIF sans dérive; si la loop a pris du retard, on repart de maintenant
+  uint32_t now = millis();
+  this->next_frame_ms_ += delay;
+  if ((int32_t) (now - this->next_frame_ms_) > delay) {
+    this->next_frame_ms_ = now + delay;
+  }
+#endif
+}
+
+void SdImageComponent::play() {
+  if (this->slideshow_ != nullptr) {
+    this->slideshow_->set_running(true);
+  }
+  if (this->gif_player_ == nullptr) {
+    if (this->slideshow_ == nullptr) {
+      ESP_LOGW(TAG_IMAGE, "Nothing to play: %s is not an animated GIF", this->file_path_.c_str());
+    }
+    return;
+  }
+  if (!this->playing_) {
+    this->playing_ = true;
+    this->next_frame_ms_ = millis();
+  }
+}
+
+void SdImageComponent::pause() {
+  this->playing_ = false;
+  if (this->slideshow_ != nullptr) {
+    this->slideshow_->set_running(false);
+  }
+}
+
+bool SdImageComponent::seek(int frame) {
+#ifdef USE_ANIMATEDGIF
+  if (this->gif_player_ == nullptr || this->image_buffer_.empty()) {
+    return false;
+  }
+  bool ok = this->gif_player_->seek(this->image_buffer_.data(), frame);
+  this->next_frame_ms_ = millis();
+  return ok;
+#else
+  return false;
+#endif
+}
+
+int SdImageComponent::get_frame_index() const {
+#ifdef USE_ANIMATEDGIF
+  return this->gif_player_ != nullptr ? this->gif_player_->get_frame_index() : 0;
+#else
+  return 0;
+#endif
+}
+
+bool SdImageComponent::get_frame_dirty_rect(int &x, int &y, int &w, int &h) const {
+#ifdef USE_ANIMATEDGIF
+  if (this->gif_player_ != nullptr) {
+    return this->gif_player_->get_dirty_rect(x, y, w, h);
+  }
+#endif
+  return false;
+}
+
+void SdImageComponent::draw_frame_update(int x, int y, display::Display *display) {
+  int rx, ry, rw, rh;
+  if (!this->image_loaded_ || !this->get_frame_dirty_rect(rx, ry, rw, rh)) {
+    return;
+  }
+  if (this->blit_(x + rx, y + ry, rx, ry, rw, rh, display)) {
+    return;
+  }
+  for (int img_y = ry; img_y < ry + rh; img_y++) {
+    for (int img_x = rx; img_x < rx + rw; img_x++) {
+      this->draw_pixel_at(display, x + img_x, y + img_y, img_x, img_y);
+    }
+  }
+}
+
+// =====================================================
+// Viewport (fenêtre sur une image plus grande que la RAM)
+// =====================================================
+
+void SdImageComponent::set_viewport(int x, int y, int width, int height) {
+  if (width <= 0 || height <= 0) {
+    ESP_LOGW(TAG_IMAGE, "Invalid viewport size: %dx%d", width, height);
+    return;
+  }
+  if (this->load_pending_) {
+    ESP_LOGW(TAG_IMAGE, "Background load in progress, viewport change refused");
+    return;
+  }
+  
+  // Même taille sur une image déjà décodée: simple déplacement
+  if (this->viewport_enabled_ && this->image_loaded_ && width == this->viewport_w_ && height == this->viewport_h_) {
+    this->pan_to(x, y);
+    return;
+  }
+  
+  this->viewport_enabled_ = true;
+  this->viewport_x_ = std::max(0, x);
+  this->viewport_y_ = std::max(0, y);
+  this->viewport_w_ = width;
+  this->viewport_h_ = height;
+  
+  if (this->image_loaded_) {
+    this->request_load(this->file_path_, LOAD_PRIORITY_VISIBLE);
+  }
+}
+
+void SdImageComponent::clear_viewport() {
+  if (!this->viewport_enabled_ || this->load_pending_) {
+    return;
+  }
+  this->viewport_enabled_ = false;
+  if (this->image_loaded_) {
+    this->request_load(this->file_path_, LOAD_PRIORITY_VISIBLE);
+  }
+}
+
+bool SdImageComponent::pan_to(int x, int y) {
+  if (!this->viewport_enabled_) {
+    ESP_LOGW(TAG_IMAGE, "pan: no viewport set on %s", this->file_path_.c_str());
+    return false;
+  }
+  if (this->load_pending_) {
+    ESP_LOGD(TAG_IMAGE, "pan: background load in progress");
+    return false;
+  }
+  
+  // Pas encore décodée: la position servira au prochain chargement
+  if (!this->image_loaded_ || this->image_buffer_.empty()) {
+    this->viewport_x_ = std::max(0, x);
+    this->viewport_y_ = std::max(0, y);
+    return true;
+  }
+  
+  int w = this->image_width_;
+  int h = this->image_height_;
+  x = std::max(0, std::min(x, this->source_width_ - w));
+  y = std::max(0, std::min(y, this->source_height_ - h));
+  int dx = x - this->viewport_x_;
+  int dy = y - this->viewport_y_;
+  if (dx == 0 && dy == 0) {
+    return true;
+  }
+  
+  // Déplacement d'au moins une fenêtre: rien à réutiliser
+  if (std::abs(dx) >= w || std::abs(dy) >= h) {
+    this->viewport_x_ = x;
+    this->viewport_y_ = y;
+    return this->request_load(this->file_path_, LOAD_PRIORITY_VISIBLE);
+  }
+  
+  // Décaler en place la partie encore visible
+  uint8_t *buf = this->image_buffer_.data();
+  size_t row_bytes = w * 2;
+  int copy_w = w - std::abs(dx);
+  int copy_h = h - std::abs(dy);
+  int src_col = dx > 0 ? dx : 0;
+  int dst_col = dx > 0 ? 0 : -dx;
+  int src_row = dy > 0 ? dy : 0;
+  int dst_row = dy > 0 ? 0 : -dy;
+  for (int i = 0; i < copy_h; i++) {
+    // Vers le haut: de haut en bas, vers le bas: de bas en haut (lignes qui se recouvrent)
+    int r = dy > 0 ? i : copy_h - 1 - i;
+    memmove(buf + (dst_row + r) * row_bytes + dst_col * 2, buf + (src_row + r) * row_bytes + src_col * 2, copy_w * 2);
+  }
+  this->viewport_x_ = x;
+  this->viewport_y_ = y;
+  
+  // Bandes découvertes, en coordonnées source: une horizontale pleine largeur,
+  // une verticale limitée aux lignes conservées
+  struct Strip {
+    int x0, y0, x1, y1;
+  };
+  Strip strips[2];
+  int strip_count = 0;
+  if (dy != 0) {
+    int y0 = dy > 0 ? y + h - dy : y;
+    strips[strip_count++] = {x, y0, x + w, y0 + std::abs(dy)};
+  }
+  if (dx != 0) {
+    int x0 = dx > 0 ? x + w - dx : x;
+    strips[strip_count++] = {x0, y + dst_row, x0 + std::abs(dx), y + dst_row + copy_h};
+  }
+  
+  std::string full_path = this->storage_component_->get_root_path() + this->file_path_;
+  uint32_t start = millis();
+  bool success = true;
+  ImageArena::pin();
+  for (int i = 0; i < strip_count && success; i++) {
+    const Strip &strip = strips[i];
+    // Fond noir sous les pixels transparents (GIF/PNG)
+    for (int sy = strip.y0; sy < strip.y1; sy++) {
+      memset(buf + (sy - y) * row_bytes + (strip.x0 - x) * 2, 0, (strip.x1 - strip.x0) * 2);
+    }
+    this->region_ = RegionPass();
+    this->region_.x0 = strip.x0;
+    this->region_.y0 = strip.y0;
+    this->region_.x1 = strip.x1;
+    this->region_.y1 = strip.y1;
+    this->region_.dst = buf;
+    this->region_.dst_x = x;
+    this->region_.dst_y = y;
+    this->region_.stride = w;
+    success = this->decode_region_(full_path, this->viewport_type_);
+  }
+  ImageArena::unpin();
+  
+  if (!success) {
+    ESP_LOGW(TAG_IMAGE, "Strip decode failed, reloading viewport of %s", this->file_path_.c_str());
+    return this->request_load(this->file_path_, LOAD_PRIORITY_VISIBLE);
+  }
+  ESP_LOGD(TAG_IMAGE, "Panned to (%d, %d): %d strip(s) in %u ms", x, y, strip_count, millis() - start);
+  return true;
+}
+
+bool SdImageComponent::decode_viewport_(const std::string &path) {
+  std::string full_path = this->storage_component_->get_root_path() + path;
+  
+  // La signature suffit: le fichier n'est jamais chargé en entier
+  FILE *file = fopen(full_path.c_str(), "rb");
+  if (!file) {
+    ESP_LOGE(TAG_IMAGE, "Image file not found: %s", path.c_str());
+    return false;
+  }
+  std::vector<uint8_t> header(RAW_HEADER_SIZE);
+  header.resize(fread(header.data(), 1, header.size(), file));
+  long file_size = fseek(file, 0, SEEK_END) == 0 ? ftell(file) : 0;
+  fclose(file);
+  
+  this->viewport_type_ = this->detect_file_type(header, file_size > 0 ? file_size : 0);
+  this->region_ = RegionPass();
+  this->region_.allocate = true;
+  
+  if (!this->decode_region_(full_path, this->viewport_type_)) {
+    ESP_LOGE(TAG_IMAGE, "Failed to decode viewport of %s", path.c_str());
+    return false;
+  }
+  
+  ESP_LOGI(TAG_IMAGE, "Viewport %dx%d at (%d, %d) decoded from %dx%d image", this->decode_.width,
+           this->decode_.height, this->viewport_x_, this->viewport_y_, this->source_width_, this->source_height_);
+  return true;
+}
+
+bool SdImageComponent::begin_region_target_(int src_width, int src_height) {
+  if (src_width <= 0 || src_height <= 0 || src_width > 8192 || src_height > 8192) {
+    ESP_LOGE(TAG_IMAGE, "Invalid source dimensions: %dx%d", src_width, src_height);
+    return false;
+  }
+  
+  if (!this->region_.allocate) {
+    // Passe de bande: le fichier ne doit pas avoir changé depuis le chargement
+    return src_width == this->source_width_ && src_height == this->source_height_;
+  }
+  
+  this->source_width_ = src_width;
+  this->source_height_ = src_height;
+  int w = std::min(this->viewport_w_, src_width);
+  int h = std::min(this->viewport_h_, src_height);
+  this->viewport_x_ = std::max(0, std::min(this->viewport_x_, src_width - w));
+  this->viewport_y_ = std::max(0, std::min(this->viewport_y_, src_height - h));
+  
+  this->decode_.width = w;
+  this->decode_.height = h;
+  this->decode_.format = ImageFormat::RGB565;
+  if (!this->allocate_image_buffer()) {
+    return false;
+  }
+  
+  this->region_.x0 = this->viewport_x_;
+  this->region_.y0 = this->viewport_y_;
+  this->region_.x1 = this->viewport_x_ + w;
+  this->region_.y1 = this->viewport_y_ + h;
+  this->region_.dst = this->decode_.buffer.data();
+  this->region_.dst_x = this->viewport_x_;
+  this->region_.dst_y = this->viewport_y_;
+  this->region_.stride = w;
+  return true;
+}
+
+void SdImageComponent::region_put_(int x, int y, uint16_t native) {
+  const RegionPass &pass = this->region_;
+  if (x < pass.x0 || x >= pass.x1 || y < pass.y0 || y >= pass.y1) {
+    return;
+  }
+  memcpy(pass.dst + ((y - pass.dst_y) * pass.stride + (x - pass.dst_x)) * 2, &native, 2);
+}
+
+bool SdImageComponent::decode_region_(const std::string &full_path, FileType type) {
+#ifdef USE_PNGDEC
+  // PNGdec par lignes, sauf l'Adam7 qu'il ne gère pas (pngle plus bas)
+  if (type == FileType::PNG && !png_file_interlaced(full_path)) {
+    this->decode_stats_.decoder = "PNGdec";
+    return this->decode_png_region_rows_(full_path);
+  }
+#endif
+  switch (type) {
+#ifdef USE_JPEGDEC
+    case FileType::JPEG: {
+      this->decode_stats_.decoder = "JPEGDEC";
+      JPEGDEC *jpeg = new JPEGDEC();
+      if (!jpeg->open(full_path.c_str(), stream_open, stream_close, stream_read<JPEGFILE>, stream_seek<JPEGFILE>,
+                      SdImageComponent::jpeg_region_callback)) {
+        ESP_LOGE(TAG_IMAGE, "Failed to open JPEG: %s", full_path.c_str());
+        delete jpeg;
+        return false;
+      }
+      jpeg->setUserPointer(this);
+      jpeg->setPixelType(this->is_big_endian_() ? RGB565_BIG_ENDIAN : RGB565_LITTLE_ENDIAN);
+      bool success = this->begin_region_target_(jpeg->getWidth(), jpeg->getHeight());
+      if (success) {
+        // Le callback renvoie 0 sous la fenêtre: decode() s'arrête là, en "échec"
+        success = jpeg->decode(0, 0, 0) == 1 || this->region_.done;
+      }
+      jpeg->close();
+      delete jpeg;
+      return success;
+    }
+#endif
+#ifdef USE_PNGLE
+    case FileType::PNG: {
+      this->decode_stats_.decoder = "pngle";
+      FILE *file = fopen(full_path.c_str(), "rb");
+      if (!file) {
+        ESP_LOGE(TAG_IMAGE, "Failed to open PNG: %s", full_path.c_str());
+        return false;
+      }
+      pngle_t *pngle = pngle_new();
+      if (!pngle) {
+        fclose(file);
+        return false;
+      }
+      pngle_set_init_callback(pngle, SdImageComponent::png_region_init_callback);
+      pngle_set_draw_callback(pngle, SdImageComponent::png_region_draw_callback);
+      pngle_set_user_data(pngle, this);
+      
+      // Lecture arrêtée après la dernière ligne utile
+      bool success = feed_pngle_file(pngle, file, &this->region_.done);
+      pngle_destroy(pngle);
+      fclose(file);
+      // Échec d'allocation dans le callback d'init: aucune destination
+      return success && this->region_.dst != nullptr;
+    }
+#endif
+#ifdef USE_ANIMATEDGIF
+    case FileType::GIF: {
+      this->decode_stats_.decoder = "AnimatedGIF";
+      ANIMATEDGIF *gif = new ANIMATEDGIF();
+      gif->begin(this->is_big_endian_() ? GIF_PALETTE_RGB565_BE : GIF_PALETTE_RGB565_LE);
+      if (!gif->open(full_path.c_str(), stream_open, stream_close, stream_read<GIFFILE>, stream_seek<GIFFILE>,
+                     SdImageComponent::gif_region_callback)) {
+        ESP_LOGE(TAG_IMAGE, "Failed to open GIF: %s", full_path.c_str());
+        delete gif;
+        return false;
+      }
+      // Première frame seulement; AnimatedGIF ne sait pas s'arrêter en cours de frame
+      bool success = this->begin_region_target_(gif->getCanvasWidth(), gif->getCanvasHeight()) &&
+                     gif->playFrame(false, nullptr, this) >= 0;
+      gif->close();
+      delete gif;
+      return success;
+    }
+#endif
+    case FileType::QOI: {
+      this->decode_stats_.decoder = "QOI";
+      FILE *file = fopen(full_path.c_str(), "rb");
+      if (!file) {
+        ESP_LOGE(TAG_IMAGE, "Failed to open QOI: %s", full_path.c_str());
+        return false;
+      }
+      QoiDecoder decoder;
+      bool success = decoder.begin(file) &&
+                     this->begin_region_target_(decoder.get_header().width, decoder.get_header().height);
+      if (success) {
+        // Lignes au-dessus de la fenêtre décodées puis ignorées, arrêt sous la fenêtre
+        const RegionPass &pass = this->region_;
+        std::vector<uint8_t> row(decoder.get_header().width * 4);
+        for (int y = 0; y < pass.y1 && success; y++) {
+          success = decoder.decode_row(row.data());
+          if (success && y >= pass.y0) {
+            kernels::rgba_to_rgb565(row.data() + pass.x0 * 4,
+                                    pass.dst + ((y - pass.dst_y) * pass.stride + (pass.x0 - pass.dst_x)) * 2,
+                                    pass.x1 - pass.x0, this->is_big_endian_());
+          }
+          if (y % 16 == 0) {
+            decode_yield();
+          }
+        }
+      }
+      fclose(file);
+      return success;
+    }
+    case FileType::BMP:
+    case FileType::RAW: {
+      this->decode_stats_.decoder = "BMP/raw";
+      RawLayout layout;
+      FILE *file = this->open_raw_(full_path, layout);
+      if (!file) {
+        ESP_LOGE(TAG_IMAGE, "Unsupported raw/BMP layout: %s", full_path.c_str());
+        return false;
+      }
+      bool success = this->begin_region_target_(layout.width, layout.height);
+      if (success) {
+        // Accès direct: seules les colonnes de la fenêtre sont lues, une lecture par ligne
+        const RegionPass &pass = this->region_;
+        int count = pass.x1 - pass.x0;
+        size_t pixel_size = raw_pixel_size(layout.pixels);
+        std::vector<uint8_t> src;
+        std::vector<uint8_t> rgba;
+        if (layout.pixels != RawPixels::RGB565_LE) {
+          src.resize(count * pixel_size);
+          rgba.resize(count * 4);
+        }
+        for (int y = pass.y0; y < pass.y1 && success; y++) {
+          uint8_t *dst = pass.dst + ((y - pass.dst_y) * pass.stride + (pass.x0 - pass.dst_x)) * 2;
+          uint32_t offset = layout.row_offset(y) + pass.x0 * pixel_size;
+          if (layout.pixels == RawPixels::RGB565_LE) {
+            success = read_file_at(file, offset, dst, count * 2);
+            if (success && this->is_big_endian_()) {
+              kernels::swap565(dst, count);
+            }
+          } else {
+            success = read_file_at(file, offset, src.data(), src.size());
+            if (success) {
+              raw_row_to_rgba(layout.pixels, src.data(), rgba.data(), count);
+              kernels::rgba_to_rgb565(rgba.data(), dst, count, this->is_big_endian_());
+            }
+          }
+          if (y % 16 == 0) {
+            decode_yield();
+          }
+        }
+      }
+      fclose(file);
+      return success;
+    }
+    default:
+      ESP_LOGE(TAG_IMAGE, "Viewport decoding not supported for this file type");
+      return false;
+  }
+}
+
+bool SdImageComponent::reload_image() {
+  return this->load_image_from_path(this->file_path_);
 }
 
 void SdImageComponent::finalize_image_load() {
@@ -492,7 +2460,9 @@ void SdImageComponent::update_base_image_properties() {
   this->type_ = this->get_esphome_image_type();
   
   if (!this->image_buffer_.empty()) {
-    this->data_start_ = this->image_buffer_.data();
+    // Image compressée en RAM ou indices de palette: image::Image ne peut pas
+    // la lire directement (seul blit_ sait dessiner ces buffers)
+    this->data_start_ = this->is_base_readable_() ? this->image_buffer_.data() : nullptr;
     
     // Calculate bpp according to ESPHome source code
     switch (this->type_) {
@@ -516,40 +2486,240 @@ void SdImageComponent::update_base_image_properties() {
     this->data_start_ = nullptr;
     this->bpp_ = 0;
   }
+#ifdef USE_LVGL
+  this->update_lv_img_dsc_();
+#endif
+}
+
+void SdImageComponent::on_buffer_moved() {
+  if (this->image_loaded_ && !this->image_buffer_.empty()) {
+    if (this->is_base_readable_()) {
+      this->data_start_ = this->image_buffer_.data();
+    }
+#ifdef USE_LVGL
+    // nullptr reste nullptr: pas de descripteur pour ce format
+    if (this->lv_img_dsc_.data != nullptr) {
+      this->lv_img_dsc_.data = this->image_buffer_.data();
+    }
+#endif
+  }
 }
 
 int SdImageComponent::get_current_width() const {
+  if (this->viewport_enabled_) {
+    return this->image_width_;
+  }
   return this->resize_width_ > 0 ? this->resize_width_ : this->image_width_;
 }
 
-int SdImageComponent::get_current_height() const {
-  return this->resize_height_ > 0 ? this->resize_height_ : this->image_height_;
+int SdImageComponent::get_current_height() const {
+  if (this->viewport_enabled_) {
+    return this->image_height_;
+  }
+  return this->resize_height_ > 0 ? this->resize_height_ : this->image_height_;
+}
+
+image::ImageType SdImageComponent::get_esphome_image_type() const {
+  switch (this->format_) {
+    case ImageFormat::RGB565: return image::IMAGE_TYPE_RGB565;
+    case ImageFormat::RGB888: return image::IMAGE_TYPE_RGB;
+    case ImageFormat::RGBA: return image::IMAGE_TYPE_RGB; // ESPHome doesn't have native RGBA
+    case ImageFormat::GRAYSCALE: return image::IMAGE_TYPE_GRAYSCALE;
+    case ImageFormat::BINARY: return image::IMAGE_TYPE_BINARY;
+    case ImageFormat::INDEXED8: return image::IMAGE_TYPE_GRAYSCALE; // pas d'indexé dans image::Image: data_start_ nul, dessiné par blit_
+    default: return image::IMAGE_TYPE_RGB565;
+  }
+}
+
+// =====================================================
+// Blit
+// =====================================================
+
+bool SdImageComponent::blit_(int x, int y, int src_x, int src_y, int w, int h, display::Display *display) {
+  int img_w = this->get_current_width();
+  int img_h = this->get_current_height();
+  if (display == nullptr || this->image_buffer_.empty() || img_w <= 0 || img_h <= 0) {
+    return false;
+  }
+  if (this->compression_ != RamCompression::NONE ? this->image_buffer_.size() < ram_table_bytes(img_h)
+                                                 : this->image_buffer_.size() <
+                                                       image_buffer_bytes(this->format_, img_w, img_h)) {
+    return false;
+  }
+  
+  // Clipping une seule fois: écran, puis zone de clipping active du display
+  int x0 = std::max(x, 0);
+  int y0 = std::max(y, 0);
+  int x1 = std::min(x + w, display->get_width());
+  int y1 = std::min(y + h, display->get_height());
+  if (display->is_clipping()) {
+    auto clip = display->get_clipping();
+    x0 = std::max<int>(x0, clip.x);
+    y0 = std::max<int>(y0, clip.y);
+    x1 = std::min<int>(x1, clip.x + clip.w);
+    y1 = std::min<int>(y1, clip.y + clip.h);
+  }
+  if (x1 <= x0 || y1 <= y0) {
+    return true;  // entièrement hors écran
+  }
+  
+  src_x += x0 - x;
+  src_y += y0 - y;
+  int span = x1 - x0;
+  
+  if (this->compression_ != RamCompression::NONE) {
+    this->blit_compressed_rows_(x0, y0, x1, y1, src_x, src_y, display);
+    return true;
+  }
+  
+  switch (this->format_) {
+    case ImageFormat::RGB565:
+    case ImageFormat::RGB888: {
+      // Buffer déjà dans l'ordre de l'écran (byte_order): un seul appel, le
+      // driver saute x_offset/x_pad à chaque ligne. RGB888 est toujours rangé
+      // r,g,b (PixelTraits<RGB888>): rouge en premier octet, donc big endian
+      bool rgb565 = this->format_ == ImageFormat::RGB565;
+      display::ColorBitness bitness = rgb565 ? display::COLOR_BITNESS_565 : display::COLOR_BITNESS_888;
+      bool big_endian = rgb565 ? this->byte_order_ == SdByteOrder::BIG_ENDIAN_SD : true;
+      display->draw_pixels_at(x0, y0, span, y1 - y0, this->image_buffer_.data(), display::COLOR_ORDER_RGB, bitness,
+                              big_endian, src_x, src_y, img_w - src_x - span);
+      return true;
+    }
+    case ImageFormat::RGBA:
+    case ImageFormat::INDEXED8:
+      this->blit_converted_rows_(x0, y0, x1, y1, src_x, src_y, display);
+      return true;
+    default:
+      // GRAYSCALE/BINARY: image::Image::draw (color_on/color_off)
+      return false;
+  }
+}
+
+void SdImageComponent::blit_converted_rows_(int x0, int y0, int x1, int y1, int src_x, int src_y,
+                                            display::Display *display) {
+  int img_w = this->get_current_width();
+  int span = x1 - x0;
+  bool big_endian = this->is_big_endian_();
+  this->blit_row_.resize(span * 2);
+  uint8_t *row = this->blit_row_.data();
+  
+  if (this->format_ == ImageFormat::INDEXED8) {
+    // Palette convertie une fois dans l'ordre de l'écran, puis une lecture par pixel
+    if (this->blit_palette_.empty()) {
+      this->blit_palette_.resize(256);
+      for (int i = 0; i < 256; i++) {
+        this->blit_palette_[i] = this->to_native_565_(this->quantizer_.palette565(i));
+      }
+    }
+    uint16_t *row565 = reinterpret_cast<uint16_t *>(row);
+    for (int sy = y0; sy < y1; sy++) {
+      const uint8_t *src = this->image_buffer_.data() + (src_y + sy - y0) * img_w + src_x;
+      for (int i = 0; i < span; i++) {
+        row565[i] = this->blit_palette_[src[i]];
+      }
+      display->draw_pixels_at(x0, sy, span, 1, row, display::COLOR_ORDER_RGB, display::COLOR_BITNESS_565, big_endian);
+      if ((sy - y0) % 32 == 31) {
+        App.feed_wdt();
+      }
+    }
+    return;
+  }
+  
+  for (int sy = y0; sy < y1; sy++) {
+    const uint8_t *src = this->image_buffer_.data() + ((src_y + sy - y0) * img_w + src_x) * 4;
+    
+    // Ligne entière RGBA -> RGB565 de l'écran, puis spans opaques (alpha nul = coupure)
+    kernels::rgba_to_rgb565(src, row, span, big_endian);
+    int run_start = -1;
+    for (int i = 0; i <= span; i++) {
+      bool opaque = i < span && src[i * 4 + 3] != 0;
+      if (opaque && run_start < 0) {
+        run_start = i;
+      } else if (!opaque && run_start >= 0) {
+        display->draw_pixels_at(x0 + run_start, sy, i - run_start, 1, row + run_start * 2, display::COLOR_ORDER_RGB,
+                                display::COLOR_BITNESS_565, big_endian);
+        run_start = -1;
+      }
+    }
+    
+    if ((sy - y0) % 32 == 31) {
+      App.feed_wdt();
+    }
+  }
 }
 
-image::ImageType SdImageComponent::get_esphome_image_type() const {
-  switch (this->format_) {
-    case ImageFormat::RGB565: return image::IMAGE_TYPE_RGB565;
-    case ImageFormat::RGB888: return image::IMAGE_TYPE_RGB;
-    case ImageFormat::RGBA: return image::IMAGE_TYPE_RGB; // ESPHome doesn't have native RGBA
-    default: return image::IMAGE_TYPE_RGB565;
+void SdImageComponent::blit_compressed_rows_(int x0, int y0, int x1, int y1, int src_x, int src_y,
+                                             display::Display *display) {
+  int img_w = this->get_current_width();
+  int img_h = this->get_current_height();
+  bool big_endian = this->is_big_endian_();
+  this->blit_row_.resize(img_w * 2);
+  uint8_t *row = this->blit_row_.data();
+  
+  // Ligne entière développée (aplats remplis par mots), puis le span visible;
+  // une ligne codée à l'identique de la précédente n'est pas redéveloppée
+  const uint8_t *prev_src = nullptr;
+  size_t prev_len = 0;
+  for (int sy = y0; sy < y1; sy++) {
+    size_t len;
+    const uint8_t *src = ram_row(this->image_buffer_.data(), img_h, src_y + sy - y0, &len);
+    if (prev_src == nullptr || len != prev_len || memcmp(src, prev_src, len) != 0) {
+      ram_decode_row(this->compression_, src, img_w, big_endian, row);
+      prev_src = src;
+      prev_len = len;
+    }
+    display->draw_pixels_at(x0, sy, x1 - x0, 1, row + src_x * 2, display::COLOR_ORDER_RGB, display::COLOR_BITNESS_565,
+                            big_endian);
+    if ((sy - y0) % 32 == 31) {
+      App.feed_wdt();
+    }
   }
 }
 
 void SdImageComponent::draw_pixels_directly(int x, int y, display::Display *display, Color color_on, Color color_off) {
   ESP_LOGD(TAG_IMAGE, "Drawing %dx%d pixels directly", this->get_current_width(), this->get_current_height());
   
-  for (int img_y = 0; img_y < this->get_current_height(); img_y++) {
-    for (int img_x = 0; img_x < this->get_current_width(); img_x++) {
-      Color pixel_color = this->get_pixel_color(img_x, img_y);
-      display->draw_pixel_at(x + img_x, y + img_y, pixel_color);
-    }
-    
-    // Yield periodically to avoid watchdog
-    if (img_y % 32 == 0) {
-      App.feed_wdt();
-      yield();
+  int width = this->get_current_width();
+  int height = this->get_current_height();
+  if (this->compression_ != RamCompression::NONE) {
+    // Pas de lecture pixel par pixel d'une image compressée: blit (clippé) ligne à ligne
+    this->blit_(x, y, 0, 0, width, height, display);
+    return;
+  }
+  if (this->image_buffer_.size() < image_buffer_bytes(this->format_, width, height)) {
+    return;
+  }
+  
+  if (is_compact_format(this->format_)) {
+    for (int img_y = 0; img_y < height; img_y++) {
+      for (int img_x = 0; img_x < width; img_x++) {
+        this->draw_pixel_at(display, x + img_x, y + img_y, img_x, img_y);
+      }
+      if (img_y % 32 == 0) {
+        App.feed_wdt();
+        yield();
+      }
     }
+    return;
   }
+  
+  // Un seul choix de format pour toute l'image, boucle sans switch
+  dispatch_pixel_format(this->format_, this->byte_order_, [&](auto pixel) {
+    using P = decltype(pixel);
+    const uint8_t *src = this->image_buffer_.data();
+    for (int img_y = 0; img_y < height; img_y++) {
+      for (int img_x = 0; img_x < width; img_x++) {
+        display->draw_pixel_at(x + img_x, y + img_y, read_color<P>(src));
+        src += P::SIZE;
+      }
+      
+      // Yield periodically to avoid watchdog
+      if (img_y % 32 == 0) {
+        App.feed_wdt();
+        yield();
+      }
+    }
+  });
 }
 
 void SdImageComponent::draw_pixel_at(display::Display *display, int screen_x, int screen_y, int img_x, int img_y) {
@@ -561,47 +2731,51 @@ Color SdImageComponent::get_pixel_color(int x, int y) const {
   if (x < 0 || x >= this->get_current_width() || y < 0 || y >= this->get_current_height()) {
     return Color::BLACK;
   }
+  if (this->compression_ != RamCompression::NONE) {
+    // Accès aléatoire coûteux: la ligne entière est développée
+    if (this->image_buffer_.size() < ram_table_bytes(this->get_current_height())) {
+      return Color::BLACK;
+    }
+    std::vector<uint8_t> row(this->get_current_width() * 2);
+    ram_decode_row(this->compression_, ram_row(this->image_buffer_.data(), this->get_current_height(), y),
+                   this->get_current_width(), this->is_big_endian_(), row.data());
+    return get_pixel_ops(ImageFormat::RGB565, this->byte_order_).read(row.data() + x * 2);
+  }
+  if (is_compact_format(this->format_)) {
+    size_t row_bytes = image_row_bytes(this->format_, this->get_current_width());
+    if ((y + 1) * row_bytes > this->image_buffer_.size()) {
+      return Color::BLACK;
+    }
+    return this->quantizer_.read(this->image_buffer_.data() + y * row_bytes, x);
+  }
   
-  size_t offset = (y * this->get_current_width() + x) * this->get_pixel_size();
-  
-  if (offset + this->get_pixel_size() > this->image_buffer_.size()) {
+  const PixelOps *ops = this->pixel_ops_;
+  if (ops == nullptr) {
     return Color::BLACK;
   }
   
-  switch (this->format_) {
-    case ImageFormat::RGB565: {
-      uint16_t rgb565;
-      if (this->byte_order_ == SdByteOrder::BIG_ENDIAN_SD) {
-        // Big endian: MSB en premier
-        rgb565 = (this->image_buffer_[offset] << 8) | this->image_buffer_[offset + 1];
-      } else {
-        // Little endian: LSB en premier
-        rgb565 = this->image_buffer_[offset] | (this->image_buffer_[offset + 1] << 8);
-      }
-      uint8_t r = ((rgb565 >> 11) & 0x1F) << 3;
-      uint8_t g = ((rgb565 >> 5) & 0x3F) << 2;
-      uint8_t b = (rgb565 & 0x1F) << 3;
-      return Color(r, g, b);
-    }
-    case ImageFormat::RGB888:
-      return Color(this->image_buffer_[offset], 
-                  this->image_buffer_[offset + 1], 
-                  this->image_buffer_[offset + 2]);
-    case ImageFormat::RGBA:
-      return Color(this->image_buffer_[offset], 
-                  this->image_buffer_[offset + 1], 
-                  this->image_buffer_[offset + 2], 
-                  this->image_buffer_[offset + 3]);
-    default:
-      return Color::BLACK;
+  size_t offset = (y * this->get_current_width() + x) * ops->size;
+  if (offset + ops->size > this->image_buffer_.size()) {
+    return Color::BLACK;
   }
+  return ops->read(this->image_buffer_.data() + offset);
 }
 
 // File type detection
-SdImageComponent::FileType SdImageComponent::detect_file_type(const std::vector<uint8_t> &data) const {
+SdImageComponent::FileType SdImageComponent::detect_file_type(const std::vector<uint8_t> &data,
+                                                               size_t file_size) const {
   if (this->is_jpeg_data(data)) return FileType::JPEG;
   if (this->is_png_data(data)) return FileType::PNG;
   if (this->is_gif_data(data)) return FileType::GIF;
+  if (this->is_qoi_data(data)) return FileType::QOI;
+  if (is_bmp_data(data.data(), data.size())) return FileType::BMP;
+  // Pas de signature: raw aux dimensions configurées, ou .bin LVGL dont l'en-tête
+  // correspond exactement à la taille du fichier
+  RawLayout layout;
+  if (this->raw_width_ > 0 ||
+      lvgl_bin_read_layout(data.data(), data.size(), file_size > 0 ? file_size : data.size(), layout)) {
+    return FileType::RAW;
+  }
   return FileType::UNKNOWN;
 }
 
@@ -624,6 +2798,11 @@ bool SdImageComponent::is_gif_data(const std::vector<uint8_t> &data) const {
           (data[3] == '8' && data[4] == '9' && data[5] == 'a'));
 }
 
+bool SdImageComponent::is_qoi_data(const std::vector<uint8_t> &data) const {
+  // QOI: "qoif" puis l'en-tête de 14 octets
+  return storage::is_qoi_data(data.data(), data.size());
+}
+
 // Image decoding
 bool SdImageComponent::decode_image(const std::vector<uint8_t> &data) {
   FileType type = this->detect_file_type(data);
@@ -631,20 +2810,134 @@ bool SdImageComponent::decode_image(const std::vector<uint8_t> &data) {
   switch (type) {
     case FileType::JPEG:
       ESP_LOGI(TAG_IMAGE, "Decoding JPEG image");
+      this->decode_stats_.decoder = "JPEGDEC";
       return this->decode_jpeg_image(data);
       
     case FileType::PNG:
       ESP_LOGI(TAG_IMAGE, "Decoding PNG image");
+#ifdef USE_PNGDEC
+      if (!png_is_interlaced(data.data(), data.size())) {
+        this->decode_stats_.decoder = "PNGdec";
+        return this->decode_png_rows_(data);
+      }
+      ESP_LOGD(TAG_IMAGE, "Interlaced PNG, falling back to pngle");
+#endif
+      this->decode_stats_.decoder = "pngle";
       return this->decode_png_image(data);
       
     case FileType::GIF:
       ESP_LOGI(TAG_IMAGE, "Decoding GIF image");
+      this->decode_stats_.decoder = "AnimatedGIF";
       return this->decode_gif_image(data);
       
+    case FileType::QOI:
+      ESP_LOGI(TAG_IMAGE, "Decoding QOI image");
+      this->decode_stats_.decoder = "QOI";
+      return this->decode_qoi_image(data);
+      
+    case FileType::BMP:
+    case FileType::RAW: {
+      // Déjà en mémoire (entrée d'asset pack): mêmes lectures directes depuis data
+      this->decode_stats_.decoder = "BMP/raw";
+      RawLayout layout;
+      if (!this->raw_layout_(data.data(), data.size(), data.size(), layout)) {
+        ESP_LOGE(TAG_IMAGE, "Unsupported raw/BMP layout (%zu bytes)", data.size());
+        return false;
+      }
+      return this->load_raw_(layout, [&data](uint32_t offset, uint8_t *dst, size_t len) {
+        if (offset > data.size() || len > data.size() - offset) {
+          return false;
+        }
+        memcpy(dst, data.data() + offset, len);
+        return true;
+      });
+    }
+      
     default:
-      ESP_LOGE(TAG_IMAGE, "Unsupported image format (only JPEG, PNG and GIF supported)");
+      ESP_LOGE(TAG_IMAGE, "Unsupported image format (only JPEG, PNG, GIF, QOI, BMP and raw supported)");
+      return false;
+  }
+}
+
+// =====================================================
+// Asset Pack Loading
+// =====================================================
+
+bool SdImageComponent::load_from_asset_pack(const std::string &name) {
+  const AssetPackEntry *entry = this->storage_component_->find_asset(name);
+  if (!entry) {
+    return false;
+  }
+  
+  AssetEncoding encoding = static_cast<AssetEncoding>(entry->encoding);
+  
+  if (encoding == AssetEncoding::ENCODED) {
+    // JPEG/PNG/GIF stocké tel quel: une lecture puis le décodeur habituel
+    std::vector<uint8_t> data(entry->size);
+    if (!this->storage_component_->read_asset(*entry, data.data())) {
+      return false;
+    }
+    return this->decode_image(data);
+  }
+  
+  // Pre-converted pixels: read straight into the image buffer
+  bool is_rgb565 = encoding == AssetEncoding::RGB565_LE || encoding == AssetEncoding::RGB565_BE;
+  // Formats compacts: lus en RGB565 puis quantifiés par read_and_decode_
+  bool format_ok = (is_rgb565 && (this->output_format_ == ImageFormat::RGB565 ||
+                                  is_compact_format(this->output_format_))) ||
+                   (encoding == AssetEncoding::RGB888 && this->output_format_ == ImageFormat::RGB888) ||
+                   (encoding == AssetEncoding::RGBA8888 && this->output_format_ == ImageFormat::RGBA);
+  if (!format_ok) {
+    ESP_LOGE(TAG_IMAGE, "Asset '%s' encoding %u does not match format %s, rebuild the pack with the right --format",
+             name.c_str(), entry->encoding, image_format_to_string(this->output_format_));
+    return false;
+  }
+  
+  this->decode_.width = entry->width;
+  this->decode_.height = entry->height;
+  this->decode_.format = is_rgb565 ? ImageFormat::RGB565 : this->output_format_;
+  
+  if (this->get_buffer_size() != entry->size) {
+    ESP_LOGE(TAG_IMAGE, "Asset '%s' size mismatch: %u bytes for %dx%d", 
+             name.c_str(), entry->size, entry->width, entry->height);
+    return false;
+  }
+  
+  if (!this->allocate_image_buffer()) {
+    return false;
+  }
+  
+  if (!this->storage_component_->read_asset(*entry, this->decode_.buffer.data())) {
+    this->decode_.buffer.clear();
+    return false;
+  }
+  
+  // Packed for the other byte order: swap in place
+  if (is_rgb565) {
+    bool packed_be = encoding == AssetEncoding::RGB565_BE;
+    bool want_be = this->byte_order_ == SdByteOrder::BIG_ENDIAN_SD;
+    if (packed_be != want_be) {
+      kernels::swap565(this->decode_.buffer.data(), this->decode_.buffer.size() / 2);
+    }
+  }
+  
+  if (this->resize_width_ > 0 && this->resize_height_ > 0 &&
+      (this->resize_width_ != this->decode_.width || this->resize_height_ != this->decode_.height)) {
+    if (this->decode_.format != ImageFormat::RGB565) {
+      ESP_LOGE(TAG_IMAGE, "Resize of pre-converted assets is only supported for RGB565");
       return false;
+    }
+    if (!this->resize_image_buffer(this->decode_.width, this->decode_.height, 
+                                   this->resize_width_, this->resize_height_)) {
+      return false;
+    }
+    this->decode_.width = this->resize_width_;
+    this->decode_.height = this->resize_height_;
   }
+  
+  ESP_LOGD(TAG_IMAGE, "Asset '%s' read directly: %dx%d, %u bytes", 
+           name.c_str(), this->decode_.width, this->decode_.height, entry->size);
+  return true;
 }
 
 // =====================================================
@@ -656,12 +2949,10 @@ bool SdImageComponent::decode_image(const std::vector<uint8_t> &data) {
 bool SdImageComponent::decode_jpeg_image(const std::vector<uint8_t> &jpeg_data) {
   ESP_LOGD(TAG_IMAGE, "Using JPEGDEC decoder with post-decode resize");
   
-  current_image_component = this;
   
   this->jpeg_decoder_ = new JPEGDEC();
   if (!this->jpeg_decoder_) {
     ESP_LOGE(TAG_IMAGE, "Failed to allocate JPEG decoder");
-    current_image_component = nullptr;
     return false;
   }
   
@@ -671,10 +2962,13 @@ bool SdImageComponent::decode_jpeg_image(const std::vector<uint8_t> &jpeg_data)
     ESP_LOGE(TAG_IMAGE, "Failed to open JPEG data: %d", result);
     delete this->jpeg_decoder_;
     this->jpeg_decoder_ = nullptr;
-    current_image_component = nullptr;
     return false;
   }
   
+  // Le composant voyage avec le décodeur: plusieurs décodages en parallèle possibles
+  this->jpeg_decoder_->setUserPointer(this);
+  this->jpeg_decoder_->setPixelType(this->is_big_endian_() ? RGB565_BIG_ENDIAN : RGB565_LITTLE_ENDIAN);
+  
   // Get original dimensions
   int orig_width = this->jpeg_decoder_->getWidth();
   int orig_height = this->jpeg_decoder_->getHeight();
@@ -688,21 +2982,21 @@ bool SdImageComponent::decode_jpeg_image(const std::vector<uint8_t> &jpeg_data)
     this->jpeg_decoder_->close();
     delete this->jpeg_decoder_;
     this->jpeg_decoder_ = nullptr;
-    current_image_component = nullptr;
     return false;
   }
   
   // Temporarily set dimensions to original for decoding
-  this->image_width_ = orig_width;
-  this->image_height_ = orig_height;
-  this->format_ = ImageFormat::RGB565;
+  bool resizing = this->resize_width_ > 0 && this->resize_height_ > 0 &&
+                  (this->resize_width_ != orig_width || this->resize_height_ != orig_height);
+  this->decode_.width = orig_width;
+  this->decode_.height = orig_height;
+  this->decode_.format = this->decode_format_(!resizing);
   
   // Allocate temporary buffer for original size
   if (!this->allocate_image_buffer()) {
     this->jpeg_decoder_->close();
     delete this->jpeg_decoder_;
     this->jpeg_decoder_ = nullptr;
-    current_image_component = nullptr;
     return false;
   }
   
@@ -714,7 +3008,6 @@ bool SdImageComponent::decode_jpeg_image(const std::vector<uint8_t> &jpeg_data)
   this->jpeg_decoder_->close();
   delete this->jpeg_decoder_;
   this->jpeg_decoder_ = nullptr;
-  current_image_component = nullptr;
   
   if (result != 1) {
     ESP_LOGE(TAG_IMAGE, "Failed to decode JPEG: %d", result);
@@ -722,9 +3015,7 @@ bool SdImageComponent::decode_jpeg_image(const std::vector<uint8_t> &jpeg_data)
   }
   
   // Now resize if needed
-  if (this->resize_width_ > 0 && this->resize_height_ > 0 &&
-      (this->resize_width_ != orig_width || this->resize_height_ != orig_height)) {
-    
+  if (resizing) {
     ESP_LOGI(TAG_IMAGE, "Resizing JPEG from %dx%d to %dx%d", 
              orig_width, orig_height, this->resize_width_, this->resize_height_);
     
@@ -735,75 +3026,92 @@ bool SdImageComponent::decode_jpeg_image(const std::vector<uint8_t> &jpeg_data)
     }
     
     // Update dimensions
-    this->image_width_ = this->resize_width_;
-    this->image_height_ = this->resize_height_;
+    this->decode_.width = this->resize_width_;
+    this->decode_.height = this->resize_height_;
   }
   
   ESP_LOGI(TAG_IMAGE, "JPEG processed successfully: %dx%d", 
-           this->image_width_, this->image_height_);
+           this->decode_.width, this->decode_.height);
   
   return true;
 }
 
 // No-resize callback for original size decoding
 int SdImageComponent::jpeg_decode_callback_no_resize(JPEGDRAW *pDraw) {
-  if (!current_image_component || !pDraw || !pDraw->pPixels) {
+  if (!pDraw || !pDraw->pUser || !pDraw->pPixels) {
     return 0;
   }
   
-  SdImageComponent *component = current_image_component;
-  uint16_t *pixels = (uint16_t *)pDraw->pPixels;
+  SdImageComponent *component = static_cast<SdImageComponent *>(pDraw->pUser);
+  const uint16_t *pixels = (const uint16_t *)pDraw->pPixels;
+  int width = component->decode_.width;
   
-  // Direct copy without any resize logic
-  for (int py = 0; py < pDraw->iHeight; py++) {
-    for (int px = 0; px < pDraw->iWidth; px++) {
-      int img_x = pDraw->x + px;
-      int img_y = pDraw->y + py;
-      
-      if (img_x >= 0 && img_x < component->image_width_ && 
-          img_y >= 0 && img_y < component->image_height_) {
-        
-        uint16_t rgb565 = pixels[py * pDraw->iWidth + px];
-        size_t offset = (img_y * component->image_width_ + img_x) * 2;
-        
-        if (offset + 1 < component->image_buffer_.size()) {
-          // Respect byte order configuration
-          if (component->byte_order_ == SdByteOrder::BIG_ENDIAN_SD) {
-            // Big endian: MSB first
-            component->image_buffer_[offset] = (rgb565 >> 8) & 0xFF;
-            component->image_buffer_[offset + 1] = rgb565 & 0xFF;
-          } else {
-            // Little endian: LSB first (default)
-            component->image_buffer_[offset] = rgb565 & 0xFF;
-            component->image_buffer_[offset + 1] = (rgb565 >> 8) & 0xFF;
-          }
-        }
-      }
-    }
-    
-    if (py % 16 == 0) {
-      App.feed_wdt();
-      yield();
+  // JPEGDEC émet déjà l'ordre de l'écran (setPixelType): copie ligne par ligne
+  int x_end = std::min(pDraw->x + pDraw->iWidth, width);
+  int y_end = std::min(pDraw->y + pDraw->iHeight, component->decode_.height);
+  if (pDraw->x < 0 || pDraw->y < 0 || x_end <= pDraw->x) {
+    return 1;
+  }
+  size_t row_bytes = (x_end - pDraw->x) * 2;
+  uint8_t *dst = component->decode_.buffer.data();
+  if (is_compact_format(component->decode_.format)) {
+    // Quantifié à la volée: pas de copie RGB565 de l'image
+    size_t stride = image_row_bytes(component->decode_.format, width);
+    for (int img_y = pDraw->y; img_y < y_end; img_y++) {
+      component->quantizer_.put_row565(dst + img_y * stride, pDraw->x, img_y,
+                                       (const uint8_t *) (pixels + (img_y - pDraw->y) * pDraw->iWidth),
+                                       x_end - pDraw->x, component->is_big_endian_());
     }
+    decode_yield();
+    return 1;
+  }
+  for (int img_y = pDraw->y; img_y < y_end; img_y++) {
+    memcpy(dst + (img_y * width + pDraw->x) * 2, pixels + (img_y - pDraw->y) * pDraw->iWidth, row_bytes);
   }
   
+  decode_yield();
   return 1;
 }
 
-// Legacy callback with fixed resize logic (kept for compatibility)
-int SdImageComponent::jpeg_decode_callback(JPEGDRAW *pDraw) {
-  if (!current_image_component) {
-    ESP_LOGE(TAG_IMAGE, "No current image component in callback");
+// Viewport: blocs MCU hors fenêtre ignorés, arrêt du décodage sous la fenêtre
+int SdImageComponent::jpeg_region_callback(JPEGDRAW *pDraw) {
+  if (!pDraw || !pDraw->pUser || !pDraw->pPixels) {
     return 0;
   }
   
-  SdImageComponent *component = current_image_component;
+  SdImageComponent *component = static_cast<SdImageComponent *>(pDraw->pUser);
+  RegionPass &pass = component->region_;
+  if (pDraw->y >= pass.y1) {
+    pass.done = true;
+    return 0;
+  }
+  if (pDraw->y + pDraw->iHeight <= pass.y0 || pDraw->x >= pass.x1 || pDraw->x + pDraw->iWidth <= pass.x0) {
+    return 1;
+  }
   
-  if (!pDraw || !pDraw->pPixels) {
+  const uint16_t *pixels = (const uint16_t *) pDraw->pPixels;
+  int y_start = std::max(pass.y0, pDraw->y);
+  int y_end = std::min(pass.y1, pDraw->y + pDraw->iHeight);
+  int x_start = std::max(pass.x0, pDraw->x);
+  int x_end = std::min(pass.x1, pDraw->x + pDraw->iWidth);
+  // Pixels déjà dans l'ordre de l'écran: copie du span de chaque ligne
+  for (int y = y_start; y < y_end; y++) {
+    memcpy(pass.dst + ((y - pass.dst_y) * pass.stride + (x_start - pass.dst_x)) * 2,
+           pixels + (y - pDraw->y) * pDraw->iWidth + (x_start - pDraw->x), (x_end - x_start) * 2);
+  }
+  decode_yield();
+  return 1;
+}
+
+// Legacy callback with fixed resize logic (kept for compatibility)
+int SdImageComponent::jpeg_decode_callback(JPEGDRAW *pDraw) {
+  if (!pDraw || !pDraw->pUser || !pDraw->pPixels) {
     ESP_LOGE(TAG_IMAGE, "Invalid draw parameters in callback");
     return 0;
   }
   
+  SdImageComponent *component = static_cast<SdImageComponent *>(pDraw->pUser);
+  
   // Get original JPEG dimensions
   int orig_width = component->jpeg_decoder_->getWidth();
   int orig_height = component->jpeg_decoder_->getHeight();
@@ -837,16 +3145,15 @@ int SdImageComponent::jpeg_decode_callback(JPEGDRAW *pDraw) {
           
           // Store in resized buffer
           size_t offset = (out_y * component->resize_width_ + out_x) * 2;
-          if (offset + 1 < component->image_buffer_.size()) {
-            component->image_buffer_[offset] = rgb565 & 0xFF;
-            component->image_buffer_[offset + 1] = (rgb565 >> 8) & 0xFF;
+          if (offset + 1 < component->decode_.buffer.size()) {
+            component->decode_.buffer[offset] = rgb565 & 0xFF;
+            component->decode_.buffer[offset + 1] = (rgb565 >> 8) & 0xFF;
           }
         }
       }
       
       if (out_y % 8 == 0) {
-        App.feed_wdt();
-        yield();
+        decode_yield();
       }
     }
   } else {
@@ -856,22 +3163,21 @@ int SdImageComponent::jpeg_decode_callback(JPEGDRAW *pDraw) {
         int img_x = pDraw->x + px;
         int img_y = pDraw->y + py;
         
-        if (img_x >= 0 && img_x < component->image_width_ && 
-            img_y >= 0 && img_y < component->image_height_) {
+        if (img_x >= 0 && img_x < component->decode_.width && 
+            img_y >= 0 && img_y < component->decode_.height) {
           
           uint16_t rgb565 = pixels[py * pDraw->iWidth + px];
-          size_t offset = (img_y * component->image_width_ + img_x) * 2;
+          size_t offset = (img_y * component->decode_.width + img_x) * 2;
           
-          if (offset + 1 < component->image_buffer_.size()) {
-            component->image_buffer_[offset] = rgb565 & 0xFF;
-            component->image_buffer_[offset + 1] = (rgb565 >> 8) & 0xFF;
+          if (offset + 1 < component->decode_.buffer.size()) {
+            component->decode_.buffer[offset] = rgb565 & 0xFF;
+            component->decode_.buffer[offset + 1] = (rgb565 >> 8) & 0xFF;
           }
         }
       }
       
       if (py % 16 == 0) {
-        App.feed_wdt();
-        yield();
+        decode_yield();
       }
     }
   }
@@ -900,17 +3206,30 @@ int SdImageComponent::jpeg_decode_callback_no_resize(JPEGDRAW *pDraw) {
 // PNG Decoder Implementation
 // =====================================================
 
+bool SdImageComponent::decode_png_file_(const std::string &full_path, bool interlaced) {
+  ESP_LOGI(TAG_IMAGE, "Decoding PNG image");
+#ifdef USE_PNGDEC
+  if (!interlaced) {
+    this->decode_stats_.decoder = "PNGdec";
+    return this->decode_png_rows_(full_path);
+  }
+  ESP_LOGD(TAG_IMAGE, "Interlaced PNG, falling back to pngle");
+#endif
+#ifdef USE_PNGLE
+  this->decode_stats_.decoder = "pngle";
+  return this->decode_png_stream_(full_path);
+#else
+  ESP_LOGE(TAG_IMAGE, "PNG support not compiled in (USE_PNGLE not defined)");
+  return false;
+#endif
+}
+
 #ifdef USE_PNGLE
 
-bool SdImageComponent::decode_png_image(const std::vector<uint8_t> &png_data) {
-  ESP_LOGD(TAG_IMAGE, "Using PNGLE decoder");
-  
-  current_image_component = this;
-  
+bool SdImageComponent::begin_png_decoder_() {
   this->png_decoder_ = pngle_new();
   if (!this->png_decoder_) {
     ESP_LOGE(TAG_IMAGE, "Failed to create PNG decoder");
-    current_image_component = nullptr;
     return false;
   }
   
@@ -924,13 +3243,23 @@ bool SdImageComponent::decode_png_image(const std::vector<uint8_t> &png_data) {
   }
   
   pngle_set_done_callback(this->png_decoder_, SdImageComponent::png_done_callback);
+  pngle_set_user_data(this->png_decoder_, this);
+  this->png_done_ = false;
+  return true;
+}
+
+bool SdImageComponent::decode_png_image(const std::vector<uint8_t> &png_data) {
+  ESP_LOGD(TAG_IMAGE, "Using PNGLE decoder");
+  
+  if (!this->begin_png_decoder_()) {
+    return false;
+  }
   
   // Feed data to decoder
   int result = pngle_feed(this->png_decoder_, png_data.data(), png_data.size());
   
   pngle_destroy(this->png_decoder_);
   this->png_decoder_ = nullptr;
-  current_image_component = nullptr;
   
   if (result < 0) {
     ESP_LOGE(TAG_IMAGE, "Failed to decode PNG: %d", result);
@@ -938,23 +3267,88 @@ bool SdImageComponent::decode_png_image(const std::vector<uint8_t> &png_data) {
   }
   
   ESP_LOGI(TAG_IMAGE, "PNG decoded successfully: %dx%d", 
-           this->image_width_, this->image_height_);
+           this->decode_.width, this->decode_.height);
   
   return true;
 }
 
-void SdImageComponent::png_init_callback(pngle_t *pngle, uint32_t w, uint32_t h) {
-  if (!current_image_component) return;
+bool SdImageComponent::decode_png_stream_(const std::string &full_path) {
+  ESP_LOGD(TAG_IMAGE, "Using PNGLE decoder (streamed from file)");
+  
+  FILE *file = fopen(full_path.c_str(), "rb");
+  if (!file) {
+    ESP_LOGE(TAG_IMAGE, "Failed to open PNG: %s", full_path.c_str());
+    return false;
+  }
+  if (!this->begin_png_decoder_()) {
+    fclose(file);
+    return false;
+  }
+  
+  // Seul un bloc de 1 Ko du fichier est en RAM à la fois
+  bool success = feed_pngle_file(this->png_decoder_, file, nullptr);
+  
+  pngle_destroy(this->png_decoder_);
+  this->png_decoder_ = nullptr;
+  fclose(file);
+  
+  if (!success) {
+    return false;
+  }
+  // Fichier tronqué: pngle attend encore des données à la fin du flux
+  if (!this->png_done_ || this->decode_.buffer.empty()) {
+    ESP_LOGE(TAG_IMAGE, "PNG incomplete: %s", full_path.c_str());
+    return false;
+  }
+  
+  ESP_LOGI(TAG_IMAGE, "PNG decoded successfully: %dx%d", 
+           this->decode_.width, this->decode_.height);
+  return true;
+}
+
+void SdImageComponent::png_region_init_callback(pngle_t *pngle, uint32_t w, uint32_t h) {
+  SdImageComponent *component = static_cast<SdImageComponent *>(pngle_get_user_data(pngle));
+  if (!component) return;
+  
+  // Adam7: les passes balaient toute l'image, impossible de s'arrêter tôt
+  pngle_ihdr_t *ihdr = pngle_get_ihdr(pngle);
+  component->region_.interlaced = ihdr && ihdr->interlace;
+  if (!component->begin_region_target_(w, h)) {
+    component->region_.dst = nullptr;
+    component->region_.done = true;
+  }
+}
+
+void SdImageComponent::png_region_draw_callback(pngle_t *pngle, uint32_t x, uint32_t y, uint32_t w, uint32_t h, const uint8_t rgba[4]) {
+  SdImageComponent *component = static_cast<SdImageComponent *>(pngle_get_user_data(pngle));
+  if (!component || !component->region_.dst) return;
+  
+  RegionPass &pass = component->region_;
+  if (!pass.interlaced && (int) y >= pass.y1) {
+    pass.done = true;
+    return;
+  }
   
-  SdImageComponent *component = current_image_component;
+  uint16_t native = component->to_native_565_(((rgba[0] >> 3) << 11) | ((rgba[1] >> 2) << 5) | (rgba[2] >> 3));
+  // Passes Adam7 précoces: un pixel couvre un bloc w x h
+  for (uint32_t dy = 0; dy < h; dy++) {
+    for (uint32_t dx = 0; dx < w; dx++) {
+      component->region_put_(x + dx, y + dy, native);
+    }
+  }
+}
+
+void SdImageComponent::png_init_callback(pngle_t *pngle, uint32_t w, uint32_t h) {
+  SdImageComponent *component = static_cast<SdImageComponent *>(pngle_get_user_data(pngle));
+  if (!component) return;
   
   ESP_LOGI(TAG_IMAGE, "PNG original dimensions: %dx%d", w, h);
   ESP_LOGI(TAG_IMAGE, "PNG target dimensions: %dx%d", component->resize_width_, component->resize_height_);
   
   // Set to target dimensions
-  component->image_width_ = component->resize_width_;
-  component->image_height_ = component->resize_height_;
-  component->format_ = ImageFormat::RGB565;
+  component->decode_.width = component->resize_width_;
+  component->decode_.height = component->resize_height_;
+  component->decode_.format = component->decode_format_(true);
   
   if (!component->allocate_image_buffer()) {
     ESP_LOGE(TAG_IMAGE, "Failed to allocate PNG buffer");
@@ -962,38 +3356,36 @@ void SdImageComponent::png_init_callback(pngle_t *pngle, uint32_t w, uint32_t h)
 }
 
 void SdImageComponent::png_draw_callback(pngle_t *pngle, uint32_t x, uint32_t y, uint32_t w, uint32_t h, const uint8_t rgba[4]) {
-  if (!current_image_component) return;
-  
-  SdImageComponent *component = current_image_component;
-  
-  // Get original PNG dimensions
-  uint32_t orig_width = pngle_get_width(pngle);
-  uint32_t orig_height = pngle_get_height(pngle);
-  
-  // Calculate scaling factors
-  float scale_x = (float)component->resize_width_ / orig_width;
-  float scale_y = (float)component->resize_height_ / orig_height;
-  
-  // Map original coordinates to resized coordinates
-  int dst_x = (int)(x * scale_x);
-  int dst_y = (int)(y * scale_y);
-  
-  // Only process if within bounds
-  if (dst_x >= 0 && dst_x < component->resize_width_ && 
-      dst_y >= 0 && dst_y < component->resize_height_) {
-    component->set_pixel(dst_x, dst_y, rgba[0], rgba[1], rgba[2], rgba[3]);
+  SdImageComponent *component = static_cast<SdImageComponent *>(pngle_get_user_data(pngle));
+  if (!component) return;
+  
+  // Chaque pixel cible dont kernels::nearest_source() est ce pixel source: mêmes
+  // pixels que resize_image_buffer et le backend PNGdec (aucun trou en agrandissement)
+  int src_width = pngle_get_width(pngle);
+  int src_height = pngle_get_height(pngle);
+  int dst_width = component->decode_.width;
+  int dst_height = component->decode_.height;
+  int dx_begin = kernels::first_target(x, src_width, dst_width);
+  int dx_end = std::min(kernels::first_target(x + 1, src_width, dst_width), dst_width);
+  int dy_end = std::min(kernels::first_target(y + 1, src_height, dst_height), dst_height);
+  for (int dy = kernels::first_target(y, src_height, dst_height); dy < dy_end; dy++) {
+    for (int dx = dx_begin; dx < dx_end; dx++) {
+      component->set_pixel(dx, dy, rgba[0], rgba[1], rgba[2], rgba[3]);
+    }
   }
 }
 
 void SdImageComponent::png_done_callback(pngle_t *pngle) {
-  if (!current_image_component) return;
+  SdImageComponent *component = static_cast<SdImageComponent *>(pngle_get_user_data(pngle));
+  if (component) {
+    component->png_done_ = true;
+  }
   ESP_LOGD(TAG_IMAGE, "PNG decoding completed");
 }
 
 void SdImageComponent::png_init_callback_no_resize(pngle_t *pngle, uint32_t w, uint32_t h) {
-  if (!current_image_component) return;
-  
-  SdImageComponent *component = current_image_component;
+  SdImageComponent *component = static_cast<SdImageComponent *>(pngle_get_user_data(pngle));
+  if (!component) return;
   
   ESP_LOGI(TAG_IMAGE, "PNG dimensions: %dx%d (no resize)", w, h);
   
@@ -1004,9 +3396,9 @@ void SdImageComponent::png_init_callback_no_resize(pngle_t *pngle, uint32_t w, u
   }
   
   // Set actual dimensions
-  component->image_width_ = w;
-  component->image_height_ = h;
-  component->format_ = ImageFormat::RGB565;
+  component->decode_.width = w;
+  component->decode_.height = h;
+  component->decode_.format = component->decode_format_(true);
   
   if (!component->allocate_image_buffer()) {
     ESP_LOGE(TAG_IMAGE, "Failed to allocate PNG buffer");
@@ -1014,13 +3406,12 @@ void SdImageComponent::png_init_callback_no_resize(pngle_t *pngle, uint32_t w, u
 }
 
 void SdImageComponent::png_draw_callback_no_resize(pngle_t *pngle, uint32_t x, uint32_t y, uint32_t w, uint32_t h, const uint8_t rgba[4]) {
-  if (!current_image_component) return;
-  
-  SdImageComponent *component = current_image_component;
+  SdImageComponent *component = static_cast<SdImageComponent *>(pngle_get_user_data(pngle));
+  if (!component) return;
   
   // Direct pixel placement without resize
-  if (x >= 0 && x < (uint32_t)component->image_width_ && 
-      y >= 0 && y < (uint32_t)component->image_height_) {
+  if (x >= 0 && x < (uint32_t)component->decode_.width && 
+      y >= 0 && y < (uint32_t)component->decode_.height) {
     component->set_pixel(x, y, rgba[0], rgba[1], rgba[2], rgba[3]);
   }
 }
@@ -1045,15 +3436,183 @@ void SdImageComponent::png_done_callback(pngle_t *pngle) {
   // Empty stub
 }
 
-void SdImageComponent::png_init_callback_no_resize(pngle_t *pngle, uint32_t w, uint32_t h) {
-  // Empty stub
+void SdImageComponent::png_init_callback_no_resize(pngle_t *pngle, uint32_t w, uint32_t h) {
+  // Empty stub
+}
+
+void SdImageComponent::png_draw_callback_no_resize(pngle_t *pngle, uint32_t x, uint32_t y, uint32_t w, uint32_t h, const uint8_t rgba[4]) {
+  // Empty stub
+}
+
+#endif // USE_PNGLE
+
+// =====================================================
+// PNG Row Decoder (PNGdec)
+// =====================================================
+
+#ifdef USE_PNGDEC
+
+bool SdImageComponent::decode_png_rows_(const std::vector<uint8_t> &png_data) {
+  ESP_LOGD(TAG_IMAGE, "Using PNGdec row decoder");
+  
+  PNG *png = new PNG();
+  if (png->openRAM((uint8_t *) png_data.data(), png_data.size(), SdImageComponent::png_row_callback) != PNG_SUCCESS) {
+    ESP_LOGE(TAG_IMAGE, "Failed to open PNG: %d", png->getLastError());
+    delete png;
+    return false;
+  }
+  return this->decode_png_rows_(png);
+}
+
+bool SdImageComponent::decode_png_rows_(const std::string &full_path) {
+  ESP_LOGD(TAG_IMAGE, "Using PNGdec row decoder (streamed from file)");
+  
+  // PNGdec lit le fichier par son propre tampon via stream_read/stream_seek
+  PNG *png = new PNG();
+  if (png->open(full_path.c_str(), stream_open, stream_close, stream_read<PNGFILE>, stream_seek<PNGFILE>,
+                SdImageComponent::png_row_callback) != PNG_SUCCESS) {
+    ESP_LOGE(TAG_IMAGE, "Failed to open PNG: %s", full_path.c_str());
+    delete png;
+    return false;
+  }
+  return this->decode_png_rows_(png);
+}
+
+bool SdImageComponent::decode_png_rows_(PNG *png) {
+  int orig_width = png->getWidth();
+  int orig_height = png->getHeight();
+  ESP_LOGI(TAG_IMAGE, "PNG dimensions: %dx%d, type %d, %d bits", orig_width, orig_height, png->getPixelType(),
+           png->getBpp());
+  if (orig_width <= 0 || orig_height <= 0 || orig_width > 2048 || orig_height > 2048) {
+    ESP_LOGE(TAG_IMAGE, "Invalid PNG dimensions: %dx%d", orig_width, orig_height);
+    png->close();
+    delete png;
+    return false;
+  }
+  
+  // Redimensionnement au vol (plus proche voisin): buffer alloué directement à la taille cible
+  bool resizing = this->resize_width_ > 0 && this->resize_height_ > 0 &&
+                  (this->resize_width_ != orig_width || this->resize_height_ != orig_height);
+  this->decode_.width = resizing ? this->resize_width_ : orig_width;
+  this->decode_.height = resizing ? this->resize_height_ : orig_height;
+  this->decode_.format = this->decode_format_(true);
+  bool success = this->allocate_image_buffer();
+  
+  if (success) {
+    this->png_rgba_.resize(orig_width * 4);
+    if (resizing) {
+      this->png_x_map_.resize(this->decode_.width);
+      for (int dx = 0; dx < this->decode_.width; dx++) {
+        this->png_x_map_[dx] = kernels::nearest_source(dx, orig_width, this->decode_.width);
+      }
+      this->png_resized_.resize(this->decode_.width * 4);
+    }
+    this->png_rows_decoder_ = png;
+    success = png->decode(this, 0) == PNG_SUCCESS;
+    if (!success) {
+      ESP_LOGE(TAG_IMAGE, "Failed to decode PNG: %d", png->getLastError());
+    }
+    this->png_rows_decoder_ = nullptr;
+  }
+  
+  png->close();
+  delete png;
+  std::vector<uint8_t>().swap(this->png_rgba_);
+  std::vector<uint8_t>().swap(this->png_resized_);
+  std::vector<uint16_t>().swap(this->png_x_map_);
+  
+  if (success) {
+    ESP_LOGI(TAG_IMAGE, "PNG decoded successfully: %dx%d", this->decode_.width, this->decode_.height);
+  }
+  return success;
+}
+
+int SdImageComponent::png_row_callback(PNGDRAW *draw) {
+  SdImageComponent *component = static_cast<SdImageComponent *>(draw->pUser);
+  if (!component || component->png_rgba_.empty()) {
+    return 0;
+  }
+  
+  uint8_t *rgba = component->png_rgba_.data();
+  png_row_to_rgba(png_row_format(draw), draw->pPixels, 0, draw->iWidth, rgba);
+  
+  if (component->png_x_map_.empty()) {
+    component->put_rgba_row_(draw->y, rgba, draw->iWidth);
+  } else {
+    // Chaque ligne cible qui échantillonne cette ligne source, colonnes rassemblées une fois
+    int src_height = component->png_rows_decoder_->getHeight();
+    int dst_height = component->decode_.height;
+    int dst_width = component->decode_.width;
+    int dy_end = std::min(kernels::first_target(draw->y + 1, src_height, dst_height), dst_height);
+    bool gathered = false;
+    for (int dy = kernels::first_target(draw->y, src_height, dst_height); dy < dy_end; dy++) {
+      if (!gathered) {
+        uint32_t *dst = reinterpret_cast<uint32_t *>(component->png_resized_.data());
+        const uint32_t *src = reinterpret_cast<const uint32_t *>(rgba);
+        for (int dx = 0; dx < dst_width; dx++) {
+          dst[dx] = src[component->png_x_map_[dx]];
+        }
+        gathered = true;
+      }
+      component->put_rgba_row_(dy, component->png_resized_.data(), dst_width);
+    }
+  }
+  
+  if (draw->y % 16 == 0) {
+    decode_yield();
+  }
+  return 1;
+}
+
+bool SdImageComponent::decode_png_region_rows_(const std::string &full_path) {
+  PNG *png = new PNG();
+  if (png->open(full_path.c_str(), stream_open, stream_close, stream_read<PNGFILE>, stream_seek<PNGFILE>,
+                SdImageComponent::png_region_row_callback) != PNG_SUCCESS) {
+    ESP_LOGE(TAG_IMAGE, "Failed to open PNG: %s", full_path.c_str());
+    delete png;
+    return false;
+  }
+  
+  bool success = this->begin_region_target_(png->getWidth(), png->getHeight());
+  if (success) {
+    this->png_rgba_.resize((this->region_.x1 - this->region_.x0) * 4);
+    this->png_rows_decoder_ = png;
+    // Le callback renvoie 0 sous la fenêtre: decode() s'arrête là, en "échec"
+    success = png->decode(this, 0) == PNG_SUCCESS || this->region_.done;
+    this->png_rows_decoder_ = nullptr;
+  }
+  png->close();
+  delete png;
+  std::vector<uint8_t>().swap(this->png_rgba_);
+  return success;
 }
 
-void SdImageComponent::png_draw_callback_no_resize(pngle_t *pngle, uint32_t x, uint32_t y, uint32_t w, uint32_t h, const uint8_t rgba[4]) {
-  // Empty stub
+int SdImageComponent::png_region_row_callback(PNGDRAW *draw) {
+  SdImageComponent *component = static_cast<SdImageComponent *>(draw->pUser);
+  if (!component || component->png_rgba_.empty()) {
+    return 0;
+  }
+  
+  RegionPass &pass = component->region_;
+  if (draw->y >= pass.y1) {
+    pass.done = true;
+    return 0;
+  }
+  if (draw->y >= pass.y0) {
+    // Seules les colonnes de la fenêtre sont développées
+    int count = pass.x1 - pass.x0;
+    png_row_to_rgba(png_row_format(draw), draw->pPixels, pass.x0, count, component->png_rgba_.data());
+    kernels::rgba_to_rgb565(component->png_rgba_.data(),
+                            pass.dst + ((draw->y - pass.dst_y) * pass.stride + (pass.x0 - pass.dst_x)) * 2, count,
+                            component->is_big_endian_());
+  }
+  if (draw->y % 16 == 0) {
+    decode_yield();
+  }
+  return 1;
 }
 
-#endif // USE_PNGLE
+#endif // USE_PNGDEC
 
 // =====================================================
 // GIF Decoder Implementation
@@ -1064,21 +3623,20 @@ void SdImageComponent::png_draw_callback_no_resize(pngle_t *pngle, uint32_t x, u
 bool SdImageComponent::decode_gif_image(const std::vector<uint8_t> &gif_data) {
   ESP_LOGD(TAG_IMAGE, "Using AnimatedGIF decoder for first frame");
   
-  current_image_component = this;
   
   this->gif_decoder_ = new ANIMATEDGIF();
   if (!this->gif_decoder_) {
     ESP_LOGE(TAG_IMAGE, "Failed to allocate GIF decoder");
-    current_image_component = nullptr;
     return false;
   }
+  this->gif_decoder_->begin(this->is_big_endian_() ? GIF_PALETTE_RGB565_BE : GIF_PALETTE_RGB565_LE);
   
+  // open() renvoie 1 en cas de succès
   int result = this->gif_decoder_->open((uint8_t*)gif_data.data(), gif_data.size(), GIFDraw);
-  if (result != GIF_SUCCESS) {
+  if (!result) {
     ESP_LOGE(TAG_IMAGE, "Failed to open GIF data: %d", result);
     delete this->gif_decoder_;
     this->gif_decoder_ = nullptr;
-    current_image_component = nullptr;
     return false;
   }
   
@@ -1095,46 +3653,44 @@ bool SdImageComponent::decode_gif_image(const std::vector<uint8_t> &gif_data) {
     this->gif_decoder_->close();
     delete this->gif_decoder_;
     this->gif_decoder_ = nullptr;
-    current_image_component = nullptr;
     return false;
   }
   
   // Set dimensions and format
-  this->image_width_ = gif_info.iWidth;
-  this->image_height_ = gif_info.iHeight;
-  this->format_ = ImageFormat::RGB565;
+  bool resizing = this->resize_width_ > 0 && this->resize_height_ > 0 &&
+                  (this->resize_width_ != gif_info.iWidth || this->resize_height_ != gif_info.iHeight);
+  this->decode_.width = gif_info.iWidth;
+  this->decode_.height = gif_info.iHeight;
+  this->decode_.format = this->decode_format_(!resizing);
   
   // Allocate buffer
   if (!this->allocate_image_buffer()) {
     this->gif_decoder_->close();
     delete this->gif_decoder_;
     this->gif_decoder_ = nullptr;
-    current_image_component = nullptr;
     return false;
   }
   
   ESP_LOGI(TAG_IMAGE, "Decoding first frame of GIF...");
   
   // Decode first frame
-  result = this->gif_decoder_->playFrame(true, nullptr);
+  // 1 = d'autres frames suivent, 0 = dernière frame, < 0 = erreur
+  result = this->gif_decoder_->playFrame(false, nullptr, this);
   
   this->gif_decoder_->close();
   delete this->gif_decoder_;
   this->gif_decoder_ = nullptr;
-  current_image_component = nullptr;
   
-  if (result != GIF_SUCCESS) {
+  if (result < 0) {
     ESP_LOGE(TAG_IMAGE, "Failed to decode GIF frame: %d", result);
     return false;
   }
   
   // Apply resize if needed
-  int orig_width = this->image_width_;
-  int orig_height = this->image_height_;
+  int orig_width = this->decode_.width;
+  int orig_height = this->decode_.height;
   
-  if (this->resize_width_ > 0 && this->resize_height_ > 0 &&
-      (this->resize_width_ != orig_width || this->resize_height_ != orig_height)) {
-    
+  if (resizing) {
     ESP_LOGI(TAG_IMAGE, "Resizing GIF from %dx%d to %dx%d", 
              orig_width, orig_height, this->resize_width_, this->resize_height_);
     
@@ -1144,53 +3700,83 @@ bool SdImageComponent::decode_gif_image(const std::vector<uint8_t> &gif_data) {
       return false;
     }
     
-    this->image_width_ = this->resize_width_;
-    this->image_height_ = this->resize_height_;
+    this->decode_.width = this->resize_width_;
+    this->decode_.height = this->resize_height_;
   }
   
   ESP_LOGI(TAG_IMAGE, "GIF processed successfully: %dx%d", 
-           this->image_width_, this->image_height_);
+           this->decode_.width, this->decode_.height);
   
   return true;
 }
 
 // GIF draw callback
 void SdImageComponent::GIFDraw(GIFDRAW *pDraw) {
-  if (!current_image_component || !pDraw || !pDraw->pPixels) {
+  if (!pDraw || !pDraw->pUser || !pDraw->pPixels) {
     return;
   }
   
-  SdImageComponent *component = current_image_component;
-  uint16_t *pixels = (uint16_t *)pDraw->pPixels;
+  SdImageComponent *component = static_cast<SdImageComponent *>(pDraw->pUser);
   
-  // Convert from GIF palette to RGB565 and store
-  for (int py = 0; py < pDraw->iHeight; py++) {
-    for (int px = 0; px < pDraw->iWidth; px++) {
-      int img_x = pDraw->iX + px;
-      int img_y = pDraw->iY + py;
-      
-      if (img_x >= 0 && img_x < component->image_width_ && 
-          img_y >= 0 && img_y < component->image_height_) {
-        
-        uint16_t rgb565 = pixels[py * pDraw->iWidth + px];
-        size_t offset = (img_y * component->image_width_ + img_x) * 2;
-        
-        if (offset + 1 < component->image_buffer_.size()) {
-          if (component->byte_order_ == SdByteOrder::BIG_ENDIAN_SD) {
-            component->image_buffer_[offset] = (rgb565 >> 8) & 0xFF;
-            component->image_buffer_[offset + 1] = rgb565 & 0xFF;
-          } else {
-            component->image_buffer_[offset] = rgb565 & 0xFF;
-            component->image_buffer_[offset + 1] = (rgb565 >> 8) & 0xFF;
-          }
-        }
-      }
+  // Une ligne par appel (pDraw->y dans la frame): indices 8 bits dans la palette RGB565
+  int img_y = pDraw->iY + pDraw->y;
+  if (img_y < 0 || img_y >= component->decode_.height || !pDraw->pPalette) {
+    return;
+  }
+  
+  const uint8_t *indices = pDraw->pPixels;
+  bool compact = is_compact_format(component->decode_.format);
+  uint8_t *row = component->decode_.buffer.data() +
+                 img_y * image_row_bytes(component->decode_.format, component->decode_.width);
+  for (int px = 0; px < pDraw->iWidth; px++) {
+    int img_x = pDraw->iX + px;
+    if (img_x < 0 || img_x >= component->decode_.width) {
+      continue;
+    }
+    if (pDraw->ucHasTransparency && indices[px] == pDraw->ucTransparent) {
+      continue;
     }
     
-    if (py % 16 == 0) {
-      App.feed_wdt();
-      yield();
+    // Palette dans l'ordre de l'écran (begin()): stockée telle quelle
+    if (compact) {
+      component->quantizer_.put_row565(row, img_x, img_y, (const uint8_t *) &pDraw->pPalette[indices[px]], 1,
+                                       component->is_big_endian_());
+    } else {
+      memcpy(row + img_x * 2, &pDraw->pPalette[indices[px]], 2);
+    }
+  }
+  
+  if (img_y % 16 == 0) {
+    decode_yield();
+  }
+}
+
+// Viewport: lignes et colonnes hors fenêtre ignorées
+void SdImageComponent::gif_region_callback(GIFDRAW *pDraw) {
+  if (!pDraw || !pDraw->pUser || !pDraw->pPixels || !pDraw->pPalette) {
+    return;
+  }
+  
+  SdImageComponent *component = static_cast<SdImageComponent *>(pDraw->pUser);
+  const RegionPass &pass = component->region_;
+  int y = pDraw->iY + pDraw->y;
+  if (y < pass.y0 || y >= pass.y1) {
+    return;
+  }
+  
+  const uint8_t *indices = pDraw->pPixels;
+  int x_start = std::max(pass.x0, pDraw->iX);
+  int x_end = std::min(pass.x1, pDraw->iX + pDraw->iWidth);
+  for (int x = x_start; x < x_end; x++) {
+    uint8_t index = indices[x - pDraw->iX];
+    if (pDraw->ucHasTransparency && index == pDraw->ucTransparent) {
+      continue;
     }
+    component->region_put_(x, y, pDraw->pPalette[index]);
+  }
+  
+  if (y % 16 == 0) {
+    decode_yield();
   }
 }
 
@@ -1212,7 +3798,8 @@ void SdImageComponent::GIFDraw(GIFDRAW *pDraw) {
 // =====================================================
 
 bool SdImageComponent::resize_image_buffer(int src_width, int src_height, int dst_width, int dst_height) {
-  if (this->image_buffer_.empty()) {
+  LoadPhaseTimer timer(this->decode_stats_, LOAD_PHASE_RESIZE);
+  if (this->decode_.buffer.empty()) {
     ESP_LOGE(TAG_IMAGE, "Source buffer is empty");
     return false;
   }
@@ -1222,47 +3809,51 @@ bool SdImageComponent::resize_image_buffer(int src_width, int src_height, int ds
     return false;
   }
   
+  if (this->decode_.buffer.size() < (size_t) src_width * src_height * 2) {
+    ESP_LOGE(TAG_IMAGE, "Source buffer too small for %dx%d", src_width, src_height);
+    return false;
+  }
+  
   // Create new buffer for resized image
-  std::vector<uint8_t> new_buffer(dst_width * dst_height * 2); // RGB565
+  ImageBuffer new_buffer;
+  if (!new_buffer.allocate(dst_width * dst_height * 2, this->placement_)) { // RGB565
+    ESP_LOGE(TAG_IMAGE, "Failed to allocate resize buffer for %dx%d", dst_width, dst_height);
+    return false;
+  }
+  // Source et destination coexistent: pic mémoire du redimensionnement
+  this->decode_stats_.sample_heap();
   
-  // Simple nearest-neighbor resize
-  float scale_x = (float)src_width / dst_width;
-  float scale_y = (float)src_height / dst_height;
+  ESP_LOGI(TAG_IMAGE, "Resizing %dx%d -> %dx%d (nearest)", src_width, src_height, dst_width, dst_height);
   
-  ESP_LOGI(TAG_IMAGE, "Resizing %dx%d -> %dx%d (scale: %.3f, %.3f)", 
-           src_width, src_height, dst_width, dst_height, scale_x, scale_y);
+  // Simple nearest-neighbor resize: colonnes source calculées une fois
+  std::vector<uint16_t> x_map(dst_width);
+  for (int dst_x = 0; dst_x < dst_width; dst_x++) {
+    x_map[dst_x] = kernels::nearest_source(dst_x, src_width, dst_width);
+  }
   
+  const uint8_t *src = this->decode_.buffer.data();
+  uint8_t *dst = new_buffer.data();
+  size_t dst_row_bytes = dst_width * 2;
+  int prev_src_y = -1;
   for (int dst_y = 0; dst_y < dst_height; dst_y++) {
-    for (int dst_x = 0; dst_x < dst_width; dst_x++) {
-      
-      // Find corresponding source pixel
-      int src_x = (int)(dst_x * scale_x);
-      int src_y = (int)(dst_y * scale_y);
-      
-      // Clamp to source bounds
-      if (src_x >= src_width) src_x = src_width - 1;
-      if (src_y >= src_height) src_y = src_height - 1;
-      
-      // Copy pixel
-      size_t src_offset = (src_y * src_width + src_x) * 2;
-      size_t dst_offset = (dst_y * dst_width + dst_x) * 2;
-      
-      if (src_offset + 1 < this->image_buffer_.size() && 
-          dst_offset + 1 < new_buffer.size()) {
-        new_buffer[dst_offset] = this->image_buffer_[src_offset];
-        new_buffer[dst_offset + 1] = this->image_buffer_[src_offset + 1];
-      }
+    int src_y = kernels::nearest_source(dst_y, src_height, dst_height);
+    uint8_t *dst_row = dst + dst_y * dst_row_bytes;
+    if (src_y == prev_src_y) {
+      // Agrandissement: même ligne source que la précédente
+      memcpy(dst_row, dst_row - dst_row_bytes, dst_row_bytes);
+    } else {
+      kernels::gather565(src + src_y * src_width * 2, x_map.data(), dst_row, dst_width);
     }
+    prev_src_y = src_y;
     
     // Yield periodically
     if (dst_y % 32 == 0) {
-      App.feed_wdt();
-      yield();
+      decode_yield();
     }
   }
   
   // Replace buffer
-  this->image_buffer_ = std::move(new_buffer);
+  this->decode_.buffer = std::move(new_buffer);
   
   ESP_LOGI(TAG_IMAGE, "Image resized successfully from %dx%d to %dx%d", 
            src_width, src_height, dst_width, dst_height);
@@ -1271,7 +3862,8 @@ bool SdImageComponent::resize_image_buffer(int src_width, int src_height, int ds
 }
 
 bool SdImageComponent::resize_image_buffer_bilinear(int src_width, int src_height, int dst_width, int dst_height) {
-  if (this->image_buffer_.empty()) {
+  LoadPhaseTimer timer(this->decode_stats_, LOAD_PHASE_RESIZE);
+  if (this->decode_.buffer.empty()) {
     ESP_LOGE(TAG_IMAGE, "Source buffer is empty");
     return false;
   }
@@ -1281,78 +3873,289 @@ bool SdImageComponent::resize_image_buffer_bilinear(int src_width, int src_heigh
     return false;
   }
   
-  std::vector<uint8_t> new_buffer(dst_width * dst_height * 2);
+  if (this->decode_.buffer.size() < (size_t) src_width * src_height * 2) {
+    ESP_LOGE(TAG_IMAGE, "Source buffer too small for %dx%d", src_width, src_height);
+    return false;
+  }
   
-  float scale_x = (float)(src_width - 1) / (dst_width - 1);
-  float scale_y = (float)(src_height - 1) / (dst_height - 1);
+  ImageBuffer new_buffer;
+  if (!new_buffer.allocate(dst_width * dst_height * 2, this->placement_)) {
+    ESP_LOGE(TAG_IMAGE, "Failed to allocate resize buffer for %dx%d", dst_width, dst_height);
+    return false;
+  }
+  // Source et destination coexistent: pic mémoire du redimensionnement
+  this->decode_stats_.sample_heap();
   
   ESP_LOGI(TAG_IMAGE, "Bilinear resizing %dx%d -> %dx%d", src_width, src_height, dst_width, dst_height);
+  bilinear_resize565(this->decode_.buffer.data(), src_width, src_height, new_buffer.data(), dst_width, dst_height,
+                     this->is_big_endian_());
   
-  for (int dst_y = 0; dst_y < dst_height; dst_y++) {
-    for (int dst_x = 0; dst_x < dst_width; dst_x++) {
-      
-      float src_x_f = dst_x * scale_x;
-      float src_y_f = dst_y * scale_y;
-      
-      int src_x0 = (int)src_x_f;
-      int src_y0 = (int)src_y_f;
-      int src_x1 = std::min(src_x0 + 1, src_width - 1);
-      int src_y1 = std::min(src_y0 + 1, src_height - 1);
-      
-      float dx = src_x_f - src_x0;
-      float dy = src_y_f - src_y0;
-      
-      // Get 4 surrounding pixels
-      auto get_pixel = [&](int x, int y) -> uint16_t {
-        size_t offset = (y * src_width + x) * 2;
-        if (offset + 1 < this->image_buffer_.size()) {
-          return this->image_buffer_[offset] | (this->image_buffer_[offset + 1] << 8);
-        }
-        return 0;
-      };
-      
-      uint16_t p00 = get_pixel(src_x0, src_y0);
-      uint16_t p01 = get_pixel(src_x0, src_y1);
-      uint16_t p10 = get_pixel(src_x1, src_y0);
-      uint16_t p11 = get_pixel(src_x1, src_y1);
-      
-      // Interpolate RGB components separately
-      auto interpolate_rgb565 = [](uint16_t p00, uint16_t p01, uint16_t p10, uint16_t p11, 
-                                  float dx, float dy) -> uint16_t {
-        // Extract RGB components
-        uint8_t r00 = (p00 >> 11) & 0x1F, g00 = (p00 >> 5) & 0x3F, b00 = p00 & 0x1F;
-        uint8_t r01 = (p01 >> 11) & 0x1F, g01 = (p01 >> 5) & 0x3F, b01 = p01 & 0x1F;
-        uint8_t r10 = (p10 >> 11) & 0x1F, g10 = (p10 >> 5) & 0x3F, b10 = p10 & 0x1F;
-        uint8_t r11 = (p11 >> 11) & 0x1F, g11 = (p11 >> 5) & 0x3F, b11 = p11 & 0x1F;
-        
-        // Bilinear interpolation
-        float r = r00 * (1-dx) * (1-dy) + r10 * dx * (1-dy) + r01 * (1-dx) * dy + r11 * dx * dy;
-        float g = g00 * (1-dx) * (1-dy) + g10 * dx * (1-dy) + g01 * (1-dx) * dy + g11 * dx * dy;
-        float b = b00 * (1-dx) * (1-dy) + b10 * dx * (1-dy) + b01 * (1-dx) * dy + b11 * dx * dy;
-        
-        return ((uint16_t)r << 11) | ((uint16_t)g << 5) | (uint16_t)b;
-      };
-      
-      uint16_t result = interpolate_rgb565(p00, p01, p10, p11, dx, dy);
-      
-      size_t dst_offset = (dst_y * dst_width + dst_x) * 2;
-      if (dst_offset + 1 < new_buffer.size()) {
-        new_buffer[dst_offset] = result & 0xFF;
-        new_buffer[dst_offset + 1] = (result >> 8) & 0xFF;
+  this->decode_.buffer = std::move(new_buffer);
+  
+  ESP_LOGI(TAG_IMAGE, "Image resized with bilinear interpolation from %dx%d to %dx%d", 
+           src_width, src_height, dst_width, dst_height);
+  
+  return true;
+}
+
+// =====================================================
+// QOI Decoder Implementation
+// =====================================================
+
+bool SdImageComponent::decode_qoi_image(const std::vector<uint8_t> &qoi_data) {
+  QoiDecoder decoder;
+  if (!decoder.begin(qoi_data.data(), qoi_data.size())) {
+    ESP_LOGE(TAG_IMAGE, "Invalid QOI header");
+    return false;
+  }
+  if (!this->begin_qoi_target_(decoder)) {
+    return false;
+  }
+  
+  int width = this->decode_.width;
+  int height = this->decode_.height;
+  std::vector<uint8_t> row(width * 4);
+  for (int y = 0; y < height; y++) {
+    if (!decoder.decode_row(row.data())) {
+      ESP_LOGE(TAG_IMAGE, "QOI data truncated at row %d", y);
+      return false;
+    }
+    this->put_rgba_row_(y, row.data(), width);
+    if (y % 16 == 0) {
+      decode_yield();
+    }
+  }
+  
+  if (!this->finish_resize_("QOI", width, height)) {
+    return false;
+  }
+  ESP_LOGI(TAG_IMAGE, "QOI processed successfully: %dx%d", this->decode_.width, this->decode_.height);
+  return true;
+}
+
+bool SdImageComponent::begin_qoi_target_(const QoiDecoder &decoder) {
+  int orig_width = decoder.get_header().width;
+  int orig_height = decoder.get_header().height;
+  ESP_LOGI(TAG_IMAGE, "QOI dimensions: %dx%d, %u channels", orig_width, orig_height, decoder.get_header().channels);
+  if (orig_width > 2048 || orig_height > 2048) {
+    ESP_LOGE(TAG_IMAGE, "Invalid QOI dimensions: %dx%d", orig_width, orig_height);
+    return false;
+  }
+  
+  // Une ligne RGBA à la fois, convertie directement vers le format de sortie
+  // (RGB888/RGBA compris); RGB565 quand le redimensionnement suit
+  bool resizing = this->resize_width_ > 0 && this->resize_height_ > 0 &&
+                  (this->resize_width_ != orig_width || this->resize_height_ != orig_height);
+  this->decode_.width = orig_width;
+  this->decode_.height = orig_height;
+  this->decode_.format = resizing ? ImageFormat::RGB565 : this->output_format_;
+  return this->allocate_image_buffer();
+}
+
+bool SdImageComponent::finish_resize_(const char *kind, int width, int height) {
+  if (this->resize_width_ <= 0 || this->resize_height_ <= 0 ||
+      (this->resize_width_ == width && this->resize_height_ == height)) {
+    return true;
+  }
+  ESP_LOGI(TAG_IMAGE, "Resizing %s from %dx%d to %dx%d", kind, width, height, this->resize_width_,
+           this->resize_height_);
+  if (!this->resize_image_buffer(width, height, this->resize_width_, this->resize_height_)) {
+    ESP_LOGE(TAG_IMAGE, "Failed to resize %s image", kind);
+    return false;
+  }
+  this->decode_.width = this->resize_width_;
+  this->decode_.height = this->resize_height_;
+  return true;
+}
+
+bool SdImageComponent::save_qoi(const std::string &path) {
+  if (!this->storage_component_ || !this->image_loaded_ || this->image_buffer_.empty()) {
+    ESP_LOGW(TAG_IMAGE, "Nothing to save: %s is not loaded", this->file_path_.c_str());
+    return false;
+  }
+  
+  std::string full_path = this->storage_component_->get_root_path() + path;
+  FILE *file = fopen(full_path.c_str(), "wb");
+  if (!file) {
+    ESP_LOGE(TAG_IMAGE, "Cannot create %s", full_path.c_str());
+    return false;
+  }
+  
+  int width = this->get_current_width();
+  int height = this->get_current_height();
+  bool big_endian = this->is_big_endian_();
+  QoiEncoder encoder;
+  bool success = encoder.begin(width, height, this->format_ == ImageFormat::RGBA ? 4 : 3,
+                               [file](const uint8_t *data, size_t len) { return fwrite(data, 1, len, file) == len; });
+  
+  // Lignes encodées telles quelles quand c'est possible, sinon via get_pixel_color
+  std::vector<uint8_t> row;
+  for (int y = 0; y < height && success; y++) {
+    if (this->compression_ != RamCompression::NONE) {
+      row.resize(width * 2);
+      ram_decode_row(this->compression_, ram_row(this->image_buffer_.data(), height, y), width, big_endian,
+                     row.data());
+      success = encoder.write_row_rgb565(row.data(), big_endian);
+    } else if (this->format_ == ImageFormat::RGB565) {
+      success = encoder.write_row_rgb565(this->image_buffer_.data() + y * width * 2, big_endian);
+    } else if (this->format_ == ImageFormat::RGBA) {
+      success = encoder.write_row_rgba(this->image_buffer_.data() + y * width * 4);
+    } else {
+      row.resize(width * 4);
+      for (int x = 0; x < width; x++) {
+        Color c = this->get_pixel_color(x, y);
+        row[x * 4] = c.r;
+        row[x * 4 + 1] = c.g;
+        row[x * 4 + 2] = c.b;
+        row[x * 4 + 3] = 255;
       }
+      success = encoder.write_row_rgba(row.data());
     }
-    
-    if (dst_y % 16 == 0) {
+    if (y % 16 == 0) {
       App.feed_wdt();
-      yield();
     }
   }
+  success = encoder.finish() && success;
+  fclose(file);
+  this->storage_component_->invalidate_probe(path);
+  
+  if (!success) {
+    ESP_LOGE(TAG_IMAGE, "Failed to write %s", full_path.c_str());
+    return false;
+  }
+  ESP_LOGI(TAG_IMAGE, "Saved %dx%d as QOI: %s (%zu bytes)", width, height, path.c_str(), encoder.get_bytes_written());
+  return true;
+}
+
+// =====================================================
+// Raw / BMP Loader Implementation
+// =====================================================
+
+bool SdImageComponent::raw_layout_(const uint8_t *head, size_t head_size, uint32_t file_size,
+                                   RawLayout &layout) const {
+  if (is_bmp_data(head, head_size)) {
+    return bmp_read_layout(head, head_size, file_size, layout);
+  }
+  if (this->raw_width_ > 0) {
+    return raw_layout_from_size(this->raw_width_, this->raw_height_, file_size, layout);
+  }
+  return lvgl_bin_read_layout(head, head_size, file_size, layout);
+}
+
+FILE *SdImageComponent::open_raw_(const std::string &full_path, RawLayout &layout) const {
+  FILE *file = fopen(full_path.c_str(), "rb");
+  if (!file) {
+    return nullptr;
+  }
+  std::vector<uint8_t> header(RAW_HEADER_SIZE);
+  header.resize(fread(header.data(), 1, header.size(), file));
+  long file_size = fseek(file, 0, SEEK_END) == 0 ? ftell(file) : 0;
+  FileType type = file_size > 0 ? this->detect_file_type(header, file_size) : FileType::UNKNOWN;
+  if ((type == FileType::BMP || type == FileType::RAW) &&
+      this->raw_layout_(header.data(), header.size(), file_size, layout)) {
+    return file;
+  }
+  // Autre format, ou BMP/raw non lisible directement: decode_image() signale l'erreur
+  fclose(file);
+  return nullptr;
+}
+
+bool SdImageComponent::load_raw_(const RawLayout &layout, const RawReadFn &read) {
+  bool direct;
+  if (!this->begin_raw_target_(layout, direct)) {
+    return false;
+  }
   
-  this->image_buffer_ = std::move(new_buffer);
+  int width = layout.width;
+  int height = layout.height;
+  size_t src_row = width * raw_pixel_size(layout.pixels);
+  if (direct && !layout.bottom_up && layout.stride == src_row) {
+    // Pixels contigus: une seule lecture pour toute l'image
+    if (!read(layout.data_offset, this->decode_.buffer.data(), src_row * height)) {
+      ESP_LOGE(TAG_IMAGE, "Raw data truncated");
+      return false;
+    }
+  } else {
+    std::vector<uint8_t> src(direct ? 0 : src_row);
+    std::vector<uint8_t> rgba(direct ? 0 : width * 4);
+    for (int i = 0; i < height; i++) {
+      if (!this->read_raw_row_(layout, i, direct, read, src.data(), rgba.data())) {
+        return false;
+      }
+      if (i % 16 == 0) {
+        decode_yield();
+      }
+    }
+  }
+  return this->finish_raw_(layout, direct);
+}
+
+bool SdImageComponent::begin_raw_target_(const RawLayout &layout, bool &direct) {
+  int width = layout.width;
+  int height = layout.height;
+  ESP_LOGI(TAG_IMAGE, "Raw pixels: %dx%d, %zu bytes per pixel%s", width, height, raw_pixel_size(layout.pixels),
+           layout.bottom_up ? ", bottom-up" : "");
+  
+  bool resizing = this->resize_width_ > 0 && this->resize_height_ > 0 &&
+                  (this->resize_width_ != width || this->resize_height_ != height);
+  this->decode_.width = width;
+  this->decode_.height = height;
+  this->decode_.format = resizing ? ImageFormat::RGB565 : this->output_format_;
+  if (!this->allocate_image_buffer()) {
+    return false;
+  }
   
-  ESP_LOGI(TAG_IMAGE, "Image resized with bilinear interpolation from %dx%d to %dx%d", 
-           src_width, src_height, dst_width, dst_height);
+  // Même disposition que le buffer, à une correction en place près: lecture directe
+  switch (layout.pixels) {
+    case RawPixels::RGB565_LE:
+      direct = this->decode_.format == ImageFormat::RGB565;
+      break;
+    case RawPixels::RGB888:
+    case RawPixels::BGR888:
+      direct = this->decode_.format == ImageFormat::RGB888;
+      break;
+    default:
+      direct = this->decode_.format == ImageFormat::RGBA;
+      break;
+  }
+  return true;
+}
+
+bool SdImageComponent::read_raw_row_(const RawLayout &layout, int index, bool direct, const RawReadFn &read,
+                                     uint8_t *src, uint8_t *rgba) {
+  // Ordre du fichier (BMP: de bas en haut), chaque ligne lue à sa place finale
+  int width = layout.width;
+  int y = layout.bottom_up ? layout.height - 1 - index : index;
+  size_t src_row = width * raw_pixel_size(layout.pixels);
+  uint8_t *dst = direct ? this->decode_.buffer.data() + y * src_row : src;
+  if (!read(layout.row_offset(y), dst, src_row)) {
+    ESP_LOGE(TAG_IMAGE, "Raw data truncated at row %d", y);
+    return false;
+  }
+  if (!direct) {
+    raw_row_to_rgba(layout.pixels, src, rgba, width);
+    this->put_rgba_row_(y, rgba, width);
+  }
+  return true;
+}
+
+bool SdImageComponent::finish_raw_(const RawLayout &layout, bool direct) {
+  int width = layout.width;
+  int height = layout.height;
+  if (direct) {
+    LoadPhaseTimer timer(this->decode_stats_, LOAD_PHASE_CONVERT);
+    uint8_t *buffer = this->decode_.buffer.data();
+    if (layout.pixels == RawPixels::RGB565_LE && this->is_big_endian_()) {
+      kernels::swap565(buffer, (size_t) width * height);
+    }
+    raw_swap_red_blue(layout.pixels, buffer, width * height);
+  }
   
+  if (!this->finish_resize_("raw", width, height)) {
+    return false;
+  }
+  ESP_LOGI(TAG_IMAGE, "Raw image read %s: %dx%d", direct ? "directly" : "with conversion", this->decode_.width,
+           this->decode_.height);
   return true;
 }
 
@@ -1368,97 +4171,183 @@ bool SdImageComponent::allocate_image_buffer() {
     return false;
   }
   
-  this->image_buffer_.clear();
+  this->decode_.buffer.release();
   
-  // Use reserve and resize without try-catch since exceptions are disabled
-  this->image_buffer_.reserve(buffer_size);
-  if (this->image_buffer_.capacity() < buffer_size) {
-    ESP_LOGE(TAG_IMAGE, "Failed to reserve %zu bytes for image buffer", buffer_size);
+  // Depuis la tâche de chargement, la réservation (et l'éviction) attend la publication
+  if (!this->decode_.background && this->storage_component_ &&
+      !this->storage_component_->reserve_image_memory(this, buffer_size + this->staged_.buffer.size())) {
+    ESP_LOGE(TAG_IMAGE, "Memory budget refused %zu bytes for %s", buffer_size, this->file_path_.c_str());
     return false;
   }
   
-  this->image_buffer_.resize(buffer_size, 0);
-  if (this->image_buffer_.size() != buffer_size) {
-    ESP_LOGE(TAG_IMAGE, "Failed to allocate %zu bytes for image buffer", buffer_size);
-    this->image_buffer_.clear();
+  this->decode_.compression = RamCompression::NONE;
+  this->decode_.ops =
+      is_compact_format(this->decode_.format) ? nullptr : &get_pixel_ops(this->decode_.format, this->byte_order_);
+  
+  // Arena slot (or heap fallback) with the configured placement, zero-filled
+  if (!this->decode_.buffer.allocate(buffer_size, this->placement_)) {
+    ESP_LOGE(TAG_IMAGE, "Failed to allocate %zu bytes for image buffer (%s)", 
+             buffer_size, placement_to_string(this->placement_));
     return false;
   }
   
-  ESP_LOGD(TAG_IMAGE, "Allocated image buffer: %zu bytes", buffer_size);
+  this->decode_stats_.sample_heap();
+  ESP_LOGD(TAG_IMAGE, "Allocated image buffer: %zu bytes (%s, %s)", buffer_size,
+           placement_to_string(this->placement_), this->decode_.buffer.is_in_arena() ? "arena" : "heap");
+  if (this->storage_component_) {
+    this->storage_component_->notify_memory_changed();
+  }
   return true;
 }
 
 void SdImageComponent::set_pixel(int x, int y, uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
-  if (x < 0 || x >= this->image_width_ || y < 0 || y >= this->image_height_) {
+  if (x < 0 || x >= this->decode_.width || y < 0 || y >= this->decode_.height) {
+    return;
+  }
+  
+  if (is_compact_format(this->decode_.format)) {
+    size_t row_bytes = image_row_bytes(this->decode_.format, this->decode_.width);
+    if ((y + 1) * row_bytes > this->decode_.buffer.size()) {
+      return;
+    }
+    // Pas d'alpha dans les formats compacts: transparent -> fond blanc
+    if (a < 128) {
+      r = g = b = 255;
+    }
+    this->quantizer_.put(&this->decode_.buffer[y * row_bytes], x, y, r, g, b);
     return;
   }
   
-  size_t offset = (y * this->image_width_ + x) * this->get_pixel_size();
+  const PixelOps *ops = this->decode_.ops;
+  if (ops == nullptr) {
+    return;
+  }
   
-  if (offset + this->get_pixel_size() > this->image_buffer_.size()) {
+  size_t offset = (y * this->decode_.width + x) * ops->size;
+  if (offset + ops->size > this->decode_.buffer.size()) {
     return;
   }
   
-  switch (this->format_) {
-    case ImageFormat::RGB565: {
-      uint16_t rgb565 = ((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3);
-      
-      if (this->byte_order_ == SdByteOrder::BIG_ENDIAN_SD) {
-        // Big endian: MSB en premier
-        this->image_buffer_[offset] = (rgb565 >> 8) & 0xFF;
-        this->image_buffer_[offset + 1] = rgb565 & 0xFF;
-      } else {
-        // Little endian: LSB en premier (défaut)
-        this->image_buffer_[offset] = rgb565 & 0xFF;
-        this->image_buffer_[offset + 1] = (rgb565 >> 8) & 0xFF;
-      }
-      break;
+  // Écrivain spécialisé choisi une fois à l'allocation
+  ops->pack(&this->decode_.buffer[offset], r, g, b, a);
+}
+
+void SdImageComponent::put_rgba_row_(int y, const uint8_t *rgba, int width) {
+  uint8_t *dst = this->decode_.buffer.data() + y * image_row_bytes(this->decode_.format, width);
+  if (this->decode_.format == ImageFormat::RGB565) {
+    kernels::rgba_to_rgb565(rgba, dst, width, this->is_big_endian_());
+  } else if (is_compact_format(this->decode_.format)) {
+    for (int x = 0; x < width; x++, rgba += 4) {
+      this->set_pixel(x, y, rgba[0], rgba[1], rgba[2], rgba[3]);
     }
-    case ImageFormat::RGB888:
-      this->image_buffer_[offset] = r;
-      this->image_buffer_[offset + 1] = g;
-      this->image_buffer_[offset + 2] = b;
-      break;
-    case ImageFormat::RGBA:
-      this->image_buffer_[offset] = r;
-      this->image_buffer_[offset + 1] = g;
-      this->image_buffer_[offset + 2] = b;
-      this->image_buffer_[offset + 3] = a;
-      break;
+  } else {
+    this->decode_.ops->from_rgba_row(rgba, dst, width);
   }
 }
 
 size_t SdImageComponent::get_pixel_size() const {
-  switch (this->format_) {
-    case ImageFormat::RGB565: return 2;
-    case ImageFormat::RGB888: return 3;
-    case ImageFormat::RGBA: return 4;
-    default: return 2;
-  }
+  // BINARY: 1 (huit pixels par octet, lignes complétées)
+  return image_row_bytes(this->format_, 1);
 }
 
 size_t SdImageComponent::get_buffer_size() const {
-  return this->image_width_ * this->image_height_ * this->get_pixel_size();
+  return image_buffer_bytes(this->decode_.format, this->decode_.width, this->decode_.height);
 }
 
-std::string SdImageComponent::format_to_string() const {
-  switch (this->format_) {
-    case ImageFormat::RGB565: return "RGB565";
-    case ImageFormat::RGB888: return "RGB888";
-    case ImageFormat::RGBA: return "RGBA";
-    default: return "Unknown";
+bool SdImageComponent::compress_decoded_() {
+  if (this->ram_compression_ == RamCompression::NONE || this->decode_.format != ImageFormat::RGB565 ||
+      this->decode_.compression != RamCompression::NONE) {
+    return true;
+  }
+  
+  int width = this->decode_.width;
+  int height = this->decode_.height;
+  size_t raw_size = (size_t) width * height * 2;
+  if (this->decode_.buffer.size() < raw_size) {
+    return false;
+  }
+  
+  std::vector<uint8_t> encoded;
+  encoded.reserve(raw_size / 4);
+  ram_encode_image(this->ram_compression_, this->decode_.buffer.data(), width, height, this->is_big_endian_(),
+                   encoded);
+  // Photo ou bruit: le gain ne paie pas le développement à chaque draw
+  if (encoded.size() > raw_size * 3 / 4) {
+    ESP_LOGD(TAG_IMAGE, "%s gains too little (%zu -> %zu bytes), kept uncompressed",
+             ram_compression_to_string(this->ram_compression_), raw_size, encoded.size());
+    return true;
+  }
+  
+  ImageBuffer compressed;
+  if (!compressed.allocate(encoded.size(), this->placement_)) {
+    ESP_LOGW(TAG_IMAGE, "Failed to allocate %zu bytes for the compressed image, kept uncompressed", encoded.size());
+    return true;
+  }
+  memcpy(compressed.data(), encoded.data(), encoded.size());
+  this->decode_.buffer = std::move(compressed);
+  this->decode_.compression = this->ram_compression_;
+  ESP_LOGD(TAG_IMAGE, "Compressed in RAM (%s): %zu -> %zu bytes", ram_compression_to_string(this->ram_compression_),
+           raw_size, encoded.size());
+  return true;
+}
+
+ImageFormat SdImageComponent::decode_format_(bool final_size) const {
+  return final_size && is_compact_format(this->output_format_) ? this->output_format_ : ImageFormat::RGB565;
+}
+
+bool SdImageComponent::convert_decoded_() {
+  LoadPhaseTimer timer(this->decode_stats_, LOAD_PHASE_CONVERT);
+  return this->quantize_decoded_() && this->compress_decoded_();
+}
+
+bool SdImageComponent::quantize_decoded_() {
+  if (!is_compact_format(this->output_format_) || this->decode_.format != ImageFormat::RGB565) {
+    return true;
+  }
+  
+  int width = this->decode_.width;
+  int height = this->decode_.height;
+  size_t row_bytes = image_row_bytes(this->output_format_, width);
+  ImageBuffer compact;
+  if (this->decode_.buffer.size() < (size_t) width * height * 2 ||
+      !compact.allocate(row_bytes * height, this->placement_)) {
+    ESP_LOGE(TAG_IMAGE, "Failed to allocate %s buffer for %dx%d", image_format_to_string(this->output_format_), width,
+             height);
+    this->decode_.buffer.release();
+    return false;
+  }
+  
+  const uint8_t *src = this->decode_.buffer.data();
+  for (int y = 0; y < height; y++) {
+    this->quantizer_.put_row565(compact.data() + y * row_bytes, 0, y, src + y * width * 2, width,
+                                this->is_big_endian_());
+    if (y % 32 == 0) {
+      decode_yield();
+    }
   }
+  
+  this->decode_.buffer = std::move(compact);
+  this->decode_.format = this->output_format_;
+  this->decode_.ops = nullptr;
+  ESP_LOGD(TAG_IMAGE, "Quantized to %s: %dx%d, %zu bytes", image_format_to_string(this->output_format_), width,
+           height, this->decode_.buffer.size());
+  return true;
+}
+
+std::string SdImageComponent::format_to_string() const {
+  return image_format_to_string(this->format_);
 }
 
 std::string SdImageComponent::get_debug_info() const {
   char buffer[256];
   snprintf(buffer, sizeof(buffer), 
-    "SdImage[%s]: %dx%d, %s, loaded=%s, size=%zu bytes",
+    "SdImage[%s]: %dx%d, %s, loaded=%s, size=%zu bytes, last load %u ms (%s)",
     this->file_path_.c_str(),
     this->image_width_, this->image_height_,
     this->format_to_string().c_str(),
     this->image_loaded_ ? "yes" : "no",
-    this->image_buffer_.size()
+    this->image_buffer_.size(),
+    (unsigned) this->load_stats_.total_ms(), this->load_stats_.decoder
   );
   return std::string(buffer);
 }
@@ -1495,22 +4384,6 @@ void SdImageComponent::list_directory_contents(const std::string &dir_path) {
   ESP_LOGI(TAG_IMAGE, "Total files: %d", file_count);
 }
 
-bool SdImageComponent::extract_jpeg_dimensions(const std::vector<uint8_t> &data, int &width, int &height) const {
-  for (size_t i = 0; i < data.size() - 10; i++) {
-    if (data[i] == 0xFF) {
-      uint8_t marker = data[i + 1];
-      if (marker >= 0xC0 && marker <= 0xC3) {
-        if (i + 9 < data.size()) {
-          height = (data[i + 5] << 8) | data[i + 6];
-          width = (data[i + 7] << 8) | data[i + 8];
-          return true;
-        }
-      }
-    }
-  }
-  return false;
-}
-
 bool SdImageComponent::jpeg_decode_pixel(int x, int y, uint8_t r, uint8_t g, uint8_t b) {
   // Apply resize scaling if needed
   if (this->resize_width_ > 0 && this->resize_height_ > 0) {
@@ -1523,7 +4396,7 @@ bool SdImageComponent::jpeg_decode_pixel(int x, int y, uint8_t r, uint8_t g, uin
   }
   
   // Bounds check
-  if (x < 0 || x >= this->image_width_ || y < 0 || y >= this->image_height_) {
+  if (x < 0 || x >= this->decode_.width || y < 0 || y >= this->decode_.height) {
     return false;
   }
   
@@ -5,44 +5,33 @@
 #include <functional>
 #include <cstring>
 #include <cstdint>
+#include <atomic>
+#include <map>
+#include <set>
+#include "esphome/core/defines.h"
 #include "esphome/core/component.h"
 #include "esphome/core/automation.h"
 #include "esphome/core/optional.h"
+#ifdef USE_SENSOR
+#include "esphome/components/sensor/sensor.h"
+#endif
 #include "esphome/components/image/image.h"
 #include "esphome/components/display/display.h"
 #include "../sd_mmc_card/sd_mmc_card.h"
-
-// Image decoder configuration for ESP-IDF
-#ifdef ESP_IDF_VERSION
-  #define USE_JPEGDEC
-  #if defined(CONFIG_ESPHOME_ENABLE_PNGLE) || defined(USE_STORAGE_PNG_SUPPORT)
-    #define USE_PNGLE
-  #endif
-  #if defined(CONFIG_ESPHOME_ENABLE_ANIMATEDGIF) || defined(USE_STORAGE_GIF_SUPPORT)
-    #define USE_ANIMATEDGIF
-  #endif
-#else
-  #define USE_JPEGDEC
-  #if defined(ENABLE_PNGLE) || defined(USE_STORAGE_PNG_SUPPORT)
-    #define USE_PNGLE
-  #endif
-  #if defined(ENABLE_ANIMATEDGIF) || defined(USE_STORAGE_GIF_SUPPORT)
-    #define USE_ANIMATEDGIF
-  #endif
-#endif
-
-// Image decoders
-#ifdef USE_JPEGDEC
-#include <JPEGDEC.h>
-#endif
-
-#ifdef USE_PNGLE
-#include <pngle.h>
-#endif
-
-#ifdef USE_ANIMATEDGIF
-#include <AnimatedGIF.h>
-#endif
+#include "asset_pack.h"
+#include "image_arena.h"
+#include "image_loader.h"
+#include "load_stats.h"
+#include "pixel_pipeline.h"
+#include "ram_codec.h"
+#include "qoi_codec.h"
+#include "raw_image.h"
+#include "png_rows.h"
+#include "image_probe.h"
+#include "image_decoders.h"
+#include "thumbnail_cache.h"
+#include "lvgl_fs.h"
+#include "slideshow.h"
 
 namespace esphome {
 namespace storage {
@@ -50,23 +39,27 @@ namespace storage {
 // Forward declarations
 class StorageComponent;
 class SdImageComponent;
-
-// Image format enums
-enum class ImageFormat {
-  RGB565,
-  RGB888,
-  RGBA
-};
-
-enum class SdByteOrder {
-  LITTLE_ENDIAN_SD,
-  BIG_ENDIAN_SD
-};
+class GifPlayer;
 
 // =====================================================
 // StorageComponent - Main Storage Class AVEC AUTO_LOAD GLOBAL
 // =====================================================
 class StorageComponent : public Component {
+#ifdef USE_SENSOR
+  SUB_SENSOR(memory_used)
+  SUB_SENSOR(memory_usage)
+  SUB_SENSOR(arena_free)
+  SUB_SENSOR(arena_free_blocks)
+  SUB_SENSOR(arena_fragmentation)
+  // Dernier chargement terminé, toutes images confondues
+  SUB_SENSOR(load_time)
+  SUB_SENSOR(load_read_time)
+  SUB_SENSOR(load_decode_time)
+  SUB_SENSOR(load_resize_time)
+  SUB_SENSOR(load_convert_time)
+  SUB_SENSOR(load_bytes_read)
+  SUB_SENSOR(load_peak_heap)
+#endif
  public:
   StorageComponent() = default;
   
@@ -90,11 +83,75 @@ class StorageComponent : public Component {
   bool write_file_direct(const std::string &path, const std::vector<uint8_t> &data);
   size_t get_file_size(const std::string &path);
   
+  // Asset pack: opened once, entries loaded with one seek + one read
+  void set_asset_pack_path(const std::string &path) { this->asset_pack_path_ = path; }
+  const AssetPackEntry *find_asset(const std::string &name);
+  bool read_asset(const AssetPackEntry &entry, uint8_t *dst);
+  
+  // Dimensions/type lus dans les en-têtes seulement (quelques centaines d'octets),
+  // mis en cache par chemin; accepte aussi les chemins "pack:<name>"
+  bool probe_image(const std::string &path, ImageInfo &info);
+  void invalidate_probe(const std::string &path);
+  
+  // Vignettes d'un dossier: générées dans la loop quand le chargeur est inactif
+  void set_thumbnail_size(int width, int height) { this->thumbnails_.set_size(width, height); }
+  void set_thumbnail_byte_order_string(const std::string &order) {
+    this->thumbnails_.set_big_endian(order == "BIG_ENDIAN");
+  }
+  void set_thumbnail_folder(const std::string &folder) { this->thumbnail_folder_ = folder; }
+  bool open_thumbnail_folder(const std::string &folder);
+  ThumbnailCache *get_thumbnails() { return &this->thumbnails_; }
+  
+#ifdef USE_LVGL
+  // Lecteur LVGL ("S:/images/a.png"), enregistré au premier passage de loop() (après lv_init)
+  void set_lvgl_fs(char letter, uint16_t cache_size) {
+    this->lvgl_fs_enabled_ = true;
+    this->lvgl_fs_.set_letter(letter);
+    this->lvgl_fs_.set_cache_size(cache_size);
+  }
+  LvglFsDriver *get_lvgl_fs() { return &this->lvgl_fs_; }
+#endif
+  
   // NOUVEAU: Gestion des images SD enregistrées
   void register_sd_image(SdImageComponent *image) { this->sd_images_.push_back(image); }
   void load_all_images();
   void unload_all_images();
   
+  // Budget mémoire global (0 = illimité), éviction LRU sur la date du dernier draw()
+  void set_memory_budget(size_t bytes) { this->memory_budget_ = bytes; }
+  size_t get_memory_budget() const { return this->memory_budget_; }
+  size_t get_memory_used() const;
+  bool reserve_image_memory(SdImageComponent *requester, size_t bytes);
+  void notify_memory_changed() { this->memory_dirty_ = true; }
+  
+  // Arènes dédiées aux buffers d'images (0 = allocation heap classique)
+  void set_psram_arena_size(size_t bytes) { this->psram_arena_size_ = bytes; }
+  void set_internal_arena_size(size_t bytes) { this->internal_arena_size_ = bytes; }
+  void set_arena_compact_threshold(float threshold) { this->arena_compact_threshold_ = threshold; }
+  ArenaStats get_arena_stats() const;
+  
+  // Chargement en tâche de fond: draw() ne bloque jamais sur la SD/le décodeur
+  void set_background_loading(bool enabled) { this->background_loading_ = enabled; }
+  void set_loader_core(int core) { this->loader_core_ = core; }
+  void set_loader_workers(uint8_t workers) { this->loader_workers_ = workers; }
+  // Sans worker: décodage par tranches de `budget_us` dans loop() (0 = chargement synchrone)
+  void set_decode_budget(uint32_t budget_us) { this->loader_.set_slice_budget(budget_us); }
+  // Chargements asynchrones: workers, ou tranches sur la loop principale
+  bool is_background_loading() const { return this->loader_.is_running(); }
+  // PREFETCH: résultat gardé dans le buffer arrière de l'image
+  // preview: le job commence par l'aperçu (workers seulement, voir has_loader_workers())
+  bool submit_load(SdImageComponent *image, const std::string &path, uint32_t generation,
+                   LoadPriority priority = LOAD_PRIORITY_NORMAL, bool preview = false);
+  // Deuxième passage d'un job (après l'aperçu): échéance d'origine conservée
+  bool resubmit_load(LoadJob &&job) { return this->loader_.submit(std::move(job)); }
+  bool has_loader_workers() const { return this->loader_.get_worker_count() > 0; }
+  void promote_load(SdImageComponent *image) { this->loader_.promote(image, millis()); }
+  
+  // Chargement terminé (loop principale): log, capteurs, chargement le plus lent
+  void record_load(SdImageComponent *image, const std::string &path, const LoadStats &stats);
+  // storage.stats: dernier chargement de chaque image
+  void dump_load_stats();
+  
   // Getters
   const std::string &get_platform() const { return this->platform_; }
   const std::string &get_root_path() const { return this->root_path_; }
@@ -108,6 +165,46 @@ class StorageComponent : public Component {
   // NOUVEAU: Auto-load global et gestion des images
   bool auto_load_{true}; // Par défaut à true pour compatibilité
   std::vector<SdImageComponent*> sd_images_;
+  
+  size_t memory_budget_{0};
+  std::atomic<bool> memory_dirty_{true};  // aussi positionné depuis les workers
+  std::string slowest_load_path_;
+  LoadStats slowest_load_;
+  uint32_t eviction_count_{0};
+  void publish_memory_usage_();
+  
+  size_t psram_arena_size_{0};
+  size_t internal_arena_size_{0};
+  float arena_compact_threshold_{0.5f};
+  uint32_t last_arena_check_{0};
+  
+  std::string asset_pack_path_;
+  AssetPack asset_pack_;
+  bool asset_pack_open_failed_{false};
+  Mutex asset_pack_lock_;
+  
+  static const size_t PROBE_CACHE_MAX = 64;
+  std::map<std::string, ImageInfo> probe_cache_;
+  std::set<std::string> probe_failures_;  // déjà signalés: pas de fopen à chaque mise en page
+  Mutex probe_lock_;
+  bool probe_asset_(const std::string &name, ImageInfo &info);
+  
+  static const uint32_t THUMBNAIL_IDLE_INTERVAL_MS = 20;
+  ThumbnailCache thumbnails_;
+  std::string thumbnail_folder_;
+  bool thumbnail_open_attempted_{false};
+  uint32_t last_thumbnail_{0};
+  void submit_thumbnail_();
+  
+#ifdef USE_LVGL
+  LvglFsDriver lvgl_fs_;
+  bool lvgl_fs_enabled_{false};
+#endif
+  
+  bool background_loading_{true};
+  int loader_core_{-1};
+  uint8_t loader_workers_{ImageLoader::MAX_WORKERS};
+  ImageLoader loader_;
 };
 
 // =====================================================
@@ -138,7 +235,20 @@ class SdImageComponent : public Component, public image::Image {
     this->resize_width_ = width; 
     this->resize_height_ = height; 
   }
-  void set_format(ImageFormat format) { this->format_ = format; }
+  void set_format(ImageFormat format);
+  // Fichiers raw sans en-tête: dimensions fournies par la configuration
+  void set_raw_size(int width, int height) {
+    this->raw_width_ = width;
+    this->raw_height_ = height;
+  }
+  // Formats compacts: tramage de BINARY, palette de INDEXED8 (0xRRGGBB, RGB332 si vide)
+  void set_dither(bool dither) { this->quantizer_.set_dither(dither); }
+  void set_palette(const std::vector<uint32_t> &palette) { this->quantizer_.set_palette(palette); }
+  ImageFormat get_output_format() const { return this->output_format_; }
+  // RGB565 gardé compressé (RLE/QOI par ligne), développé ligne à ligne au draw
+  void set_ram_compression(RamCompression compression) { this->ram_compression_ = compression; }
+  RamCompression get_ram_compression() const { return this->compression_; }
+  void set_placement(MemoryPlacement placement) { this->placement_ = placement; }
   
   // Compatibility methods for YAML configuration
   void set_output_format_string(const std::string &format);
@@ -146,8 +256,10 @@ class SdImageComponent : public Component, public image::Image {
   
   // Override Image methods avec chargement automatique intégré
   void draw(int x, int y, display::Display *display, Color color_on, Color color_off) override;
+  // Ne déclenchent jamais de décodage: dimensions sondées dans l'en-tête si l'image n'est pas chargée
   int get_width() const override;
   int get_height() const override;
+  bool get_image_info(ImageInfo &info) const;
   
   // Loading/unloading methods
   bool load_image();
@@ -155,6 +267,70 @@ class SdImageComponent : public Component, public image::Image {
   void unload_image();
   bool reload_image();
   
+  // Chargement asynchrone (synchrone si la tâche de chargement n'existe pas)
+  bool request_load(const std::string &path, LoadPriority priority = LOAD_PRIORITY_NORMAL);
+  bool is_load_pending() const { return this->load_pending_; }
+  // Tâche de chargement: lecture + décodage dans decode_ uniquement
+  bool decode_in_background(const std::string &path);
+  // Aperçu JPEG dans preview_ (tâche de chargement, ou loop pour la seule vignette EXIF)
+  bool decode_preview(const std::string &path, bool exif_only = false);
+  // Même travail par tranches sur la loop principale: step_sliced_decode() rend
+  // la main à l'échéance (micros()) et renvoie true une fois le décodage terminé
+  bool begin_sliced_decode(const std::string &path);
+  bool step_sliced_decode(uint32_t deadline_us, bool &success);
+  // Loop principale: publication (ou abandon) du résultat
+  void complete_background_load(const LoadJob &job);
+  
+  // Préchargement: image suivante décodée en tâche de fond dans un buffer arrière,
+  // affichée par show_prefetched() (simple échange de buffers sur la loop principale)
+  bool prefetch(const std::string &path);
+  bool is_prefetched(const std::string &path) const { return !this->staged_.buffer.empty() && this->staged_path_ == path; }
+  bool is_prefetch_failed(const std::string &path) const { return this->prefetch_failed_path_ == path; }
+  bool show_prefetched();
+  void discard_prefetched();
+  // Image affichée + image préchargée, pour le budget mémoire
+  size_t get_memory_footprint() const { return this->image_buffer_.size() + this->staged_.buffer.size(); }
+  
+  // Diaporama: dossier et/ou liste de fichiers, intervalle, ordre aléatoire
+  Slideshow *enable_slideshow();
+  Slideshow *get_slideshow() { return this->slideshow_; }
+  StorageComponent *get_storage_component() const { return this->storage_component_; }
+  
+  // Aperçu JPEG: vignette EXIF ou décodage 1/8 agrandi, affiché avant le décodage complet
+  void set_progressive_preview(bool enabled) { this->progressive_preview_ = enabled; }
+  bool is_preview() const { return this->showing_preview_; }
+  
+  // Animation GIF: fichier lu en streaming, une frame par échéance dans loop()
+  void set_animated(bool animated) { this->animated_ = animated; }
+  void set_animation_loop(bool loop) { this->animation_loop_ = loop; }
+  bool is_animated() const { return this->gif_player_ != nullptr; }
+  void play();
+  void pause();
+  bool seek(int frame);
+  bool is_playing() const { return this->playing_ && this->gif_player_ != nullptr; }
+  int get_frame_index() const;
+  // Zone du canvas modifiée par la dernière frame, et son redessin seul
+  bool get_frame_dirty_rect(int &x, int &y, int &w, int &h) const;
+  void draw_frame_update(int x, int y, display::Display *display);
+  
+  // Viewport: seule une fenêtre de l'image source est décodée et gardée en RAM
+  void set_viewport(int x, int y, int width, int height);
+  void clear_viewport();
+  bool pan(int dx, int dy) { return this->pan_to(this->viewport_x_ + dx, this->viewport_y_ + dy); }
+  bool pan_to(int x, int y);
+  bool has_viewport() const { return this->viewport_enabled_; }
+  int get_viewport_x() const { return this->viewport_x_; }
+  int get_viewport_y() const { return this->viewport_y_; }
+  int get_source_width() const { return this->source_width_; }
+  int get_source_height() const { return this->source_height_; }
+  
+  void add_on_loaded_callback(std::function<void()> &&callback) { this->loaded_callback_.add(std::move(callback)); }
+  void add_on_load_failed_callback(std::function<void()> &&callback) {
+    this->load_failed_callback_.add(std::move(callback));
+  }
+  // Aperçu publié: on_loaded ne se déclenche qu'une fois, pour l'image complète
+  void add_on_preview_callback(std::function<void()> &&callback) { this->preview_callback_.add(std::move(callback)); }
+  
   // NOUVEAU: Méthodes pour système hybride (auto_load global + on-demand)
   bool should_auto_load() const { 
     return this->storage_component_ && this->storage_component_->get_auto_load(); 
@@ -166,34 +342,134 @@ class SdImageComponent : public Component, public image::Image {
   
   // Status et accès aux données
   bool is_loaded() const { return this->image_loaded_; }
+  bool is_evicted() const { return this->evicted_; }
+  uint32_t get_last_draw_time() const { return this->last_draw_ms_; }
+  void evict();
   const std::string &get_file_path() const { return this->file_path_; }
   
   // Image buffer access for LVGL
-  const std::vector<uint8_t> &get_image_buffer() const { return this->image_buffer_; }
+  const ImageBuffer &get_image_buffer() const { return this->image_buffer_; }
   uint8_t* get_image_data() { return this->image_buffer_.empty() ? nullptr : this->image_buffer_.data(); }
   size_t get_image_data_size() const { return this->image_buffer_.size(); }
   
   // NOUVEAU: Méthodes pour LVGL avec chargement automatique intégré
   const uint8_t* get_image_data_for_lvgl();
   size_t get_image_data_size_for_lvgl();
+#ifdef USE_LVGL
+  // Descripteur prêt pour lv_img_set_src(): format, taille et données suivent le buffer publié
+  // (chargement, aperçu, compactage d'arène); nullptr si l'image n'est pas chargée
+  lv_img_dsc_t *get_lv_img_dsc();
+#endif
+  
+  // Image affichée réécrite en QOI sur la SD (cache de conversion, capture)
+  bool save_qoi(const std::string &path);
   
   // Debug info
   std::string get_debug_info() const;
+  // Dernier chargement (read_and_decode_) terminé, et compteurs depuis le boot
+  const LoadStats &get_load_stats() const { return this->load_stats_; }
+  const std::string &get_load_stats_path() const { return this->load_stats_path_; }
+  uint32_t get_load_count() const { return this->load_count_; }
+  uint32_t get_load_failures() const { return this->load_failures_; }
+  
+  // Appelé après un compactage d'arène: le buffer a pu changer d'adresse
+  void on_buffer_moved();
 
  protected:
   // Image state
   std::string file_path_;
   StorageComponent *storage_component_{nullptr};
-  std::vector<uint8_t> image_buffer_;
+  ImageBuffer image_buffer_;
+  MemoryPlacement placement_{MemoryPlacement::AUTO};
   bool image_loaded_{false};
   
+  // LRU: dernier draw() et éviction par le budget mémoire
+  uint32_t last_draw_ms_{0};
+  bool evicted_{false};
+  
+  // Destination des décodeurs: privée tant que le chargement n'est pas publié,
+  // l'image affichée (image_buffer_) reste valide pendant un chargement de fond
+  struct DecodeTarget {
+    ImageBuffer buffer;
+    int width{0};
+    int height{0};
+    bool background{false};  // pas de budget/éviction depuis la tâche de chargement
+    ImageFormat format{ImageFormat::RGB565};  // choisi par le décodeur, format_ à la publication
+    RamCompression compression{RamCompression::NONE};
+    const PixelOps *ops{nullptr};  // écrivain choisi à l'allocation (nullptr: format compact)
+  };
+  DecodeTarget decode_;
+  DecodeTarget staged_;  // préchargée, en attente de bascule
+  LoadStats decode_stats_;  // rempli avec decode_, recopié dans load_stats_ au retour du job
+  LoadStats load_stats_;
+  std::string load_stats_path_;
+  uint32_t load_count_{0};
+  uint32_t load_failures_{0};
+  void record_load_stats_(const std::string &path);
+  std::string staged_path_;
+  std::string prefetch_failed_path_;
+  Slideshow *slideshow_{nullptr};
+  std::string pending_load_;  // chemin du dernier chargement (hors préchargement) soumis
+  std::string deferred_load_;  // demandé pendant un job en vol, soumis à son retour
+  LoadPriority deferred_priority_{LOAD_PRIORITY_NORMAL};
+  bool prefetch_pending_{false};
+  bool load_pending_{false};
+  uint32_t load_generation_{0};
+  CallbackManager<void()> loaded_callback_;
+  CallbackManager<void()> load_failed_callback_;
+  CallbackManager<void()> preview_callback_;
+  
+  // Aperçu basse résolution: vignette EXIF sur la loop, 1/8 en premier passage
+  // du job; publié par show_preview_() avant le décodage complet
+  bool progressive_preview_{false};
+  bool showing_preview_{false};
+  ImageBuffer preview_src_;
+  int preview_src_width_{0};
+  int preview_src_height_{0};
+  ImageBuffer preview_;
+  int preview_width_{0};
+  int preview_height_{0};
+  bool preview_target_(const std::string &path, ImageInfo &info, int &width, int &height);
+  bool show_preview_(const std::string &path);
+  void complete_preview_(const LoadJob &job);
+  static int jpeg_preview_callback(JPEGDRAW *pDraw);
+  
+#ifdef USE_LVGL
+  // Adresse stable: LVGL garde le pointeur, le contenu suit chaque publication
+  lv_img_dsc_t lv_img_dsc_{};
+  bool lv_byte_order_warned_{false};
+  void update_lv_img_dsc_();
+#endif
+  
+  // Animation
+  bool animated_{false};
+  bool animation_loop_{true};
+  bool playing_{true};
+  uint32_t next_frame_ms_{0};
+  GifPlayer *gif_player_{nullptr};
+  
   // Image properties - local
   int image_width_{0};
   int image_height_{0};
   int resize_width_{0};
   int resize_height_{0};
-  ImageFormat format_{ImageFormat::RGB565};
+  int raw_width_{0};
+  int raw_height_{0};
+  ImageFormat format_{ImageFormat::RGB565};  // format de l'image publiée
+  ImageFormat output_format_{ImageFormat::RGB565};  // format configuré
+  Quantizer quantizer_;  // écriture/lecture des formats compacts
+  RamCompression ram_compression_{RamCompression::NONE};  // configurée
+  RamCompression compression_{RamCompression::NONE};      // de l'image publiée
   SdByteOrder byte_order_{SdByteOrder::LITTLE_ENDIAN_SD};
+  const PixelOps *pixel_ops_{nullptr};  // lecteur de l'image publiée
+  
+  // Ordre d'octets de l'écran, fixé à la configuration: les décodeurs l'émettent
+  // directement (JPEGDEC setPixelType, palette GIF), un uint16 est stocké tel quel
+  bool is_big_endian_() const { return this->byte_order_ == SdByteOrder::BIG_ENDIAN_SD; }
+  // RGB565 calculé par le CPU (little endian) -> ordre de l'écran
+  uint16_t to_native_565_(uint16_t rgb565) const {
+    return this->is_big_endian_() ? (uint16_t) ((rgb565 >> 8) | (rgb565 << 8)) : rgb565;
+  }
 
  private:
   // État de chargement pour système hybride
@@ -220,22 +496,114 @@ class SdImageComponent : public Component, public image::Image {
     UNKNOWN,
     JPEG,
     PNG,
-    GIF  // NOUVEAU
+    GIF,  // NOUVEAU
+    QOI,
+    BMP,
+    RAW
   };
   
-  FileType detect_file_type(const std::vector<uint8_t> &data) const;
+  // file_size: taille du fichier quand data n'en contient que le début (0 = fichier entier)
+  FileType detect_file_type(const std::vector<uint8_t> &data, size_t file_size = 0) const;
+  
+  // Viewport decoding: one streamed pass per rectangle (full viewport, or the
+  // strips uncovered by a pan), pixels outside the pass rectangle are dropped
+  struct RegionPass {
+    int x0{0};  // source rectangle written by this pass
+    int y0{0};
+    int x1{0};
+    int y1{0};
+    uint8_t *dst{nullptr};   // viewport-sized RGB565 buffer, source (dst_x, dst_y) at offset 0
+    int dst_x{0};
+    int dst_y{0};
+    int stride{0};           // pixels per dst row
+    bool allocate{false};    // first pass: size + allocate decode_ once the header is known
+    bool interlaced{false};  // Adam7 PNG: rows arrive out of order, no early stop
+    bool done{false};        // decoder stopped below y1
+  };
+  RegionPass region_;
+  
+  // Décodage découpé: état gardé entre deux passages de loop(). Seuls les
+  // décodeurs dont on tient la boucle (pngle par blocs, QOI et BMP/raw par
+  // lignes) s'arrêtent en cours d'image; JPEG, GIF, PNGdec, asset packs et
+  // viewport sont décodés d'un bloc au premier pas.
+  struct SlicedDecode {
+    std::string path;
+    FileType type{FileType::UNKNOWN};  // UNKNOWN: read_and_decode_ d'un bloc
+    FILE *file{nullptr};
+    QoiDecoder *qoi{nullptr};
+    RawLayout layout;
+    bool direct{false};          // raw: lignes lues directement dans le buffer
+    int row{0};
+    size_t pending{0};           // pngle: octets non consommés en tête de chunk
+    std::vector<uint8_t> chunk;  // pngle: bloc lu; raw: ligne du fichier
+    std::vector<uint8_t> rgba;
+  };
+  SlicedDecode sliced_;
+  bool start_sliced_decode_();
+  void end_sliced_decode_(bool success);
+  
+  bool viewport_enabled_{false};
+  int viewport_x_{0};
+  int viewport_y_{0};
+  int viewport_w_{0};
+  int viewport_h_{0};
+  int source_width_{0};
+  int source_height_{0};
+  FileType viewport_type_{FileType::UNKNOWN};
+  
+  bool decode_viewport_(const std::string &path);
+  bool decode_region_(const std::string &full_path, FileType type);
+  bool begin_region_target_(int src_width, int src_height);
+  void region_put_(int x, int y, uint16_t native);
   bool is_jpeg_data(const std::vector<uint8_t> &data) const;
   bool is_png_data(const std::vector<uint8_t> &data) const;
   bool is_gif_data(const std::vector<uint8_t> &data) const;  // NOUVEAU
+  bool is_qoi_data(const std::vector<uint8_t> &data) const;
   
   // Image decoding avec GIF
   bool decode_image(const std::vector<uint8_t> &data);
   bool decode_jpeg_image(const std::vector<uint8_t> &jpeg_data);
   bool decode_png_image(const std::vector<uint8_t> &png_data);
+  // PNG lu par blocs depuis le fichier (pngle, ou PNGdec hors Adam7)
+  bool decode_png_file_(const std::string &full_path, bool interlaced);
   bool decode_gif_image(const std::vector<uint8_t> &gif_data);  // NOUVEAU
+  bool decode_qoi_image(const std::vector<uint8_t> &qoi_data);
+  
+  // BMP/raw: pixels lus directement dans decode_ (read(offset, dst, len) sur le fichier ou la mémoire)
+  using RawReadFn = std::function<bool(uint32_t offset, uint8_t *dst, size_t len)>;
+  bool raw_layout_(const uint8_t *head, size_t head_size, uint32_t file_size, RawLayout &layout) const;
+  FILE *open_raw_(const std::string &full_path, RawLayout &layout) const;
+  bool load_raw_(const RawLayout &layout, const RawReadFn &read);
+  // Étapes de load_raw_ (reprises ligne à ligne par le décodage découpé)
+  bool begin_raw_target_(const RawLayout &layout, bool &direct);
+  bool read_raw_row_(const RawLayout &layout, int index, bool direct, const RawReadFn &read, uint8_t *src,
+                     uint8_t *rgba);
+  bool finish_raw_(const RawLayout &layout, bool direct);
+  bool begin_qoi_target_(const QoiDecoder &decoder);
+  // Redimensionnement final de decode_ (width x height) vers resize_, si demandé
+  bool finish_resize_(const char *kind, int width, int height);
+  // Ligne RGBA8888 -> ligne y de decode_ dans son format d'écriture
+  void put_rgba_row_(int y, const uint8_t *rgba, int width);
+  
+  // Asset pack entries ("pack:<name>" paths)
+  bool load_from_asset_pack(const std::string &name);
+  
+  // Lecture + décodage dans decode_, puis bascule vers image_buffer_ (loop principale)
+  bool read_and_decode_(const std::string &path);
+  bool decode_file_(const std::string &path);
+  // Formats compacts et compression RAM, comptés dans la phase de conversion
+  bool convert_decoded_();
+  void publish_decoded_(DecodeTarget &source, const std::string &path);
+  void complete_prefetch_(const LoadJob &job);
+  
+  bool is_gif_path_(const std::string &path) const;
+  bool start_animation_(const std::string &path);
+  void stop_animation_();
+  void advance_animation_();
   
   // Decoder callbacks and helpers
 #ifdef USE_JPEGDEC
+  static int jpeg_region_callback(JPEGDRAW *draw);
   static int jpeg_decode_callback(JPEGDRAW *draw);
   static int jpeg_decode_callback_no_resize(JPEGDRAW *draw);
   JPEGDEC *jpeg_decoder_{nullptr};
@@ -243,16 +611,36 @@ class SdImageComponent : public Component, public image::Image {
 #endif
 
 #ifdef USE_PNGLE
+  static void png_region_init_callback(pngle_t *pngle, uint32_t w, uint32_t h);
+  static void png_region_draw_callback(pngle_t *pngle, uint32_t x, uint32_t y, uint32_t w, uint32_t h, const uint8_t rgba[4]);
   static void png_init_callback(pngle_t *pngle, uint32_t w, uint32_t h);
   static void png_draw_callback(pngle_t *pngle, uint32_t x, uint32_t y, uint32_t w, uint32_t h, const uint8_t rgba[4]);
   static void png_done_callback(pngle_t *pngle);
   static void png_init_callback_no_resize(pngle_t *pngle, uint32_t w, uint32_t h);
   static void png_draw_callback_no_resize(pngle_t *pngle, uint32_t x, uint32_t y, uint32_t w, uint32_t h, const uint8_t rgba[4]);
+  bool begin_png_decoder_();
+  bool decode_png_stream_(const std::string &full_path);
   pngle_t *png_decoder_{nullptr};
+  bool png_done_{false};  // done callback reçu: flux complet
+#endif
+
+#ifdef USE_PNGDEC
+  // Une ligne défiltrée par callback, convertie/redimensionnée d'un bloc
+  bool decode_png_rows_(const std::vector<uint8_t> &png_data);
+  bool decode_png_rows_(const std::string &full_path);
+  bool decode_png_rows_(PNG *png);  // ouvert; fermé et libéré ici
+  bool decode_png_region_rows_(const std::string &full_path);
+  static int png_row_callback(PNGDRAW *draw);
+  static int png_region_row_callback(PNGDRAW *draw);
+  PNG *png_rows_decoder_{nullptr};
+  std::vector<uint8_t> png_rgba_;      // ligne source en RGBA
+  std::vector<uint8_t> png_resized_;   // ligne cible (redimensionnement)
+  std::vector<uint16_t> png_x_map_;    // colonne source de chaque colonne cible
 #endif
 
 #ifdef USE_ANIMATEDGIF
   static void GIFDraw(GIFDRAW *pDraw);  // NOUVEAU: Callback GIF
+  static void gif_region_callback(GIFDRAW *pDraw);
   ANIMATEDGIF *gif_decoder_{nullptr};  // NOUVEAU: Decoder GIF
 #endif
 
@@ -261,6 +649,13 @@ class SdImageComponent : public Component, public image::Image {
   void set_pixel(int x, int y, uint8_t r, uint8_t g, uint8_t b, uint8_t a = 255);
   size_t get_pixel_size() const;
   size_t get_buffer_size() const;
+  // Format d'écriture du décodeur: le format compact configuré si les pixels
+  // arrivent à la taille finale, sinon RGB565 (redimensionné puis quantifié)
+  ImageFormat decode_format_(bool final_size) const;
+  // RGB565 -> format compact configuré, ligne par ligne (après un redimensionnement)
+  bool quantize_decoded_();
+  // Buffer RGB565 -> lignes RLE/QOI si ram_compression est configurée et rentable
+  bool compress_decoded_();
   
   // Resize methods
   bool resize_image_buffer(int src_width, int src_height, int dst_width, int dst_height);
@@ -272,6 +667,17 @@ class SdImageComponent : public Component, public image::Image {
   int get_current_width() const;
   int get_current_height() const;
   image::ImageType get_esphome_image_type() const;
+  // Buffer lisible tel quel par image::Image (data_start_): ni compressé ni indexé
+  bool is_base_readable_() const {
+    return this->compression_ == RamCompression::NONE && this->format_ != ImageFormat::INDEXED8;
+  }
+  
+  // Blit par lignes: clipping une fois, spans contigus vers draw_pixels_at
+  bool blit_(int x, int y, int src_x, int src_y, int w, int h, display::Display *display);
+  void blit_converted_rows_(int x0, int y0, int x1, int y1, int src_x, int src_y, display::Display *display);
+  void blit_compressed_rows_(int x0, int y0, int x1, int y1, int src_x, int src_y, display::Display *display);
+  std::vector<uint8_t> blit_row_;  // une ligne convertie (formats que l'écran ne lit pas tels quels)
+  std::vector<uint16_t> blit_palette_;  // INDEXED8: palette dans l'ordre de l'écran
   
   void draw_pixels_directly(int x, int y, display::Display *display, Color color_on, Color color_off);
   void draw_pixel_at(display::Display *display, int screen_x, int screen_y, int img_x, int img_y);
@@ -279,7 +685,6 @@ class SdImageComponent : public Component, public image::Image {
   
   // Utility methods
   void list_directory_contents(const std::string &dir_path);
-  bool extract_jpeg_dimensions(const std::vector<uint8_t> &data, int &width, int &height) const;
   
   // Format helpers
   std::string format_to_string() const;
@@ -301,12 +706,12 @@ class SdImageLoadAction : public Action<Ts...> {
     if (this->file_path_.has_value()) {
       std::string path = this->file_path_.value(x...);
       if (!path.empty()) {
-        this->parent_->load_image_from_path(path);
+        this->parent_->request_load(path);
         return;
       }
     }
     
-    this->parent_->load_image();
+    this->parent_->request_load(this->parent_->get_file_path());
   }
 
  private:
@@ -328,7 +733,162 @@ class SdImageUnloadAction : public Action<Ts...> {
   SdImageComponent *parent_;
 };
 
+template<typename... Ts> 
+class SdImageSetViewportAction : public Action<Ts...> {
+ public:
+  explicit SdImageSetViewportAction(SdImageComponent *parent) : parent_(parent) {}
+  
+  TEMPLATABLE_VALUE(int, x)
+  TEMPLATABLE_VALUE(int, y)
+  TEMPLATABLE_VALUE(int, width)
+  TEMPLATABLE_VALUE(int, height)
+  
+  void play(Ts... x) override {
+    if (this->parent_ != nullptr) {
+      this->parent_->set_viewport(this->x_.value(x...), this->y_.value(x...), 
+                                  this->width_.value(x...), this->height_.value(x...));
+    }
+  }
+
+ private:
+  SdImageComponent *parent_;
+};
+
+template<typename... Ts> 
+class SdImagePanAction : public Action<Ts...> {
+ public:
+  explicit SdImagePanAction(SdImageComponent *parent) : parent_(parent) {}
+  
+  TEMPLATABLE_VALUE(int, dx)
+  TEMPLATABLE_VALUE(int, dy)
+  
+  void play(Ts... x) override {
+    if (this->parent_ != nullptr) {
+      this->parent_->pan(this->dx_.has_value() ? this->dx_.value(x...) : 0, 
+                         this->dy_.has_value() ? this->dy_.value(x...) : 0);
+    }
+  }
+
+ private:
+  SdImageComponent *parent_;
+};
+
+template<typename... Ts> 
+class SdImagePlayAction : public Action<Ts...> {
+ public:
+  explicit SdImagePlayAction(SdImageComponent *parent) : parent_(parent) {}
+  
+  void play(Ts... x) override {
+    if (this->parent_ != nullptr) {
+      this->parent_->play();
+    }
+  }
+
+ private:
+  SdImageComponent *parent_;
+};
+
+template<typename... Ts> 
+class SdImagePauseAction : public Action<Ts...> {
+ public:
+  explicit SdImagePauseAction(SdImageComponent *parent) : parent_(parent) {}
+  
+  void play(Ts... x) override {
+    if (this->parent_ != nullptr) {
+      this->parent_->pause();
+    }
+  }
+
+ private:
+  SdImageComponent *parent_;
+};
+
+template<typename... Ts> 
+class SdImageSeekAction : public Action<Ts...> {
+ public:
+  explicit SdImageSeekAction(SdImageComponent *parent) : parent_(parent) {}
+  
+  TEMPLATABLE_VALUE(int, frame)
+  
+  void play(Ts... x) override {
+    if (this->parent_ != nullptr) {
+      this->parent_->seek(this->frame_.value(x...));
+    }
+  }
+
+ private:
+  SdImageComponent *parent_;
+};
+
+template<typename... Ts> 
+class SdImageNextAction : public Action<Ts...> {
+ public:
+  explicit SdImageNextAction(SdImageComponent *parent) : parent_(parent) {}
+  
+  void play(Ts... x) override {
+    if (this->parent_ != nullptr && this->parent_->get_slideshow() != nullptr) {
+      this->parent_->get_slideshow()->next();
+    }
+  }
+
+ private:
+  SdImageComponent *parent_;
+};
+
+template<typename... Ts> 
+class SdImagePreviousAction : public Action<Ts...> {
+ public:
+  explicit SdImagePreviousAction(SdImageComponent *parent) : parent_(parent) {}
+  
+  void play(Ts... x) override {
+    if (this->parent_ != nullptr && this->parent_->get_slideshow() != nullptr) {
+      this->parent_->get_slideshow()->previous();
+    }
+  }
+
+ private:
+  SdImageComponent *parent_;
+};
+
+class SdImageLoadedTrigger : public Trigger<> {
+ public:
+  explicit SdImageLoadedTrigger(SdImageComponent *parent) {
+    parent->add_on_loaded_callback([this]() { this->trigger(); });
+  }
+};
+
+class SdImageLoadFailedTrigger : public Trigger<> {
+ public:
+  explicit SdImageLoadFailedTrigger(SdImageComponent *parent) {
+    parent->add_on_load_failed_callback([this]() { this->trigger(); });
+  }
+};
+
+class SdImagePreviewTrigger : public Trigger<> {
+ public:
+  explicit SdImagePreviewTrigger(SdImageComponent *parent) {
+    parent->add_on_preview_callback([this]() { this->trigger(); });
+  }
+};
+
 // NOUVEAU: Actions pour contrôle global
+template<typename... Ts> 
+class StorageOpenThumbnailsAction : public Action<Ts...> {
+ public:
+  explicit StorageOpenThumbnailsAction(StorageComponent *parent) : parent_(parent) {}
+  
+  TEMPLATABLE_VALUE(std::string, folder)
+  
+  void play(Ts... x) override {
+    if (this->parent_ != nullptr) {
+      this->parent_->open_thumbnail_folder(this->folder_.value(x...));
+    }
+  }
+
+ private:
+  StorageComponent *parent_;
+};
+
 template<typename... Ts> 
 class StorageLoadAllAction : public Action<Ts...> {
  public:
@@ -344,6 +904,21 @@ class StorageLoadAllAction : public Action<Ts...> {
   StorageComponent *parent_;
 };
 
+template<typename... Ts> 
+class StorageStatsAction : public Action<Ts...> {
+ public:
+  explicit StorageStatsAction(StorageComponent *parent) : parent_(parent) {}
+  
+  void play(Ts... x) override {
+    if (this->parent_ != nullptr) {
+      this->parent_->dump_load_stats();
+    }
+  }
+
+ private:
+  StorageComponent *parent_;
+};
+
 template<typename... Ts> 
 class StorageUnloadAllAction : public Action<Ts...> {
  public:
@@ -0,0 +1,64 @@
+#pragma once
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include "esphome/core/hal.h"
+#include "esphome/core/log.h"
+#include "load_stats.h"
+
+namespace esphome {
+namespace storage {
+
+// =====================================================
+// FILE* callbacks for the streaming decoders
+// =====================================================
+//
+// JPEGDEC (JPEGFILE) and AnimatedGIF (GIFFILE) both pull their input through
+// open/close/read/seek callbacks on a {iPos, iSize, pData, fHandle} struct,
+// so the encoded file never has to sit in RAM.
+
+inline void *stream_open(const char *path, int32_t *size) {
+  FILE *file = fopen(path, "rb");
+  if (!file) {
+    ESP_LOGE("storage.stream", "Failed to open %s (errno: %d)", path, errno);
+    return nullptr;
+  }
+  fseek(file, 0, SEEK_END);
+  *size = ftell(file);
+  fseek(file, 0, SEEK_SET);
+  return file;
+}
+
+inline void stream_close(void *handle) {
+  if (handle) {
+    fclose(static_cast<FILE *>(handle));
+  }
+}
+
+template<typename T> int32_t stream_read(T *file, uint8_t *buf, int32_t len) {
+  FILE *f = static_cast<FILE *>(file->fHandle);
+  len = std::min(len, file->iSize - file->iPos);
+  if (len <= 0) {
+    return 0;
+  }
+  // Le décodeur a pu faire un seek logique sans lecture
+  uint32_t start = micros();
+  if (ftell(f) != file->iPos) {
+    fseek(f, file->iPos, SEEK_SET);
+  }
+  int32_t read = fread(buf, 1, len, f);
+  file->iPos += read;
+  note_load_read(read, micros() - start);
+  return read;
+}
+
+template<typename T> int32_t stream_seek(T *file, int32_t position) {
+  position = std::max<int32_t>(0, std::min(position, file->iSize));
+  fseek(static_cast<FILE *>(file->fHandle), position, SEEK_SET);
+  file->iPos = position;
+  return position;
+}
+
+}  // namespace storage
+}  // namespace esphome
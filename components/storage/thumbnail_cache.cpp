@@ -0,0 +1,659 @@
+#include "thumbnail_cache.h"
+#include "asset_pack.h"
+#include "image_loader.h"
+#include "image_probe.h"
+#include "pixel_kernels.h"
+#include "pixel_pipeline.h"
+#include "qoi_codec.h"
+#include "raw_image.h"
+#include "stream_io.h"
+#include "esphome/core/log.h"
+#include <sys/stat.h>
+#include <dirent.h>
+#include <algorithm>
+#include <cstring>
+
+namespace esphome {
+namespace storage {
+
+static const char *const TAG = "storage.thumbs";
+
+static const uint32_t THUMB_DATA_ALIGN = 512;
+
+// =====================================================
+// Dossier + fichier cache
+// =====================================================
+
+bool ThumbnailCache::open_folder(const std::string &full_folder) {
+  this->close();
+
+  DIR *dir = opendir(full_folder.c_str());
+  if (!dir) {
+    ESP_LOGE(TAG, "Cannot open folder %s", full_folder.c_str());
+    return false;
+  }
+  struct dirent *ent;
+  while ((ent = readdir(dir)) != nullptr && this->names_.size() < UINT16_MAX) {
+    if (is_image_file_name(ent->d_name)) {
+      this->names_.emplace_back(ent->d_name);
+    }
+  }
+  closedir(dir);
+  std::sort(this->names_.begin(), this->names_.end());
+
+  this->folder_ = full_folder;
+  this->cache_path_ = full_folder + "/.thumbs_" + std::to_string(this->thumb_width_) + "x" +
+                      std::to_string(this->thumb_height_) + ".bin";
+
+  this->entries_.resize(this->names_.size());
+  this->previous_slot_.assign(this->names_.size(), -1);
+  for (size_t i = 0; i < this->names_.size(); i++) {
+    ThumbCacheEntry &entry = this->entries_[i];
+    memset(&entry, 0, sizeof(entry));
+    entry.name_hash = asset_name_hash(this->names_[i]);
+    struct stat st;
+    if (stat((full_folder + "/" + this->names_[i]).c_str(), &st) == 0) {
+      entry.file_size = st.st_size;
+      entry.mtime = st.st_mtime;
+    }
+  }
+  this->data_offset_ = (sizeof(ThumbCacheHeader) + this->entries_.size() * sizeof(ThumbCacheEntry) +
+                        THUMB_DATA_ALIGN - 1) & ~(THUMB_DATA_ALIGN - 1);
+
+  // Fichier existant: réutilisé tel quel si la liste n'a pas bougé
+  bool reuse = false;
+  FILE *old = fopen(this->cache_path_.c_str(), "r+b");
+  if (old) {
+    ThumbCacheHeader header;
+    std::vector<ThumbCacheEntry> old_entries;
+    if (fread(&header, sizeof(header), 1, old) == 1 && header.magic == THUMB_CACHE_MAGIC &&
+        header.version == THUMB_CACHE_VERSION && header.thumb_width == this->thumb_width_ &&
+        header.thumb_height == this->thumb_height_ && (header.big_endian != 0) == this->big_endian_) {
+      old_entries.resize(header.count);
+      if (header.count > 0 && fread(old_entries.data(), sizeof(ThumbCacheEntry), header.count, old) != header.count) {
+        old_entries.clear();
+      }
+    }
+
+    bool same_list = !old_entries.empty() && old_entries.size() == this->entries_.size();
+    for (size_t i = 0; same_list && i < old_entries.size(); i++) {
+      same_list = old_entries[i].name_hash == this->entries_[i].name_hash;
+    }
+
+    for (size_t i = 0; i < this->entries_.size(); i++) {
+      ThumbCacheEntry &entry = this->entries_[i];
+      auto it = std::find_if(old_entries.begin(), old_entries.end(), [&entry](const ThumbCacheEntry &o) {
+        return o.name_hash == entry.name_hash && o.file_size == entry.file_size && o.mtime == entry.mtime &&
+               o.width > 0;
+      });
+      if (it == old_entries.end()) {
+        continue;
+      }
+      if (same_list) {
+        entry.width = it->width;
+        entry.height = it->height;
+      } else {
+        this->previous_slot_[i] = it - old_entries.begin();
+      }
+    }
+
+    if (same_list) {
+      this->file_ = old;
+      reuse = true;
+    } else {
+      fclose(old);
+      bool has_previous = std::any_of(this->previous_slot_.begin(), this->previous_slot_.end(),
+                                      [](int slot) { return slot >= 0; });
+      std::string previous_path = this->cache_path_ + ".old";
+      remove(previous_path.c_str());
+      if (has_previous && rename(this->cache_path_.c_str(), previous_path.c_str()) == 0) {
+        this->previous_ = fopen(previous_path.c_str(), "rb");
+        this->previous_data_offset_ = (sizeof(ThumbCacheHeader) + old_entries.size() * sizeof(ThumbCacheEntry) +
+                                       THUMB_DATA_ALIGN - 1) & ~(THUMB_DATA_ALIGN - 1);
+      }
+      if (!this->previous_) {
+        this->previous_slot_.assign(this->entries_.size(), -1);
+      }
+    }
+  }
+
+  if (!reuse) {
+    // Nouveau fichier: en-tête + index vides, cellules réservées d'un coup
+    this->file_ = fopen(this->cache_path_.c_str(), "w+b");
+    if (!this->file_) {
+      ESP_LOGE(TAG, "Cannot create %s", this->cache_path_.c_str());
+      this->close();
+      return false;
+    }
+    ThumbCacheHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = THUMB_CACHE_MAGIC;
+    header.version = THUMB_CACHE_VERSION;
+    header.count = this->entries_.size();
+    header.thumb_width = this->thumb_width_;
+    header.thumb_height = this->thumb_height_;
+    header.big_endian = this->big_endian_ ? 1 : 0;
+    bool ok = fwrite(&header, sizeof(header), 1, this->file_) == 1 &&
+              fwrite(this->entries_.data(), sizeof(ThumbCacheEntry), this->entries_.size(), this->file_) ==
+                  this->entries_.size();
+    if (ok && !this->entries_.empty()) {
+      uint8_t zero = 0;
+      ok = fseek(this->file_, this->cell_offset_(this->entries_.size()) - 1, SEEK_SET) == 0 &&
+           fwrite(&zero, 1, 1, this->file_) == 1;
+    }
+    if (!ok || fflush(this->file_) != 0) {
+      ESP_LOGE(TAG, "Failed to write %s", this->cache_path_.c_str());
+      this->close();
+      return false;
+    }
+  }
+
+  this->pending_ = std::count_if(this->entries_.begin(), this->entries_.end(),
+                                 [](const ThumbCacheEntry &entry) { return entry.width == 0; });
+  this->next_ = 0;
+  if (this->pending_ == 0) {
+    this->finish_previous_();
+  }
+  ESP_LOGI(TAG, "%s: %zu images, %zu thumbnails to generate (%dx%d)", full_folder.c_str(), this->entries_.size(),
+           this->pending_, this->thumb_width_, this->thumb_height_);
+  return true;
+}
+
+void ThumbnailCache::close() {
+  if (this->file_) {
+    fclose(this->file_);
+    this->file_ = nullptr;
+  }
+  if (this->previous_) {
+    fclose(this->previous_);
+    this->previous_ = nullptr;
+  }
+  this->names_.clear();
+  this->entries_.clear();
+  this->previous_slot_.clear();
+  this->pending_ = 0;
+  this->next_ = 0;
+  this->page_.release();
+  this->page_first_ = 0;
+  this->page_count_ = 0;
+  this->generation_++;
+  // Une vignette en cours de décodage écrit encore dans cell_: finish() l'abandonnera
+  if (!this->rendering_) {
+    this->cell_.release();
+  }
+}
+
+void ThumbnailCache::finish_previous_() {
+  if (this->previous_) {
+    fclose(this->previous_);
+    this->previous_ = nullptr;
+    remove((this->cache_path_ + ".old").c_str());
+  }
+}
+
+bool ThumbnailCache::write_entry_(size_t index) {
+  uint32_t offset = sizeof(ThumbCacheHeader) + index * sizeof(ThumbCacheEntry);
+  return fseek(this->file_, offset, SEEK_SET) == 0 &&
+         fwrite(&this->entries_[index], sizeof(ThumbCacheEntry), 1, this->file_) == 1;
+}
+
+bool ThumbnailCache::write_cell_(size_t index, const uint8_t *cell) {
+  return fseek(this->file_, this->cell_offset_(index), SEEK_SET) == 0 &&
+         fwrite(cell, 1, this->cell_bytes_(), this->file_) == this->cell_bytes_();
+}
+
+bool ThumbnailCache::copy_from_previous_(size_t index) {
+  int slot = this->previous_slot_[index];
+  ThumbCacheEntry old;
+  uint32_t offset = this->previous_data_offset_ + slot * this->cell_bytes_();
+  if (fseek(this->previous_, sizeof(ThumbCacheHeader) + slot * sizeof(ThumbCacheEntry), SEEK_SET) != 0 ||
+      fread(&old, sizeof(old), 1, this->previous_) != 1 || fseek(this->previous_, offset, SEEK_SET) != 0 ||
+      fread(this->cell_.data(), 1, this->cell_bytes_(), this->previous_) != this->cell_bytes_()) {
+    return false;
+  }
+  this->entries_[index].width = old.width;
+  this->entries_[index].height = old.height;
+  return true;
+}
+
+// =====================================================
+// Génération incrémentale
+// =====================================================
+
+bool ThumbnailCache::generate_next() {
+  if (!this->file_ || this->pending_ == 0 || this->rendering_) {
+    return false;
+  }
+  size_t index;
+  std::string path;
+  if (this->begin_next(index, path)) {
+    this->finish(index, this->generation_, this->render(path));
+  }
+  return true;
+}
+
+bool ThumbnailCache::begin_next(size_t &index, std::string &path) {
+  if (!this->file_ || this->pending_ == 0 || this->rendering_) {
+    return false;
+  }
+  while (this->next_ < this->entries_.size() && this->entries_[this->next_].width > 0) {
+    this->next_++;
+  }
+  if (this->next_ >= this->entries_.size()) {
+    this->pending_ = 0;
+    return false;
+  }
+  if (this->cell_.empty() && !this->cell_.allocate(this->cell_bytes_(), MemoryPlacement::AUTO)) {
+    ESP_LOGE(TAG, "No memory for a %dx%d thumbnail", this->thumb_width_, this->thumb_height_);
+    return false;
+  }
+
+  index = this->next_++;
+  this->pending_--;
+  bool copied = this->previous_ && this->previous_slot_[index] >= 0 && this->copy_from_previous_(index);
+  if (this->pending_ == 0) {
+    this->finish_previous_();
+  }
+  if (copied) {
+    this->store_(index);
+    return false;
+  }
+
+  memset(this->cell_.data(), 0, this->cell_bytes_());
+  path = this->folder_ + "/" + this->names_[index];
+  this->rendering_ = true;
+  return true;
+}
+
+bool ThumbnailCache::render(const std::string &path) {
+  // Les workers peuvent compacter l'arène: cell_ ne doit pas bouger pendant le décodage
+  ImageArena::pin();
+  bool ok = this->render_(path, this->cell_.data());
+  ImageArena::unpin();
+  return ok;
+}
+
+void ThumbnailCache::finish(size_t index, uint32_t generation, bool ok) {
+  this->rendering_ = false;
+  if (generation != this->generation_) {
+    // Dossier fermé ou rouvert pendant le décodage
+    if (!this->file_) {
+      this->cell_.release();
+    }
+    return;
+  }
+  if (!ok) {
+    ESP_LOGW(TAG, "No thumbnail for %s", this->names_[index].c_str());
+    return;
+  }
+  this->entries_[index].width = this->target_.width;
+  this->entries_[index].height = this->target_.height;
+  this->store_(index);
+}
+
+void ThumbnailCache::store_(size_t index) {
+  ThumbCacheEntry &entry = this->entries_[index];
+  if (!this->write_cell_(index, this->cell_.data()) || !this->write_entry_(index) || fflush(this->file_) != 0) {
+    ESP_LOGE(TAG, "Failed to write thumbnail %zu to %s", index, this->cache_path_.c_str());
+    entry.width = 0;
+    entry.height = 0;
+    return;
+  }
+
+  // Vignette visible dans la page chargée: mise à jour sans relire le fichier
+  if (index >= this->page_first_ && index < this->page_first_ + this->page_count_) {
+    memcpy(this->page_.data() + (index - this->page_first_) * this->cell_bytes_(), this->cell_.data(),
+           this->cell_bytes_());
+  }
+  ESP_LOGV(TAG, "Thumbnail %zu/%zu: %s (%ux%u)", index + 1, this->entries_.size(), this->names_[index].c_str(),
+           entry.width, entry.height);
+  this->ready_callback_.call(index);
+}
+
+bool ThumbnailCache::begin_cell_(int src_width, int src_height, int full_width, int full_height) {
+  if (src_width <= 0 || src_height <= 0 || full_width <= 0 || full_height <= 0) {
+    return false;
+  }
+  // Rapport d'aspect de l'image d'origine, jamais agrandie
+  CellTarget &t = this->target_;
+  if ((int64_t) full_width * this->thumb_height_ >= (int64_t) full_height * this->thumb_width_) {
+    t.width = std::min(this->thumb_width_, full_width);
+    t.height = std::max(1, (int) ((int64_t) full_height * t.width / full_width));
+  } else {
+    t.height = std::min(this->thumb_height_, full_height);
+    t.width = std::max(1, (int) ((int64_t) full_width * t.height / full_height));
+  }
+  t.src_width = src_width;
+  t.src_height = src_height;
+  t.off_x = (this->thumb_width_ - t.width) / 2;
+  t.off_y = (this->thumb_height_ - t.height) / 2;
+  return true;
+}
+
+// Plus proche voisin centré: la cellule d prend le pixel source (2d + 1) * src / (2 * dst).
+// Première cellule dont l'échantillon est >= s
+static inline int first_cell(int s, int src, int dst) { return ((2 * s * dst + src - 1) / src) / 2; }
+static inline int sample_of(int d, int src, int dst) { return (2 * d + 1) * src / (2 * dst); }
+
+void ThumbnailCache::put_(int x, int y, uint16_t native) {
+  const CellTarget &t = this->target_;
+  int dx0 = first_cell(x, t.src_width, t.width);
+  if (dx0 >= t.width || sample_of(dx0, t.src_width, t.width) != x) {
+    return;  // pixel source entre deux échantillons
+  }
+  for (int dy = first_cell(y, t.src_height, t.height); dy < t.height && sample_of(dy, t.src_height, t.height) == y;
+       dy++) {
+    uint8_t *row = t.dst + ((t.off_y + dy) * this->thumb_width_ + t.off_x) * 2;
+    for (int dx = dx0; dx < t.width && sample_of(dx, t.src_width, t.width) == x; dx++) {
+      memcpy(row + dx * 2, &native, 2);
+    }
+  }
+}
+
+bool ThumbnailCache::render_(const std::string &path, uint8_t *cell) {
+  ImageInfo info;
+  FILE *probe = fopen(path.c_str(), "rb");
+  bool probed = probe && probe_image_file(probe, info);
+  if (probe) {
+    fclose(probe);
+  }
+  if (!probed) {
+    return false;
+  }
+  this->target_ = CellTarget();
+  this->target_.dst = cell;
+  this->target_ok_ = false;
+
+  switch (info.type) {
+#ifdef USE_JPEGDEC
+    case ImageFileType::JPEG: {
+      if (!this->begin_cell_(info.width, info.height, info.width, info.height)) {
+        return false;
+      }
+      // Plus forte réduction du décodeur qui reste au-dessus de la vignette;
+      // JPEGDEC ne décode que les coefficients DC d'un JPEG progressif (1/8)
+      int scale = 1;
+      if (info.progressive) {
+        scale = 8;
+      } else {
+        for (int s : {8, 4, 2}) {
+          if (info.width / s >= this->target_.width && info.height / s >= this->target_.height) {
+            scale = s;
+            break;
+          }
+        }
+      }
+      int options = scale == 8 ? JPEG_SCALE_EIGHTH : scale == 4 ? JPEG_SCALE_QUARTER : scale == 2 ? JPEG_SCALE_HALF : 0;
+      this->begin_cell_((info.width + scale - 1) / scale, (info.height + scale - 1) / scale, info.width, info.height);
+
+      JPEGDEC *jpeg = new JPEGDEC();
+      if (!jpeg->open(path.c_str(), stream_open, stream_close, stream_read<JPEGFILE>, stream_seek<JPEGFILE>,
+                      ThumbnailCache::jpeg_cb_)) {
+        delete jpeg;
+        return false;
+      }
+      jpeg->setUserPointer(this);
+      jpeg->setPixelType(this->big_endian_ ? RGB565_BIG_ENDIAN : RGB565_LITTLE_ENDIAN);
+      bool success = jpeg->decode(0, 0, options) == 1;
+      jpeg->close();
+      delete jpeg;
+      return success;
+    }
+#endif
+#ifdef USE_PNGLE
+    case ImageFileType::PNG: {
+      FILE *file = fopen(path.c_str(), "rb");
+      if (!file) {
+        return false;
+      }
+      pngle_t *pngle = pngle_new();
+      if (!pngle) {
+        fclose(file);
+        return false;
+      }
+      pngle_set_init_callback(pngle, ThumbnailCache::png_init_cb_);
+      pngle_set_draw_callback(pngle, ThumbnailCache::png_draw_cb_);
+      pngle_set_user_data(pngle, this);
+
+      uint8_t chunk[1024];
+      size_t pending = 0;
+      bool success = true;
+      while (true) {
+        size_t n = fread(chunk + pending, 1, sizeof(chunk) - pending, file);
+        if (n == 0) {
+          break;
+        }
+        pending += n;
+        int fed = pngle_feed(pngle, chunk, pending);
+        if (fed < 0) {
+          ESP_LOGW(TAG, "PNG decode error in %s: %s", path.c_str(), pngle_error(pngle));
+          success = false;
+          break;
+        }
+        pending -= fed;
+        memmove(chunk, chunk + fed, pending);
+        decode_yield();
+      }
+      pngle_destroy(pngle);
+      fclose(file);
+      return success && this->target_ok_;
+    }
+#endif
+#ifdef USE_ANIMATEDGIF
+    case ImageFileType::GIF: {
+      ANIMATEDGIF *gif = new ANIMATEDGIF();
+      gif->begin(this->big_endian_ ? GIF_PALETTE_RGB565_BE : GIF_PALETTE_RGB565_LE);
+      if (!gif->open(path.c_str(), stream_open, stream_close, stream_read<GIFFILE>, stream_seek<GIFFILE>,
+                     ThumbnailCache::gif_cb_)) {
+        delete gif;
+        return false;
+      }
+      // Première frame seulement
+      bool success = this->begin_cell_(gif->getCanvasWidth(), gif->getCanvasHeight(), gif->getCanvasWidth(),
+                                       gif->getCanvasHeight()) &&
+                     gif->playFrame(false, nullptr, this) >= 0;
+      gif->close();
+      delete gif;
+      return success;
+    }
+#endif
+    case ImageFileType::QOI: {
+      FILE *file = fopen(path.c_str(), "rb");
+      if (!file) {
+        return false;
+      }
+      QoiDecoder *qoi = new QoiDecoder();
+      bool success = qoi->begin(file);
+      int w = success ? qoi->get_header().width : 0;
+      int h = success ? qoi->get_header().height : 0;
+      success = success && this->begin_cell_(w, h, w, h);
+      if (success) {
+        // Une ligne RGBA à la fois, décodage arrêté après la dernière ligne échantillonnée
+        std::vector<uint8_t> rgba(w * 4);
+        std::vector<uint8_t> row(w * 2);
+        int last = sample_of(this->target_.height - 1, h, this->target_.height);
+        for (int y = 0; y <= last && success; y++) {
+          success = qoi->decode_row(rgba.data());
+          if (success && first_cell(y, h, this->target_.height) < this->target_.height &&
+              sample_of(first_cell(y, h, this->target_.height), h, this->target_.height) == y) {
+            kernels::rgba_to_rgb565(rgba.data(), row.data(), w, this->big_endian_);
+            for (int x = 0; x < w; x++) {
+              uint16_t native;
+              memcpy(&native, row.data() + x * 2, 2);
+              this->put_(x, y, native);
+            }
+          }
+          if ((y & 15) == 15) {
+            decode_yield();
+          }
+        }
+      }
+      delete qoi;
+      fclose(file);
+      return success;
+    }
+    case ImageFileType::BMP:
+    case ImageFileType::RAW: {
+      FILE *file = fopen(path.c_str(), "rb");
+      if (!file) {
+        return false;
+      }
+      uint8_t head[RAW_HEADER_SIZE];
+      size_t got = fread(head, 1, sizeof(head), file);
+      RawLayout layout;
+      bool success = (info.type == ImageFileType::BMP ? bmp_read_layout(head, got, info.file_size, layout)
+                                                       : lvgl_bin_read_layout(head, got, info.file_size, layout)) &&
+                     this->begin_cell_(layout.width, layout.height, layout.width, layout.height);
+      if (success) {
+        // Accès direct: seules les lignes échantillonnées sont lues
+        int w = layout.width;
+        std::vector<uint8_t> src(w * raw_pixel_size(layout.pixels));
+        std::vector<uint8_t> rgba(w * 4);
+        std::vector<uint8_t> row(w * 2);
+        for (int dy = 0; dy < this->target_.height && success; dy++) {
+          int y = sample_of(dy, layout.height, this->target_.height);
+          if (dy > 0 && y == sample_of(dy - 1, layout.height, this->target_.height)) {
+            continue;  // put_() a déjà rempli les cellules de cette ligne
+          }
+          success = fseek(file, layout.row_offset(y), SEEK_SET) == 0 &&
+                    fread(src.data(), 1, src.size(), file) == src.size();
+          if (success) {
+            raw_row_to_rgba(layout.pixels, src.data(), rgba.data(), w);
+            kernels::rgba_to_rgb565(rgba.data(), row.data(), w, this->big_endian_);
+            for (int x = 0; x < w; x++) {
+              uint16_t native;
+              memcpy(&native, row.data() + x * 2, 2);
+              this->put_(x, y, native);
+            }
+          }
+        }
+      }
+      fclose(file);
+      return success;
+    }
+    default:
+      ESP_LOGW(TAG, "No decoder for %s", path.c_str());
+      return false;
+  }
+}
+
+// =====================================================
+// Decoder callbacks
+// =====================================================
+
+#ifdef USE_JPEGDEC
+int ThumbnailCache::jpeg_cb_(JPEGDRAW *draw) {
+  if (!draw || !draw->pUser || !draw->pPixels) {
+    return 0;
+  }
+  ThumbnailCache *cache = static_cast<ThumbnailCache *>(draw->pUser);
+  const uint16_t *pixels = (const uint16_t *) draw->pPixels;
+  int y_end = std::min(draw->y + draw->iHeight, cache->target_.src_height);
+  int x_end = std::min(draw->x + draw->iWidth, cache->target_.src_width);
+  for (int y = draw->y; y < y_end; y++) {
+    for (int x = draw->x; x < x_end; x++) {
+      cache->put_(x, y, pixels[(y - draw->y) * draw->iWidth + (x - draw->x)]);
+    }
+  }
+  decode_yield();
+  return 1;
+}
+#endif
+
+#ifdef USE_PNGLE
+void ThumbnailCache::png_init_cb_(pngle_t *pngle, uint32_t w, uint32_t h) {
+  ThumbnailCache *cache = static_cast<ThumbnailCache *>(pngle_get_user_data(pngle));
+  if (cache) {
+    cache->target_ok_ = cache->begin_cell_(w, h, w, h);
+  }
+}
+
+void ThumbnailCache::png_draw_cb_(pngle_t *pngle, uint32_t x, uint32_t y, uint32_t w, uint32_t h,
+                                  const uint8_t rgba[4]) {
+  ThumbnailCache *cache = static_cast<ThumbnailCache *>(pngle_get_user_data(pngle));
+  if (!cache || !cache->target_ok_) {
+    return;
+  }
+  // Adam7 livre chaque pixel une seule fois (w x h n'est qu'un remplissage d'aperçu);
+  // la transparence est composée sur le fond noir de la cellule
+  uint8_t r = rgba[0] * rgba[3] / 255;
+  uint8_t g = rgba[1] * rgba[3] / 255;
+  uint8_t b = rgba[2] * rgba[3] / 255;
+  uint16_t native;
+  if (cache->big_endian_) {
+    PixelTraits<ImageFormat::RGB565, true>::pack(reinterpret_cast<uint8_t *>(&native), r, g, b, 255);
+  } else {
+    PixelTraits<ImageFormat::RGB565, false>::pack(reinterpret_cast<uint8_t *>(&native), r, g, b, 255);
+  }
+  cache->put_(x, y, native);
+}
+#endif
+
+#ifdef USE_ANIMATEDGIF
+void ThumbnailCache::gif_cb_(GIFDRAW *draw) {
+  if (!draw || !draw->pUser || !draw->pPixels || !draw->pPalette) {
+    return;
+  }
+  ThumbnailCache *cache = static_cast<ThumbnailCache *>(draw->pUser);
+  int y = draw->iY + draw->y;
+  if (y >= cache->target_.src_height) {
+    return;
+  }
+  int x_end = std::min(draw->iX + draw->iWidth, cache->target_.src_width);
+  for (int x = draw->iX; x < x_end; x++) {
+    uint8_t index = draw->pPixels[x - draw->iX];
+    if (draw->ucHasTransparency && index == draw->ucTransparent) {
+      continue;
+    }
+    cache->put_(x, y, draw->pPalette[index]);
+  }
+}
+#endif
+
+// =====================================================
+// Lecture par page + affichage
+// =====================================================
+
+bool ThumbnailCache::load_page(size_t first, size_t count) {
+  if (!this->file_ || first >= this->entries_.size()) {
+    return false;
+  }
+  count = std::min(count, this->entries_.size() - first);
+  size_t bytes = count * this->cell_bytes_();
+  if (this->page_.size() != bytes && !this->page_.allocate(bytes, MemoryPlacement::AUTO)) {
+    ESP_LOGE(TAG, "No memory for a page of %zu thumbnails", count);
+    this->page_count_ = 0;
+    return false;
+  }
+
+  // Cellules contiguës: une seule lecture pour toute la page
+  if (fseek(this->file_, this->cell_offset_(first), SEEK_SET) != 0 ||
+      fread(this->page_.data(), 1, bytes, this->file_) != bytes) {
+    ESP_LOGE(TAG, "Failed to read thumbnails %zu..%zu", first, first + count - 1);
+    this->page_count_ = 0;
+    return false;
+  }
+  this->page_first_ = first;
+  this->page_count_ = count;
+  return true;
+}
+
+const uint8_t *ThumbnailCache::get_thumbnail(size_t index) const {
+  if (!this->is_ready(index) || index < this->page_first_ || index >= this->page_first_ + this->page_count_) {
+    return nullptr;
+  }
+  return this->page_.data() + (index - this->page_first_) * this->cell_bytes_();
+}
+
+bool ThumbnailCache::draw(size_t index, int x, int y, display::Display *display) {
+  const uint8_t *cell = this->get_thumbnail(index);
+  if (!cell || !display) {
+    return false;
+  }
+  display->draw_pixels_at(x, y, this->thumb_width_, this->thumb_height_, cell, display::COLOR_ORDER_RGB,
+                          display::COLOR_BITNESS_565, this->big_endian_);
+  return true;
+}
+
+}  // namespace storage
+}  // namespace esphome
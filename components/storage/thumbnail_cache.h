@@ -0,0 +1,175 @@
+#pragma once
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+#include "esphome/core/helpers.h"
+#include "esphome/components/display/display.h"
+#include "image_arena.h"
+#include "image_decoders.h"
+
+namespace esphome {
+namespace storage {
+
+// =====================================================
+// Thumbnail cache - vignettes d'un dossier dans un seul fichier
+// =====================================================
+//
+// One file per folder and thumbnail size, <folder>/.thumbs_<W>x<H>.bin
+// (all integers little endian):
+//
+//   [ThumbCacheHeader]                  32 bytes
+//   [ThumbCacheEntry x count]           same order as the sorted folder listing
+//   [padding up to 512]
+//   [cell 0][cell 1]...                 W*H RGB565 each, fixed size
+//
+// Cells have a fixed size, so thumbnails [first, first + n) are one fseek +
+// one fread. A thumbnail keeps the source aspect ratio and is centred on a
+// black cell; entry.width/height is the content size, 0 while not generated.
+//
+// Generation is incremental, one thumbnail at a time in three steps:
+// begin_next() picks the next missing one (main loop), render() decodes it
+// into the work cell (JPEG via the decoder's 1/2..1/8 scaled output, PNG/GIF
+// sampled while streaming; on a loader worker when there is one) and finish()
+// writes its cell and entry in place (main loop). generate_next() runs the
+// three in a row. When the folder changed since the file was written, the
+// previous file is kept aside and still-valid cells are copied over by
+// begin_next() instead of being decoded again.
+
+static const uint32_t THUMB_CACHE_MAGIC = 0x48544453;  // "SDTH"
+static const uint16_t THUMB_CACHE_VERSION = 1;
+
+struct __attribute__((packed)) ThumbCacheHeader {
+  uint32_t magic;
+  uint16_t version;
+  uint16_t count;
+  uint16_t thumb_width;
+  uint16_t thumb_height;
+  uint8_t big_endian;
+  uint8_t reserved[19];
+};
+
+struct __attribute__((packed)) ThumbCacheEntry {
+  uint32_t name_hash;  // asset_name_hash(file name)
+  uint32_t file_size;  // source size + mtime: a changed file is regenerated
+  uint32_t mtime;
+  uint16_t width;
+  uint16_t height;
+};
+
+static_assert(sizeof(ThumbCacheHeader) == 32, "ThumbCacheHeader layout changed");
+static_assert(sizeof(ThumbCacheEntry) == 16, "ThumbCacheEntry layout changed");
+
+class ThumbnailCache {
+ public:
+  ~ThumbnailCache() { this->close(); }
+
+  void set_size(int width, int height) {
+    this->thumb_width_ = width;
+    this->thumb_height_ = height;
+  }
+  void set_big_endian(bool big_endian) { this->big_endian_ = big_endian; }
+  int get_thumb_width() const { return this->thumb_width_; }
+  int get_thumb_height() const { return this->thumb_height_; }
+
+  // Lists the folder and opens (or creates) its cache file; nothing is decoded here
+  bool open_folder(const std::string &full_folder);
+  void close();
+  bool is_open() const { return this->file_ != nullptr; }
+  const std::string &get_folder() const { return this->folder_; }
+
+  size_t get_count() const { return this->entries_.size(); }
+  const std::string &get_file_name(size_t index) const { return this->names_[index]; }
+  bool is_ready(size_t index) const { return index < this->entries_.size() && this->entries_[index].width > 0; }
+  size_t get_pending() const { return this->pending_; }
+
+  // Makes the next missing thumbnail; false when there was nothing to do
+  bool generate_next();
+  // Next thumbnail to decode: true with its index and source path. false when
+  // none is left or the next one was copied from the previous file
+  bool begin_next(size_t &index, std::string &path);
+  // Decodes into the work cell; touches nothing the main loop uses meanwhile
+  bool render(const std::string &path);
+  // Writes the rendered cell; dropped if the folder was closed since begin_next()
+  void finish(size_t index, uint32_t generation, bool ok);
+  bool is_rendering() const { return this->rendering_; }
+  uint32_t get_generation() const { return this->generation_; }
+
+  // Reads thumbnails [first, first + count) with one sequential read
+  bool load_page(size_t first, size_t count);
+  // Cell of a thumbnail inside the loaded page, nullptr if outside or not generated
+  const uint8_t *get_thumbnail(size_t index) const;
+  // Draws the whole cell at (x, y); false when the thumbnail is not available yet
+  bool draw(size_t index, int x, int y, display::Display *display);
+
+  void add_on_ready_callback(std::function<void(size_t)> &&callback) {
+    this->ready_callback_.add(std::move(callback));
+  }
+
+ protected:
+  enum class SourceType : uint8_t { UNKNOWN, JPEG, PNG, GIF };
+
+  // Cible de l'échantillonnage pendant le décodage
+  struct CellTarget {
+    uint8_t *dst{nullptr};
+    int src_width{0};   // dimensions delivered by the decoder (after JPEG scaling)
+    int src_height{0};
+    int off_x{0};
+    int off_y{0};
+    int width{0};       // content size inside the cell
+    int height{0};
+  };
+
+  size_t cell_bytes_() const { return (size_t) this->thumb_width_ * this->thumb_height_ * 2; }
+  uint32_t cell_offset_(size_t index) const { return this->data_offset_ + index * this->cell_bytes_(); }
+  bool write_entry_(size_t index);
+  bool write_cell_(size_t index, const uint8_t *cell);
+  bool copy_from_previous_(size_t index);
+  void store_(size_t index);
+  bool render_(const std::string &path, uint8_t *cell);
+  bool begin_cell_(int src_width, int src_height, int full_width, int full_height);
+  void put_(int x, int y, uint16_t native);
+  void finish_previous_();
+
+#ifdef USE_JPEGDEC
+  static int jpeg_cb_(JPEGDRAW *draw);
+#endif
+#ifdef USE_PNGLE
+  static void png_init_cb_(pngle_t *pngle, uint32_t w, uint32_t h);
+  static void png_draw_cb_(pngle_t *pngle, uint32_t x, uint32_t y, uint32_t w, uint32_t h, const uint8_t rgba[4]);
+#endif
+#ifdef USE_ANIMATEDGIF
+  static void gif_cb_(GIFDRAW *draw);
+#endif
+
+  int thumb_width_{64};
+  int thumb_height_{64};
+  bool big_endian_{false};
+
+  std::string folder_;
+  std::string cache_path_;
+  FILE *file_{nullptr};
+  uint32_t data_offset_{0};
+  std::vector<std::string> names_;
+  std::vector<ThumbCacheEntry> entries_;
+  std::vector<int> previous_slot_;  // cell index in the previous file, -1 = decode
+  FILE *previous_{nullptr};
+  uint32_t previous_data_offset_{0};
+  size_t pending_{0};
+  size_t next_{0};
+  bool rendering_{false};     // cell_ and target_ belong to render() until finish()
+  uint32_t generation_{0};    // bumped by close()
+
+  CellTarget target_;
+  bool target_ok_{false};
+  ImageBuffer cell_;
+  ImageBuffer page_;
+  size_t page_first_{0};
+  size_t page_count_{0};
+
+  CallbackManager<void(size_t)> ready_callback_;
+};
+
+}  // namespace storage
+}  // namespace esphome
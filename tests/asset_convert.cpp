@@ -0,0 +1,110 @@
+// Host reference for tools/asset_packer.py: converts RGBA pixels with the
+// device code (PixelOps::pack as used by set_pixel, then the nearest-neighbour
+// mapping) so tests/asset_packer_parity.py can compare the packer's
+// pre-converted entries byte for byte. The mode follows one device path:
+//
+//   resize  decode at source size, then resize_image_buffer (gather by nearest_source)
+//   pngdec  png_row_callback: each source row gathered into its target rows
+//   pngle   png_draw_callback: each source pixel pushed to its targets (first_target),
+//           in decoder order, into a zeroed buffer so unfilled pixels show
+//
+// usage:  asset_convert [resize|pngdec|pngle]   (default resize)
+// stdin:  "<width> <height> <dst_width> <dst_height> <encoding>\n" then width*height*4 RGBA bytes
+// stdout: the entry blob (encoding as in AssetEncoding: 1 RGB565 LE, 2 RGB565 BE, 3 RGB888, 4 RGBA8888)
+#include "pixel_kernels.h"
+#include "pixel_pipeline.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace esphome::storage;
+
+int main(int argc, char **argv) {
+  std::string mode = argc > 1 ? argv[1] : "resize";
+  if (mode != "resize" && mode != "pngdec" && mode != "pngle") {
+    fprintf(stderr, "unknown mode %s\n", mode.c_str());
+    return 2;
+  }
+  int width, height, dst_width, dst_height, encoding;
+  if (scanf("%d %d %d %d %d", &width, &height, &dst_width, &dst_height, &encoding) != 5 || getchar() != '\n' ||
+      width <= 0 || height <= 0 || dst_width <= 0 || dst_height <= 0) {
+    fprintf(stderr, "bad header\n");
+    return 2;
+  }
+
+  ImageFormat format = ImageFormat::RGB565;
+  SdByteOrder order = SdByteOrder::LITTLE_ENDIAN_SD;
+  switch (encoding) {
+    case 1:
+      break;
+    case 2:
+      order = SdByteOrder::BIG_ENDIAN_SD;
+      break;
+    case 3:
+      format = ImageFormat::RGB888;
+      break;
+    case 4:
+      format = ImageFormat::RGBA;
+      break;
+    default:
+      fprintf(stderr, "bad encoding %d\n", encoding);
+      return 2;
+  }
+
+  std::vector<uint8_t> rgba((size_t) width * height * 4);
+  if (fread(rgba.data(), 1, rgba.size(), stdin) != rgba.size()) {
+    fprintf(stderr, "short pixel data\n");
+    return 2;
+  }
+
+  const PixelOps &ops = get_pixel_ops(format, order);
+  std::vector<uint8_t> out((size_t) dst_width * dst_height * ops.size);
+  auto put = [&](int x, int y, const uint8_t *p) {
+    ops.pack(&out[((size_t) y * dst_width + x) * ops.size], p[0], p[1], p[2], p[3]);
+  };
+
+  if (mode == "pngle") {
+    // Un pixel source à la fois, dans l'ordre du décodeur
+    for (int y = 0; y < height; y++) {
+      int dy_end = std::min(kernels::first_target(y + 1, height, dst_height), dst_height);
+      for (int x = 0; x < width; x++) {
+        int dx_end = std::min(kernels::first_target(x + 1, width, dst_width), dst_width);
+        for (int dy = kernels::first_target(y, height, dst_height); dy < dy_end; dy++) {
+          for (int dx = kernels::first_target(x, width, dst_width); dx < dx_end; dx++) {
+            put(dx, dy, &rgba[((size_t) y * width + x) * 4]);
+          }
+        }
+      }
+    }
+  } else if (mode == "pngdec") {
+    // Une ligne source à la fois, colonnes rassemblées par nearest_source
+    for (int y = 0; y < height; y++) {
+      int dy_end = std::min(kernels::first_target(y + 1, height, dst_height), dst_height);
+      for (int dy = kernels::first_target(y, height, dst_height); dy < dy_end; dy++) {
+        for (int dx = 0; dx < dst_width; dx++) {
+          put(dx, dy, &rgba[((size_t) y * width + kernels::nearest_source(dx, width, dst_width)) * 4]);
+        }
+      }
+    }
+  } else {
+    // Décodage: un set_pixel par pixel à la taille source
+    std::vector<uint8_t> decoded((size_t) width * height * ops.size);
+    for (int i = 0; i < width * height; i++) {
+      const uint8_t *p = &rgba[i * 4];
+      ops.pack(&decoded[i * ops.size], p[0], p[1], p[2], p[3]);
+    }
+    // Redimensionnement: mêmes indices que resize_image_buffer
+    uint8_t *dst = out.data();
+    for (int y = 0; y < dst_height; y++) {
+      int src_y = kernels::nearest_source(y, height, dst_height);
+      for (int x = 0; x < dst_width; x++, dst += ops.size) {
+        memcpy(dst, &decoded[((size_t) src_y * width + kernels::nearest_source(x, width, dst_width)) * ops.size],
+               ops.size);
+      }
+    }
+  }
+  fwrite(out.data(), 1, out.size(), stdout);
+  return 0;
+}
@@ -0,0 +1,97 @@
+#!/usr/bin/env python3
+"""Check that tools/asset_packer.py converts pixels exactly like the device.
+
+Random RGBA images (random sizes, alpha, resize targets, every pre-converted
+encoding) go through the packer's resize_nearest() + convert_pixels() and
+through tests/asset_convert.cpp, which runs the C++ conversion code
+(PixelOps::pack, kernels::nearest_source / first_target) the way each device
+path does: resize_image_buffer, the PNGdec row callback and the pngle
+per-pixel callback. Any differing byte fails.
+
+Usage (from the repository root):
+    g++ -std=gnu++17 -O2 -Itests/stubs -Icomponents/storage tests/asset_convert.cpp \
+        components/storage/pixel_pipeline.cpp -o /tmp/asset_convert
+    python3 tests/asset_packer_parity.py /tmp/asset_convert
+"""
+
+from __future__ import annotations
+
+import importlib.util
+import random
+import subprocess
+import sys
+from pathlib import Path
+
+ROOT = Path(__file__).resolve().parent.parent
+ITERATIONS = 300
+MAX_SIZE = 40
+# Agrandissements où une échelle float32 (src / dst) choisit un autre pixel source que i * src / dst
+EDGE_CASES = [(2, 2, 82, 82), (4, 6, 94, 74), (8, 9, 110, 111), (6, 2, 74, 94)]
+
+
+def load_packer():
+    spec = importlib.util.spec_from_file_location("asset_packer", ROOT / "tools" / "asset_packer.py")
+    module = importlib.util.module_from_spec(spec)
+    spec.loader.exec_module(module)
+    return module
+
+
+DEVICE_PATHS = ["resize", "pngdec", "pngle"]
+
+
+def device_convert(tool: str, path: str, pixels, width: int, height: int, dst_width: int, dst_height: int,
+                   encoding: int) -> bytes:
+    header = f"{width} {height} {dst_width} {dst_height} {encoding}\n".encode()
+    rgba = bytes(channel for pixel in pixels for channel in pixel)
+    result = subprocess.run([tool, path], input=header + rgba, capture_output=True, check=True)
+    return result.stdout
+
+
+def main(argv) -> int:
+    if len(argv) != 2:
+        sys.exit(__doc__)
+    tool = argv[1]
+    packer = load_packer()
+    encodings = [
+        packer.ENCODING_RGB565_LE,
+        packer.ENCODING_RGB565_BE,
+        packer.ENCODING_RGB888,
+        packer.ENCODING_RGBA8888,
+    ]
+    rng = random.Random(26)
+
+    cases = []
+    for iteration in range(ITERATIONS):
+        width = rng.randint(1, MAX_SIZE)
+        height = rng.randint(1, MAX_SIZE)
+        # Un tiers sans redimensionnement, le reste en réduction ou agrandissement
+        if iteration % 3 == 0:
+            cases.append((width, height, width, height))
+        else:
+            cases.append((width, height, rng.randint(1, MAX_SIZE * 2), rng.randint(1, MAX_SIZE * 2)))
+    cases += EDGE_CASES
+
+    failures = 0
+    for iteration, (width, height, dst_width, dst_height) in enumerate(cases):
+        pixels = [tuple(rng.randrange(256) for _ in range(4)) for _ in range(width * height)]
+        encoding = encodings[iteration % len(encodings)]
+
+        resized = pixels
+        if (dst_width, dst_height) != (width, height):
+            resized = packer.resize_nearest(pixels, width, height, dst_width, dst_height)
+        actual = packer.convert_pixels(resized, encoding)
+        for path in DEVICE_PATHS:
+            expected = device_convert(tool, path, pixels, width, height, dst_width, dst_height, encoding)
+            if actual != expected:
+                failures += 1
+                first = next((i for i, (a, b) in enumerate(zip(actual, expected)) if a != b),
+                             min(len(actual), len(expected)))
+                print(f"FAIL {path} {width}x{height} -> {dst_width}x{dst_height}, encoding {encoding}: "
+                      f"first difference at byte {first} ({len(actual)} vs {len(expected)} bytes)")
+
+    print(f"{len(cases)} images x {len(DEVICE_PATHS)} device paths, {failures} mismatches")
+    return 1 if failures else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
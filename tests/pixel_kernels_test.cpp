@@ -0,0 +1,116 @@
+// Host test: every kernel of the selected implementation must be bit-exact
+// with kernels::scalar. Build it once per implementation (see README):
+//   SSE2 on x86-64 by default, SWAR with -U__SSE2__ -DESP32, scalar with -U__SSE2__.
+#include "pixel_kernels.h"
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace esphome::storage::kernels;
+
+static const int ITERATIONS = 2000;
+static const size_t MAX_PIXELS = 66;
+static const size_t MAX_OFFSET = 4;  // départs non alignés
+static const size_t SLACK = 16;
+
+static int failures = 0;
+static int checks = 0;
+
+static void expect_same(const char *kernel, const std::vector<uint8_t> &actual, const std::vector<uint8_t> &expected,
+                        size_t count, bool big_endian, unsigned weight) {
+  checks++;
+  if (actual != expected) {
+    failures++;
+    printf("FAIL %s: %zu pixels, %s endian, weight %u\n", kernel, count, big_endian ? "big" : "little", weight);
+  }
+}
+
+// Valeurs connues, indépendantes de l'implémentation de référence
+static void check_references() {
+  const uint8_t orange[4] = {0xFF, 0x80, 0x08, 0xFF};
+  uint8_t out[3];
+  rgba_to_rgb565(orange, out, 1, true);
+  checks++;
+  if (out[0] != 0xFC || out[1] != 0x01) {
+    failures++;
+    printf("FAIL rgba_to_rgb565 reference: %02X%02X\n", out[0], out[1]);
+  }
+
+  // Blanc RGB565: 0xFF partout, pas 0xF8/0xFC
+  const uint8_t white[2] = {0xFF, 0xFF};
+  rgb565_to_rgb888(white, out, 1, false);
+  checks++;
+  if (out[0] != 0xFF || out[1] != 0xFF || out[2] != 0xFF) {
+    failures++;
+    printf("FAIL rgb565_to_rgb888 reference: %02X %02X %02X\n", out[0], out[1], out[2]);
+  }
+}
+
+int main() {
+  std::mt19937 rng(1);
+  auto random_bytes = [&rng](size_t size) {
+    std::vector<uint8_t> bytes(size);
+    for (auto &b : bytes) {
+      b = rng();
+    }
+    return bytes;
+  };
+
+  for (int iter = 0; iter < ITERATIONS; iter++) {
+    size_t count = rng() % (MAX_PIXELS + 1);
+    size_t offset = rng() % (MAX_OFFSET + 1);
+    bool big_endian = rng() & 1;
+    uint16_t weight = rng() % 257;
+    size_t size = count * 4 + SLACK;
+
+    std::vector<uint8_t> a = random_bytes(size);
+    std::vector<uint8_t> b = random_bytes(size);
+    std::vector<uint16_t> x_map(count);
+    std::vector<uint16_t> x_weight(count);
+    for (size_t i = 0; i < count; i++) {
+      x_map[i] = rng() % count;
+      x_weight[i] = rng() % 257;
+    }
+    std::vector<uint8_t> actual(size, 0);
+    std::vector<uint8_t> expected(size, 0);
+    auto reset = [&]() {
+      actual.assign(size, 0);
+      expected.assign(size, 0);
+    };
+
+    rgba_to_rgb565(a.data() + offset, actual.data() + offset, count, big_endian);
+    scalar::rgba_to_rgb565(a.data() + offset, expected.data() + offset, count, big_endian);
+    expect_same("rgba_to_rgb565", actual, expected, count, big_endian, 0);
+
+    actual = a;
+    expected = a;
+    swap565(actual.data() + offset, count);
+    scalar::swap565(expected.data() + offset, count);
+    expect_same("swap565", actual, expected, count, big_endian, 0);
+
+    reset();
+    rgb565_to_rgb888(a.data() + offset, actual.data() + offset, count, big_endian);
+    scalar::rgb565_to_rgb888(a.data() + offset, expected.data() + offset, count, big_endian);
+    expect_same("rgb565_to_rgb888", actual, expected, count, big_endian, 0);
+
+    reset();
+    blend565(a.data() + offset, b.data(), actual.data() + offset, count, weight, big_endian);
+    scalar::blend565(a.data() + offset, b.data(), expected.data() + offset, count, weight, big_endian);
+    expect_same("blend565", actual, expected, count, big_endian, weight);
+
+    reset();
+    gather565(a.data(), x_map.data(), actual.data() + offset, count);
+    scalar::gather565(a.data(), x_map.data(), expected.data() + offset, count);
+    expect_same("gather565", actual, expected, count, big_endian, 0);
+
+    reset();
+    resample565(a.data(), count, x_map.data(), x_weight.data(), actual.data() + offset, count, big_endian);
+    scalar::resample565(a.data(), count, x_map.data(), x_weight.data(), expected.data() + offset, count, big_endian);
+    expect_same("resample565", actual, expected, count, big_endian, 0);
+  }
+
+  check_references();
+  printf("%s: %d checks, %d failures\n", implementation(), checks, failures);
+  return failures != 0;
+}
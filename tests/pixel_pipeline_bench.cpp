@@ -0,0 +1,153 @@
+// Host microbenchmark: per-pixel format switch (set_pixel/get_pixel_color
+// before PixelTraits) against the compile-time pixel pipeline.
+#include "pixel_pipeline.h"
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+using namespace esphome;
+using namespace esphome::storage;
+
+static const int WIDTH = 800;
+static const int HEIGHT = 480;
+static const int RUNS = 50;
+
+// Ancien chemin: format et ordre des octets relus à chaque pixel
+struct SwitchImage {
+  ImageFormat format;
+  SdByteOrder byte_order;
+  int width;
+  int height;
+  std::vector<uint8_t> buffer;
+
+  size_t pixel_size() const {
+    switch (this->format) {
+      case ImageFormat::RGB888:
+        return 3;
+      case ImageFormat::RGBA:
+        return 4;
+      case ImageFormat::RGB565:
+      default:
+        return 2;
+    }
+  }
+
+  __attribute__((noinline)) void set_pixel(int x, int y, uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
+    if (x < 0 || x >= this->width || y < 0 || y >= this->height) {
+      return;
+    }
+    size_t offset = (y * this->width + x) * this->pixel_size();
+    if (offset + this->pixel_size() > this->buffer.size()) {
+      return;
+    }
+    uint8_t *dst = &this->buffer[offset];
+    switch (this->format) {
+      case ImageFormat::RGB565: {
+        uint16_t v = ((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3);
+        bool big_endian = this->byte_order == SdByteOrder::BIG_ENDIAN_SD;
+        dst[big_endian ? 0 : 1] = v >> 8;
+        dst[big_endian ? 1 : 0] = v & 0xFF;
+        break;
+      }
+      case ImageFormat::RGBA:
+        dst[3] = a;
+        // fall through
+      default:
+        dst[0] = r;
+        dst[1] = g;
+        dst[2] = b;
+        break;
+    }
+  }
+
+  __attribute__((noinline)) Color get_pixel(int x, int y) const {
+    if (x < 0 || x >= this->width || y < 0 || y >= this->height) {
+      return Color::BLACK;
+    }
+    size_t offset = (y * this->width + x) * this->pixel_size();
+    if (offset + this->pixel_size() > this->buffer.size()) {
+      return Color::BLACK;
+    }
+    const uint8_t *src = &this->buffer[offset];
+    switch (this->format) {
+      case ImageFormat::RGB565: {
+        uint16_t v = this->byte_order == SdByteOrder::BIG_ENDIAN_SD ? (src[0] << 8) | src[1] : src[0] | (src[1] << 8);
+        return Color(((v >> 11) & 0x1F) << 3, ((v >> 5) & 0x3F) << 2, (v & 0x1F) << 3);
+      }
+      case ImageFormat::RGB888:
+        return Color(src[0], src[1], src[2]);
+      default:
+        return Color(src[0], src[1], src[2], src[3]);
+    }
+  }
+};
+
+template<typename Fn> static double mean_ms(Fn &&fn) {
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < RUNS; i++) {
+    fn();
+  }
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / RUNS;
+}
+
+int main() {
+  std::vector<uint8_t> rgba(WIDTH * HEIGHT * 4);
+  for (size_t i = 0; i < rgba.size(); i++) {
+    rgba[i] = i * 31;
+  }
+  SwitchImage image{ImageFormat::RGB565, SdByteOrder::BIG_ENDIAN_SD, WIDTH, HEIGHT,
+                    std::vector<uint8_t>(WIDTH * HEIGHT * 2)};
+  std::vector<uint8_t> out(WIDTH * HEIGHT * 2);
+  unsigned sink = 0;
+
+  double write_switch = mean_ms([&] {
+    for (int y = 0; y < HEIGHT; y++) {
+      for (int x = 0; x < WIDTH; x++) {
+        const uint8_t *p = &rgba[(y * WIDTH + x) * 4];
+        image.set_pixel(x, y, p[0], p[1], p[2], p[3]);
+      }
+    }
+  });
+  double write_row = mean_ms([&] {
+    dispatch_pixel_format(ImageFormat::RGB565, SdByteOrder::BIG_ENDIAN_SD, [&](auto traits) {
+      using Dst = decltype(traits);
+      for (int y = 0; y < HEIGHT; y++) {
+        convert_row<PixelTraits<ImageFormat::RGBA, false>, Dst>(&rgba[y * WIDTH * 4], &out[y * WIDTH * 2], WIDTH);
+      }
+    });
+  });
+  const PixelOps &ops = get_pixel_ops(ImageFormat::RGB565, SdByteOrder::BIG_ENDIAN_SD);
+  double write_ops = mean_ms([&] {
+    for (int i = 0; i < WIDTH * HEIGHT; i++) {
+      const uint8_t *p = &rgba[i * 4];
+      ops.pack(&out[i * 2], p[0], p[1], p[2], p[3]);
+    }
+  });
+
+  double read_switch = mean_ms([&] {
+    for (int y = 0; y < HEIGHT; y++) {
+      for (int x = 0; x < WIDTH; x++) {
+        sink += image.get_pixel(x, y).r;
+      }
+    }
+  });
+  double read_template = mean_ms([&] {
+    dispatch_pixel_format(ImageFormat::RGB565, SdByteOrder::BIG_ENDIAN_SD, [&](auto traits) {
+      using P = decltype(traits);
+      const uint8_t *src = image.buffer.data();
+      for (int i = 0; i < WIDTH * HEIGHT; i++, src += P::SIZE) {
+        sink += read_color<P>(src).r;
+      }
+    });
+  });
+
+  // Les deux chemins d'écriture doivent produire les mêmes octets
+  bool identical = image.buffer == out;
+  printf("%dx%d, mean of %d runs\n", WIDTH, HEIGHT, RUNS);
+  printf("RGBA -> RGB565 BE: switch per pixel %.2f ms, convert_row %.2f ms (%.1fx), PixelOps per pixel %.2f ms\n",
+         write_switch, write_row, write_switch / write_row, write_ops);
+  printf("RGB565 BE -> Color: switch per pixel %.2f ms, template loop %.2f ms (%.1fx)\n", read_switch, read_template,
+         read_switch / read_template);
+  printf("identical output: %s [%u]\n", identical ? "yes" : "NO", sink & 1);
+  return identical ? 0 : 1;
+}
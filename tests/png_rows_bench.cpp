@@ -0,0 +1,231 @@
+// Host benchmark of the conversion stage only: one callback per pixel (the
+// way pngle hands pixels to png_draw_callback) against png_row_to_rgba +
+// rgba_to_rgb565 on whole rows (the PNGdec path). Neither pngle nor PNGdec
+// builds on the host: libpng produces the unfiltered rows PNGdec would pass
+// to its callback, so inflate/unfilter speed of the two libraries is NOT
+// compared here; it is printed separately as libpng's own cost.
+#include "pixel_kernels.h"
+#include "png_rows.h"
+#include <png.h>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace esphome::storage;
+
+static const int RUNS = 300;
+static const int INFLATE_RUNS = 50;
+
+struct PngFile {
+  const char *name;
+  std::vector<uint8_t> bytes;
+};
+
+// Lignes défiltrées dans le format du fichier: ce que PNGdec passe au callback
+struct UnfilteredImage {
+  int width{0};
+  int height{0};
+  PngRowFormat format;
+  size_t pitch{0};
+  std::vector<uint8_t> rows;
+  std::vector<uint8_t> palette;  // 256 x RGB puis 256 alphas
+};
+
+struct MemoryReader {
+  const std::vector<uint8_t> *bytes;
+  size_t pos;
+};
+
+static void read_memory(png_structp png, png_bytep dst, png_size_t len) {
+  MemoryReader *reader = static_cast<MemoryReader *>(png_get_io_ptr(png));
+  if (reader->pos + len > reader->bytes->size()) {
+    png_error(png, "truncated");
+  }
+  memcpy(dst, reader->bytes->data() + reader->pos, len);
+  reader->pos += len;
+}
+
+static UnfilteredImage read_rows(const std::vector<uint8_t> &bytes) {
+  UnfilteredImage image;
+  MemoryReader reader{&bytes, 0};
+  png_structp png = png_create_read_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
+  png_infop info = png_create_info_struct(png);
+  png_set_read_fn(png, &reader, read_memory);
+  png_read_info(png, info);
+  image.width = png_get_image_width(png, info);
+  image.height = png_get_image_height(png, info);
+  image.format.pixel_type = png_get_color_type(png, info);
+  image.format.bit_depth = png_get_bit_depth(png, info);
+  image.pitch = png_get_rowbytes(png, info);
+  image.rows.resize(image.pitch * image.height);
+
+  image.palette.assign(1024, 255);
+  if (image.format.pixel_type == PNG_TYPE_INDEXED) {
+    png_colorp colors;
+    int count;
+    png_get_PLTE(png, info, &colors, &count);
+    for (int i = 0; i < count; i++) {
+      image.palette[i * 3] = colors[i].red;
+      image.palette[i * 3 + 1] = colors[i].green;
+      image.palette[i * 3 + 2] = colors[i].blue;
+    }
+    png_bytep alphas;
+    int alpha_count;
+    png_color_16p unused;
+    if (png_get_tRNS(png, info, &alphas, &alpha_count, &unused)) {
+      image.format.palette_alpha = true;
+      memcpy(&image.palette[768], alphas, alpha_count);
+    }
+  }
+  image.format.palette = image.palette.data();
+
+  for (int y = 0; y < image.height; y++) {
+    png_read_row(png, &image.rows[y * image.pitch], nullptr);
+  }
+  png_destroy_read_struct(&png, &info, nullptr);
+  return image;
+}
+
+static void write_memory(png_structp png, png_bytep data, png_size_t len) {
+  auto *out = static_cast<std::vector<uint8_t> *>(png_get_io_ptr(png));
+  out->insert(out->end(), data, data + len);
+}
+
+static void flush_memory(png_structp) {}
+
+static std::vector<uint8_t> write_png(int w, int h, int color_type, const std::vector<uint8_t> &pixels,
+                                      const std::vector<png_color> &palette = {},
+                                      const std::vector<uint8_t> &alphas = {}) {
+  std::vector<uint8_t> out;
+  png_structp png = png_create_write_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
+  png_infop info = png_create_info_struct(png);
+  png_set_write_fn(png, &out, write_memory, flush_memory);
+  png_set_IHDR(png, info, w, h, 8, color_type, PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_DEFAULT,
+               PNG_FILTER_TYPE_DEFAULT);
+  if (color_type == PNG_COLOR_TYPE_PALETTE) {
+    png_set_PLTE(png, info, palette.data(), palette.size());
+    if (!alphas.empty()) {
+      png_set_tRNS(png, info, alphas.data(), alphas.size(), nullptr);
+    }
+  }
+  png_write_info(png, info);
+  int channels = color_type == PNG_COLOR_TYPE_RGB ? 3 : color_type == PNG_COLOR_TYPE_RGBA ? 4 : 1;
+  for (int y = 0; y < h; y++) {
+    png_write_row(png, &pixels[y * w * channels]);
+  }
+  png_write_end(png, info);
+  png_destroy_write_struct(&png, &info);
+  return out;
+}
+
+static std::vector<PngFile> make_samples() {
+  std::mt19937 rng(5);
+  const int w = 320;
+  const int h = 240;
+  std::vector<uint8_t> photo(w * h * 3);
+  std::vector<uint8_t> ui(w * h);
+  for (int y = 0; y < h; y++) {
+    for (int x = 0; x < w; x++) {
+      uint8_t *p = &photo[(y * w + x) * 3];
+      p[0] = x * 3 + y + rng() % 24;
+      p[1] = y * 2 + rng() % 24;
+      p[2] = (x + y) / 2 + rng() % 24;
+      bool button = x > 20 && x < 150 && y > 100 && y < 140;
+      ui[y * w + x] = button ? 1 : y < 30 ? 2 + x * 10 / w : 0;
+    }
+  }
+  std::vector<png_color> palette(12);
+  for (int i = 0; i < 12; i++) {
+    palette[i] = {(uint8_t) (i * 20), (uint8_t) (240 - i * 10), (uint8_t) (i * 5)};
+  }
+  std::vector<uint8_t> palette_alpha = {255, 128, 0};
+
+  std::vector<uint8_t> icon(64 * 64 * 4);
+  for (int y = 0; y < 64; y++) {
+    for (int x = 0; x < 64; x++) {
+      uint8_t *p = &icon[(y * 64 + x) * 4];
+      int d = (x - 32) * (x - 32) + (y - 32) * (y - 32);
+      p[0] = 220;
+      p[1] = 60;
+      p[2] = 40;
+      p[3] = d < 700 ? 255 : d < 900 ? (900 - d) * 255 / 200 : 0;
+    }
+  }
+
+  return {
+      {"photo 320x240 RGB", write_png(w, h, PNG_COLOR_TYPE_RGB, photo)},
+      {"ui 320x240 indexed+tRNS", write_png(w, h, PNG_COLOR_TYPE_PALETTE, ui, palette, palette_alpha)},
+      {"icon 64x64 RGBA", write_png(64, 64, PNG_COLOR_TYPE_RGBA, icon)},
+  };
+}
+
+// Modèle du chemin pngle: un appel non inliné par pixel, bornes vérifiées,
+// écriture par le pointeur PixelOps::pack
+struct PixelTarget {
+  int width;
+  int height;
+  uint8_t *buffer;
+  void (*pack)(uint8_t *dst, uint8_t r, uint8_t g, uint8_t b, uint8_t a);
+};
+
+__attribute__((noinline)) static void pack565_be(uint8_t *dst, uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
+  uint16_t v = ((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3);
+  dst[0] = v >> 8;
+  dst[1] = v & 0xFF;
+}
+
+__attribute__((noinline)) static void draw_pixel(PixelTarget *target, uint32_t x, uint32_t y, const uint8_t rgba[4]) {
+  if (x < (uint32_t) target->width && y < (uint32_t) target->height) {
+    target->pack(target->buffer + (y * target->width + x) * 2, rgba[0], rgba[1], rgba[2], rgba[3]);
+  }
+}
+
+template<typename Fn> static double mean_us(int runs, Fn &&fn) {
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < runs; i++) {
+    fn();
+  }
+  return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / runs;
+}
+
+int main() {
+  bool all_identical = true;
+  printf("Conversion stage only; pngle vs PNGdec decode speed is not measured on the host\n");
+  printf("%-26s %14s %14s %8s %17s\n", "image", "per pixel", "rows", "", "libpng inflate");
+  for (const PngFile &file : make_samples()) {
+    UnfilteredImage image = read_rows(file.bytes);
+    int w = image.width;
+    int h = image.height;
+    std::vector<uint8_t> per_pixel(w * h * 2);
+    std::vector<uint8_t> per_row(w * h * 2);
+    std::vector<uint8_t> rgba(w * 4);
+    PixelTarget target{w, h, per_pixel.data(), pack565_be};
+
+    double pixel_us = mean_us(RUNS, [&] {
+      for (int y = 0; y < h; y++) {
+        const uint8_t *row = &image.rows[y * image.pitch];
+        for (int x = 0; x < w; x++) {
+          uint8_t px[4];
+          png_row_to_rgba(image.format, row, x, 1, px);
+          draw_pixel(&target, x, y, px);
+        }
+      }
+    });
+    double row_us = mean_us(RUNS, [&] {
+      for (int y = 0; y < h; y++) {
+        png_row_to_rgba(image.format, &image.rows[y * image.pitch], 0, w, rgba.data());
+        kernels::rgba_to_rgb565(rgba.data(), &per_row[y * w * 2], w, true);
+      }
+    });
+    // Coût commun aux deux modèles (libpng, pas le zlib de pngle/PNGdec)
+    double inflate_us = mean_us(INFLATE_RUNS, [&] { read_rows(file.bytes); });
+
+    bool identical = per_pixel == per_row;
+    all_identical = all_identical && identical;
+    printf("%-26s %11.0f us %11.0f us (%4.1fx) %14.0f us  %s\n", file.name, pixel_us, row_us, pixel_us / row_us,
+           inflate_us, identical ? "identical" : "MISMATCH");
+  }
+  return all_identical ? 0 : 1;
+}
@@ -0,0 +1,175 @@
+// Host benchmark: QOI row decoder/encoder against libpng on the same pixels,
+// with a bit-exact round trip (memory and FILE streaming). pngle is not
+// available on the host, libpng stands in as the PNG reference.
+#include "qoi_codec.h"
+#include <png.h>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace esphome::storage;
+
+static const int RUNS = 200;
+
+enum class Scene { UI_PANEL, ICON_ALPHA, PHOTO };
+
+struct Sample {
+  const char *name;
+  int width;
+  int height;
+  Scene scene;
+};
+
+static std::vector<uint8_t> make_pixels(const Sample &sample, std::mt19937 &rng) {
+  int w = sample.width;
+  int h = sample.height;
+  std::vector<uint8_t> rgba(w * h * 4);
+  for (int y = 0; y < h; y++) {
+    for (int x = 0; x < w; x++) {
+      uint8_t *p = &rgba[(y * w + x) * 4];
+      p[3] = 255;
+      switch (sample.scene) {
+        case Scene::UI_PANEL: {
+          // Aplats, un bouton et un bandeau en dégradé
+          bool button = x > 20 && x < 150 && y > 100 && y < 140;
+          p[0] = y < 30 ? x * 255 / w : button ? 30 : 240;
+          p[1] = y < 30 ? 80 : button ? 120 : 240;
+          p[2] = y < 30 ? 160 : button ? 200 : 245;
+          break;
+        }
+        case Scene::ICON_ALPHA: {
+          // Disque au bord antialiasé
+          int d = (x - w / 2) * (x - w / 2) + (y - h / 2) * (y - h / 2);
+          p[0] = 220;
+          p[1] = 60;
+          p[2] = 40;
+          p[3] = d < 700 ? 255 : d < 900 ? (900 - d) * 255 / 200 : 0;
+          break;
+        }
+        case Scene::PHOTO:
+          // Dégradés bruités, proches d'une photo pour les deux compresseurs
+          p[0] = (x * 3 + y + rng() % 24) & 255;
+          p[1] = (y * 2 + rng() % 24) & 255;
+          p[2] = ((x + y) / 2 + rng() % 24) & 255;
+          break;
+      }
+    }
+  }
+  return rgba;
+}
+
+static std::vector<uint8_t> encode_png(const std::vector<uint8_t> &rgba, int w, int h) {
+  png_image image;
+  memset(&image, 0, sizeof(image));
+  image.version = PNG_IMAGE_VERSION;
+  image.width = w;
+  image.height = h;
+  image.format = PNG_FORMAT_RGBA;
+  png_alloc_size_t size = 0;
+  png_image_write_to_memory(&image, nullptr, &size, 0, rgba.data(), 0, nullptr);
+  std::vector<uint8_t> png(size);
+  png_image_write_to_memory(&image, png.data(), &size, 0, rgba.data(), 0, nullptr);
+  png.resize(size);
+  return png;
+}
+
+static bool decode_png(const std::vector<uint8_t> &png, std::vector<uint8_t> &rgba) {
+  png_image image;
+  memset(&image, 0, sizeof(image));
+  image.version = PNG_IMAGE_VERSION;
+  if (!png_image_begin_read_from_memory(&image, png.data(), png.size())) {
+    return false;
+  }
+  image.format = PNG_FORMAT_RGBA;
+  return png_image_finish_read(&image, nullptr, rgba.data(), 0, nullptr) != 0;
+}
+
+static std::vector<uint8_t> encode_qoi(const std::vector<uint8_t> &rgba, int w, int h, uint8_t channels) {
+  std::vector<uint8_t> qoi;
+  QoiEncoder encoder;
+  encoder.begin(w, h, channels, [&qoi](const uint8_t *data, size_t len) {
+    qoi.insert(qoi.end(), data, data + len);
+    return true;
+  });
+  for (int y = 0; y < h; y++) {
+    encoder.write_row_rgba(&rgba[y * w * 4]);
+  }
+  encoder.finish();
+  return qoi;
+}
+
+// Comparaison sur les canaux encodés (RGB: alpha toujours 255 au décodage)
+static bool rows_match(QoiDecoder &decoder, const std::vector<uint8_t> &rgba, int w, int h, uint8_t channels) {
+  std::vector<uint8_t> row(w * 4);
+  for (int y = 0; y < h; y++) {
+    if (!decoder.decode_row(row.data())) {
+      return false;
+    }
+    for (int x = 0; x < w; x++) {
+      if (memcmp(&row[x * 4], &rgba[(y * w + x) * 4], channels) != 0) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+template<typename Fn> static double mean_us(Fn &&fn) {
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < RUNS; i++) {
+    fn();
+  }
+  return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / RUNS;
+}
+
+int main() {
+  std::mt19937 rng(3);
+  const Sample samples[] = {
+      {"ui_panel", 320, 240, Scene::UI_PANEL},
+      {"icon_aa", 64, 64, Scene::ICON_ALPHA},
+      {"photo_like", 320, 240, Scene::PHOTO},
+  };
+  bool all_ok = true;
+
+  printf("%-20s %9s %9s %9s %9s %7s %9s  round trip\n", "image", "QOI bytes", "PNG bytes", "QOI dec", "PNG dec", "",
+         "QOI enc");
+  for (const Sample &sample : samples) {
+    int w = sample.width;
+    int h = sample.height;
+    uint8_t channels = sample.scene == Scene::ICON_ALPHA ? 4 : 3;
+    std::vector<uint8_t> rgba = make_pixels(sample, rng);
+    std::vector<uint8_t> qoi = encode_qoi(rgba, w, h, channels);
+    std::vector<uint8_t> png = encode_png(rgba, w, h);
+
+    // Aller-retour depuis la mémoire, puis en flux depuis un FILE* (chemin SD)
+    QoiDecoder memory;
+    bool ok = memory.begin(qoi.data(), qoi.size()) && rows_match(memory, rgba, w, h, channels);
+    FILE *file = tmpfile();
+    fwrite(qoi.data(), 1, qoi.size(), file);
+    rewind(file);
+    QoiDecoder streamed;
+    ok = ok && streamed.begin(file) && rows_match(streamed, rgba, w, h, channels);
+    fclose(file);
+    all_ok = all_ok && ok;
+
+    std::vector<uint8_t> row(w * 4);
+    std::vector<uint8_t> decoded(w * h * 4);
+    double qoi_decode = mean_us([&] {
+      QoiDecoder decoder;
+      decoder.begin(qoi.data(), qoi.size());
+      for (int y = 0; y < h; y++) {
+        decoder.decode_row(row.data());
+      }
+    });
+    double png_decode = mean_us([&] { decode_png(png, decoded); });
+    double qoi_encode = mean_us([&] { encode_qoi(rgba, w, h, channels); });
+
+    char name[32];
+    snprintf(name, sizeof(name), "%s %dx%d", sample.name, w, h);
+    printf("%-20s %9zu %9zu %6.0f us %6.0f us (%.1fx) %6.0f us  %s\n", name, qoi.size(), png.size(), qoi_decode,
+           png_decode, png_decode / qoi_decode, qoi_encode, ok ? "bit-exact" : "MISMATCH");
+  }
+  return all_ok ? 0 : 1;
+}
@@ -0,0 +1,24 @@
+#pragma once
+// Host stand-in for ESPHome's Color: only what the storage headers use
+#include <cstdint>
+
+namespace esphome {
+
+struct Color {
+  uint8_t r{0};
+  uint8_t g{0};
+  uint8_t b{0};
+  uint8_t w{0};
+
+  Color() = default;
+  Color(uint8_t r, uint8_t g, uint8_t b) : r(r), g(g), b(b) {}
+  Color(uint8_t r, uint8_t g, uint8_t b, uint8_t w) : r(r), g(g), b(b), w(w) {}
+
+  static const Color BLACK;
+  static const Color WHITE;
+};
+
+inline const Color Color::BLACK{0, 0, 0, 0};
+inline const Color Color::WHITE{255, 255, 255, 255};
+
+}  // namespace esphome
@@ -0,0 +1,198 @@
+#!/usr/bin/env python3
+"""Build a storage asset pack (.pak) from a list of images.
+
+The on-device reader lives in components/storage/asset_pack.{h,cpp}; the
+header/entry layout and the name hash below must stay in sync with it.
+
+Usage:
+    python tools/asset_packer.py -o icons.pak --format rgb565 images/icons/*.png
+    python tools/asset_packer.py -o photos.pak --encoded photos/*.jpg
+    python tools/asset_packer.py -o ui.pak --resize 48x48 wifi=icons/wifi_full.png
+
+Entries are named after the file stem unless given as NAME=PATH. On the device
+an entry is loaded with `file_path: "pack:<name>"`.
+
+Pixel conversion and resizing reproduce SdImageComponent::set_pixel() and the
+device's nearest-neighbour mapping (kernels::nearest_source(), used by
+resize_image_buffer() and by both PNG backends, pngle and PNGdec), so a
+pre-converted entry is identical to what the device would have produced from
+the same PNG. tests/asset_packer_parity.py checks this against the C++ code
+for each of those paths.
+"""
+
+from __future__ import annotations
+
+import argparse
+import struct
+import sys
+from pathlib import Path
+
+ASSET_PACK_MAGIC = 0x4B504453  # "SDPK"
+ASSET_PACK_VERSION = 1
+
+HEADER_FORMAT = "<IHHII16x"  # AssetPackHeader, 32 bytes
+ENTRY_FORMAT = "<IIIHHBBH"  # AssetPackEntry, 20 bytes
+
+ENCODING_ENCODED = 0
+ENCODING_RGB565_LE = 1
+ENCODING_RGB565_BE = 2
+ENCODING_RGB888 = 3
+ENCODING_RGBA8888 = 4
+
+
+def asset_name_hash(name: str) -> int:
+    """32-bit FNV-1a, identical to asset_name_hash() in asset_pack.cpp."""
+    value = 2166136261
+    for byte in name.encode("utf-8"):
+        value ^= byte
+        value = (value * 16777619) & 0xFFFFFFFF
+    return value
+
+
+def resize_nearest(pixels, src_w, src_h, dst_w, dst_h):
+    """Nearest neighbour with the integer mapping of kernels::nearest_source()."""
+    out = []
+    for dst_y in range(dst_h):
+        src_y = min(dst_y * src_h // dst_h, src_h - 1)
+        row = src_y * src_w
+        for dst_x in range(dst_w):
+            src_x = min(dst_x * src_w // dst_w, src_w - 1)
+            out.append(pixels[row + src_x])
+    return out
+
+
+def convert_pixels(pixels, encoding: int) -> bytes:
+    """Mirror of SdImageComponent::set_pixel() for each output format."""
+    out = bytearray()
+    for r, g, b, a in pixels:
+        if encoding in (ENCODING_RGB565_LE, ENCODING_RGB565_BE):
+            rgb565 = ((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3)
+            if encoding == ENCODING_RGB565_BE:
+                out += bytes(((rgb565 >> 8) & 0xFF, rgb565 & 0xFF))
+            else:
+                out += bytes((rgb565 & 0xFF, (rgb565 >> 8) & 0xFF))
+        elif encoding == ENCODING_RGB888:
+            out += bytes((r, g, b))
+        else:
+            out += bytes((r, g, b, a))
+    return out
+
+
+def load_entry(path: Path, encoding: int, resize):
+    """Return (width, height, blob) for one input file."""
+    if encoding == ENCODING_ENCODED:
+        return 0, 0, path.read_bytes()
+
+    try:
+        from PIL import Image
+    except ImportError:
+        sys.exit("Pillow is required for pre-converted entries (pip install pillow)")
+
+    with Image.open(path) as img:
+        img = img.convert("RGBA")
+        width, height = img.size
+        pixels = list(img.getdata())
+
+    if resize and resize != (width, height):
+        pixels = resize_nearest(pixels, width, height, resize[0], resize[1])
+        width, height = resize
+
+    if width > 0xFFFF or height > 0xFFFF:
+        sys.exit(f"{path}: {width}x{height} is too large for an asset pack entry")
+
+    return width, height, convert_pixels(pixels, encoding)
+
+
+def build_pack(entries, encoding: int, alignment: int, resize) -> bytes:
+    """entries: list of (name, Path). Returns the complete pack file."""
+    hashes = {}
+    for name, _ in entries:
+        name_hash = asset_name_hash(name)
+        if name_hash in hashes and hashes[name_hash] != name:
+            sys.exit(f"Hash collision between '{name}' and '{hashes[name_hash]}', rename one of them")
+        if name_hash in hashes:
+            sys.exit(f"Duplicate entry name '{name}'")
+        hashes[name_hash] = name
+
+    def align(value: int) -> int:
+        return (value + alignment - 1) // alignment * alignment
+
+    header_size = struct.calcsize(HEADER_FORMAT)
+    entry_size = struct.calcsize(ENTRY_FORMAT)
+    index_offset = header_size
+    data_offset = align(index_offset + entry_size * len(entries))
+
+    index = []
+    blobs = bytearray()
+    for name, path in entries:
+        width, height, blob = load_entry(path, encoding, resize)
+        offset = data_offset + len(blobs)
+        index.append((asset_name_hash(name), offset, len(blob), width, height, encoding, 0, 0))
+        blobs += blob
+        blobs += bytes(align(len(blobs)) - len(blobs))
+        dims = f"{width}x{height}" if encoding != ENCODING_ENCODED else "encoded"
+        print(f"  {name:<32} 0x{asset_name_hash(name):08X} {dims} {len(blob)} bytes")
+
+    index.sort(key=lambda e: e[0])
+
+    out = bytearray(struct.pack(HEADER_FORMAT, ASSET_PACK_MAGIC, ASSET_PACK_VERSION, len(entries), index_offset, alignment))
+    for entry in index:
+        out += struct.pack(ENTRY_FORMAT, *entry)
+    out += bytes(data_offset - len(out))
+    out += blobs
+    return bytes(out)
+
+
+def parse_input(arg: str):
+    if "=" in arg:
+        name, path = arg.split("=", 1)
+        return name, Path(path)
+    path = Path(arg)
+    return path.stem, path
+
+
+def parse_dimensions(value: str):
+    try:
+        width, height = (int(v) for v in value.lower().split("x"))
+    except ValueError as err:
+        raise argparse.ArgumentTypeError("expected WIDTHxHEIGHT") from err
+    return width, height
+
+
+def main(argv=None) -> int:
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("inputs", nargs="+", help="image files, optionally as NAME=PATH")
+    parser.add_argument("-o", "--output", required=True, help="pack file to write")
+    parser.add_argument("--format", choices=["rgb565", "rgb888", "rgba"], default="rgb565",
+                        help="pre-converted pixel format (must match the sd_images format)")
+    parser.add_argument("--byte-order", choices=["little_endian", "big_endian"], default="little_endian",
+                        help="RGB565 byte order (must match the sd_images byte_order)")
+    parser.add_argument("--encoded", action="store_true",
+                        help="store the original JPEG/PNG/GIF bytes and decode on the device")
+    parser.add_argument("--resize", type=parse_dimensions, help="resize every entry to WIDTHxHEIGHT")
+    parser.add_argument("--alignment", type=int, default=512,
+                        help="blob alignment in bytes (default: one SD sector)")
+    args = parser.parse_args(argv)
+
+    if args.alignment <= 0 or args.alignment & (args.alignment - 1):
+        parser.error("--alignment must be a power of two")
+
+    if args.encoded:
+        encoding = ENCODING_ENCODED
+    elif args.format == "rgb565":
+        encoding = ENCODING_RGB565_BE if args.byte_order == "big_endian" else ENCODING_RGB565_LE
+    elif args.format == "rgb888":
+        encoding = ENCODING_RGB888
+    else:
+        encoding = ENCODING_RGBA8888
+
+    entries = [parse_input(arg) for arg in args.inputs]
+    print(f"Packing {len(entries)} entries into {args.output}")
+    data = build_pack(entries, encoding, args.alignment, args.resize)
+    Path(args.output).write_bytes(data)
+    print(f"Wrote {len(data)} bytes")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())